@@ -18,6 +18,7 @@ endif()
 set(ZYM_CORE_SOURCES
         ${ZYM_ROOT}/src/value.c
         ${ZYM_ROOT}/src/chunk.c
+        ${ZYM_ROOT}/src/profile.c
         ${ZYM_ROOT}/src/vm.c
         ${ZYM_ROOT}/src/object.c
         ${ZYM_ROOT}/src/memory.c
@@ -40,7 +41,12 @@ set(ZYM_CORE_SOURCES
         ${ZYM_ROOT}/src/natives/shared.c
         ${ZYM_ROOT}/src/natives/string_natives.c
         ${ZYM_ROOT}/src/natives/math.c
+        ${ZYM_ROOT}/src/natives/hash.c
+        ${ZYM_ROOT}/src/natives/pack.c
+        ${ZYM_ROOT}/src/natives/reader.c
+        ${ZYM_ROOT}/src/natives/csv.c
         ${ZYM_ROOT}/src/natives/typeof.c
+        ${ZYM_ROOT}/src/natives/vec.c
 )
 
 if(NOT CONFIG_ZYM_RUNTIME_ONLY)
@@ -64,4 +70,8 @@ idf_component_register(
 
 if(CONFIG_ZYM_RUNTIME_ONLY)
     target_compile_definitions(${COMPONENT_LIB} PUBLIC ZYM_RUNTIME_ONLY)
-endif()
\ No newline at end of file
+endif()
+
+if(CONFIG_ZYM_PROFILE)
+    target_compile_definitions(${COMPONENT_LIB} PUBLIC ZYM_PROFILE)
+endif()
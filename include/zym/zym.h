@@ -42,6 +42,18 @@ void zym_freeVM(ZymVM* vm);
 // Get the allocator associated with a VM
 const ZymAllocator* zym_getAllocator(ZymVM* vm);
 
+// Reuse a VM for another script without tearing it down. zym_resetVM drops
+// every global, object and stack value created since the last checkpoint and
+// collects them; natives, modules, interned names and grown capacities stay.
+// The preemption switch, timeslice and callback return to their checkpointed
+// values. A checkpoint is taken by zym_newVM; call zym_checkpointVM after
+// registering host natives and globals (or configuring preemption) to keep
+// those as well. Changes scripts made inside checkpointed objects are not
+// undone, and chunks compiled before a reset must be freed rather than run
+// again. Neither may be called from a native.
+void zym_checkpointVM(ZymVM* vm);
+void zym_resetVM(ZymVM* vm);
+
 // =============================================================================
 // ERROR CALLBACK
 // =============================================================================
@@ -62,6 +74,32 @@ typedef void (*ZymErrorCallback)(ZymVM* vm, ZymStatus type, const char* file,
 // Pass NULL to restore default behavior (fprintf to stderr).
 void zym_setErrorCallback(ZymVM* vm, ZymErrorCallback callback, void* user_data);
 
+// Runtime errors are always captured as a message plus the raw call stack.
+// With a runtime error handler set, that capture is all that happens: no
+// text is formatted and neither the error callback nor stderr sees the error.
+// Pass NULL to go back to formatted reporting.
+typedef void (*ZymRuntimeErrorHandler)(ZymVM* vm, void* user_data);
+void zym_setRuntimeErrorHandler(ZymVM* vm, ZymRuntimeErrorHandler handler, void* user_data);
+
+// One frame of the captured error. Frame 0 is where the error was raised;
+// each following frame is the call site in the next caller outward.
+typedef struct {
+    const char* function;   // function name, "<script>" for top-level code (not terminated)
+    int function_length;
+    const char* file;       // module or entry file, NULL if unknown
+    int line;               // -1 if unknown
+} ZymErrorFrame;
+
+// The last runtime error stays readable until the next one, zym_clearError or
+// zym_resetVM. Frames in top-level code also need their chunk to be alive.
+const char* zym_errorMessage(ZymVM* vm);    // message only, NULL when no error is held
+int zym_errorFrameCount(ZymVM* vm);          // 0 when no error is held
+bool zym_errorFrame(ZymVM* vm, int index, ZymErrorFrame* out);
+// Message, location and stack trace as the error callback receives them.
+// snprintf-style: writes at most size bytes and returns the full length.
+int zym_formatError(ZymVM* vm, char* buffer, int size);
+void zym_clearError(ZymVM* vm);
+
 // =============================================================================
 // COMPILATION AND EXECUTION
 // =============================================================================
@@ -79,9 +117,28 @@ ZymStatus zym_runChunk(ZymVM* vm, ZymChunk* chunk);
 ZymStatus zym_resume(ZymVM* vm);
 void zym_setPreemptCallback(ZymVM* vm, ZymValue callback);
 
+// Enable or disable preemption. timeslice is the instruction budget of a slice;
+// 0 selects deadline mode, where a slice only ends on zym_requestPreempt.
+void zym_setPreemption(ZymVM* vm, bool enabled, int timeslice);
+
+// Ask the VM to preempt at its next loop back-edge or call. Safe to call from
+// another thread, e.g. a host timer or watchdog enforcing a wall-clock budget.
+void zym_requestPreempt(ZymVM* vm);
+
+// True while a zym_requestPreempt is pending. Long-running natives can poll it
+// to stop early and return to the interpreter.
+bool zym_preemptRequested(ZymVM* vm);
+
 ZymStatus zym_serializeChunk(ZymVM* vm, ZymCompilerConfig config, ZymChunk* chunk, char** out_buffer, size_t* out_size);
 ZymStatus zym_deserializeChunk(ZymVM* vm, ZymChunk* chunk, const char* buffer, size_t size);
 
+// Libraries built with ZYM_PROFILE count executions, taken jumps and operand
+// kinds per instruction while running. zym_writeProfile renders the counts of
+// chunk and the functions it defines as text for ZymCompilerConfig.profile;
+// the buffer comes from the VM's allocator, like zym_serializeChunk's.
+// Without ZYM_PROFILE it returns ZYM_STATUS_RUNTIME_ERROR.
+ZymStatus zym_writeProfile(ZymVM* vm, ZymChunk* chunk, char** out_buffer, size_t* out_size);
+
 // =============================================================================
 // NATIVE FUNCTION REGISTRATION
 // =============================================================================
@@ -138,6 +195,69 @@ ZymValue zym_createNativeClosureVariadic(ZymVM* vm, const char* signature, void*
 // Returns ZYM_NULL if the value is not a native closure
 ZymValue zym_getClosureContext(ZymValue closure);
 
+// =============================================================================
+// USERDATA
+// =============================================================================
+
+// Method of a userdata type. Signature format is the same as zym_defineNative,
+// including "..." for variadics. The receiver is passed where native closures
+// get their context:
+//   "area()"        -> ZymValue myFunc(ZymVM* vm, ZymValue self)
+//   "scale(k)"      -> ZymValue myFunc(ZymVM* vm, ZymValue self, ZymValue k)
+typedef struct {
+    const char* signature;
+    void* func_ptr;
+} ZymMethod;
+
+// Create a type whose method table is shared by all its instances. The type
+// is a GC object: keep it reachable (global or zym_pushRoot) while creating
+// instances. finalizer (optional) receives each instance's payload on collection.
+ZymValue zym_newUserdataType(ZymVM* vm, const char* name, const ZymMethod* methods, int count,
+                             void (*finalizer)(ZymVM*, void*));
+
+// Create an instance with a zeroed inline payload of payload_size bytes (one allocation)
+ZymValue zym_newUserdata(ZymVM* vm, ZymValue type, size_t payload_size);
+
+// Payload of a userdata instance, or NULL if value is not userdata
+void* zym_userdataPayload(ZymValue value);
+
+// =============================================================================
+// VECTORS
+// =============================================================================
+
+// Create an immutable vec2/vec3/vec4 (size 2..4) from size components.
+// Returns ZYM_NULL for any other size.
+ZymValue zym_newVec(ZymVM* vm, int size, const double* comps);
+
+// Number of components (2..4), or 0 if value is not a vector
+int zym_vecSize(ZymValue value);
+
+// Components of a vector (read-only), or NULL if value is not a vector
+const double* zym_vecComponents(ZymValue value);
+
+// =============================================================================
+// READERS
+// =============================================================================
+
+// Host byte stream consumed by the reader's methods (r.readLine(),
+// r.readBytes(n), r.readUntil(delim), r.peek(), r.seek(offset)) through an
+// internal refillable buffer. Callbacks run
+// on the VM thread and must not call back into the VM.
+typedef struct {
+    // Fill up to capacity bytes of buffer. Returns the count read, 0 at end
+    // of stream, or -1 on error.
+    int64_t (*read)(void* ctx, char* buffer, size_t capacity);
+    // Optional: move to an absolute byte offset. Returns it, or -1 on error.
+    int64_t (*seek)(void* ctx, int64_t offset);
+    // Optional: called once when the reader is collected
+    void (*close)(void* ctx);
+} ZymReaderCallbacks;
+
+// Create a reader over ctx, a userdata of type "Reader". buffer_size is the
+// refill buffer (0 for 64 KiB, minimum 256). Returns ZYM_NULL if
+// callbacks->read is missing.
+ZymValue zym_newReader(ZymVM* vm, const ZymReaderCallbacks* callbacks, void* ctx, size_t buffer_size);
+
 
 // =============================================================================
 // FUNCTION OVERLOADING (DISPATCHER)
@@ -177,6 +297,9 @@ bool zym_isFunction(ZymValue value);
 bool zym_isClosure(ZymValue value);
 bool zym_isPromptTag(ZymValue value);
 bool zym_isContinuation(ZymValue value);
+bool zym_isUserdata(ZymValue value);
+bool zym_isVec(ZymValue value);
+bool zym_isReader(ZymValue value);
 
 // =============================================================================
 // VALUE EXTRACTION (SAFE)
@@ -232,7 +355,26 @@ ZymValue zym_newNumber(double value);
 ZymValue zym_newString(ZymVM* vm, const char* str);            // Copies and interns
 ZymValue zym_newStringN(ZymVM* vm, const char* str, int len);  // With explicit length
 
+// Builds a string of a known byte length in place, without a staging copy.
+// Fill the len bytes zym_reserveString returns, then zym_finishString adopts
+// them as the string's storage and interns it (an equal string already interned
+// is returned instead, and the buffer freed). A reserved buffer that is not
+// finished must be released with zym_abandonString. zym_reserveString returns
+// NULL on bad input, including len > INT_MAX - 1.
+char* zym_reserveString(ZymVM* vm, int len);
+ZymValue zym_finishString(ZymVM* vm, char* chars, int len);
+void zym_abandonString(ZymVM* vm, char* chars, int len);
+
+// Zero-copy string over host memory. chars[len] must be '\0' and the bytes must
+// stay valid and unchanged until finalizer runs when the string is collected.
+// External strings are not interned; equality and map keys compare contents.
+typedef void (*ZymStringFinalizer)(void* userdata, const char* chars, int len);
+ZymValue zym_newExternalString(ZymVM* vm, const char* chars, int len,
+                               ZymStringFinalizer finalizer, void* userdata);
+
 ZymValue zym_newList(ZymVM* vm);
+ZymValue zym_newListFrom(ZymVM* vm, const ZymValue* values, int count);   // Single allocation, copies values
+ZymValue zym_newListFromDoubles(ZymVM* vm, const double* values, int count);
 ZymValue zym_newMap(ZymVM* vm);
 
 // Create struct by schema name (must be defined in script)
@@ -251,6 +393,15 @@ bool zym_listSet(ZymVM* vm, ZymValue list, int index, ZymValue val); // Returns
 bool zym_listAppend(ZymVM* vm, ZymValue list, ZymValue val);
 bool zym_listInsert(ZymVM* vm, ZymValue list, int index, ZymValue val);
 bool zym_listRemove(ZymVM* vm, ZymValue list, int index);
+bool zym_listReserve(ZymVM* vm, ZymValue list, int capacity);         // Grow storage, never shrinks
+
+// Borrowed pointer to the list's element storage. Valid until the next VM
+// allocation or list mutation; writes must keep count within bounds.
+ZymValue* zym_listData(ZymValue list, int* count);
+
+// Copy up to max numeric elements into out. Returns the number copied, or -1
+// if list is not a list or an element within range is not a number.
+int zym_listToDoubles(ZymValue list, double* out, int max);
 
 // =============================================================================
 // MAP OPERATIONS
@@ -320,6 +471,24 @@ ZymValue zym_peekRoot(ZymVM* vm, int depth);  // 0 = top of root stack
 
 // Note: Native function arguments are automatically protected during the call
 
+// =============================================================================
+// BACKGROUND SWEEPING
+// =============================================================================
+
+typedef struct GarbageBatch ZymGarbage;
+typedef void (*ZymGarbageHandler)(ZymGarbage* garbage, void* user_data);
+
+// Install a handler that takes over freeing swept objects. Each collection still
+// runs finalizers on the VM thread, then passes the rest of the unreachable
+// objects to handler as one batch and resumes the program immediately. The
+// handler runs inside the collection and must not call back into the VM;
+// typically it queues the batch for a helper thread. Pass NULL to free inline.
+void zym_setGarbageHandler(ZymVM* vm, ZymGarbageHandler handler, void* user_data);
+
+// Release a batch received by the garbage handler. Safe to call from any thread
+// provided the VM's allocator is, and even after the VM itself has been freed.
+void zym_freeGarbage(ZymGarbage* garbage);
+
 // =============================================================================
 // ERROR HANDLING
 // =============================================================================
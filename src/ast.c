@@ -317,6 +317,7 @@ Stmt* new_var_decl_stmt(VM* vm, VarDecl* variables, int count, int capacity, Tok
     stmt->as.var_declaration.variables = variables;
     stmt->as.var_declaration.count = count;
     stmt->as.var_declaration.capacity = capacity;
+    stmt->as.var_declaration.destructure = false;
     return stmt;
 }
 
@@ -389,6 +390,9 @@ Stmt* new_return_stmt(VM* vm, Token keyword, Expr* value) {
     Stmt* stmt = new_stmt(vm, STMT_RETURN, keyword.line);
     stmt->keyword = keyword;
     stmt->as.return_stmt.value = value;
+    stmt->as.return_stmt.extra_values = NULL;
+    stmt->as.return_stmt.extra_count = 0;
+    stmt->as.return_stmt.extra_capacity = 0;
     return stmt;
 }
 
@@ -436,6 +440,23 @@ Stmt* new_switch_stmt(VM* vm, Expr* expression, CaseClause* cases, int case_coun
     return stmt;
 }
 
+Stmt* new_try_stmt(VM* vm, Stmt* body, Token catch_name, bool has_name, Stmt* handler, Token keyword) {
+    Stmt* stmt = new_stmt(vm, STMT_TRY, keyword.line);
+    stmt->keyword = keyword;
+    stmt->as.try_stmt.body = body;
+    stmt->as.try_stmt.catch_name = catch_name;
+    stmt->as.try_stmt.has_name = has_name;
+    stmt->as.try_stmt.handler = handler;
+    return stmt;
+}
+
+Stmt* new_throw_stmt(VM* vm, Expr* value, Token keyword) {
+    Stmt* stmt = new_stmt(vm, STMT_THROW, keyword.line);
+    stmt->keyword = keyword;
+    stmt->as.throw_stmt.value = value;
+    return stmt;
+}
+
 void free_stmt(VM* vm, Stmt* stmt) {
     if (stmt == NULL) return;
     switch (stmt->type) {
@@ -488,6 +509,10 @@ void free_stmt(VM* vm, Stmt* stmt) {
         }
         case STMT_RETURN: {
             free_expr(vm, stmt->as.return_stmt.value);
+            for (int i = 0; i < stmt->as.return_stmt.extra_count; i++) {
+                free_expr(vm, stmt->as.return_stmt.extra_values[i]);
+            }
+            FREE_ARRAY(vm, Expr*, stmt->as.return_stmt.extra_values, stmt->as.return_stmt.extra_capacity);
             break;
         }
         case STMT_COMPILER_DIRECTIVE:
@@ -515,6 +540,13 @@ void free_stmt(VM* vm, Stmt* stmt) {
             FREE_ARRAY(vm, CaseClause, stmt->as.switch_stmt.cases, stmt->as.switch_stmt.case_capacity);
             break;
         }
+        case STMT_TRY:
+            free_stmt(vm, stmt->as.try_stmt.body);
+            free_stmt(vm, stmt->as.try_stmt.handler);
+            break;
+        case STMT_THROW:
+            free_expr(vm, stmt->as.throw_stmt.value);
+            break;
     }
     FREE(vm, Stmt, stmt);
 }
\ No newline at end of file
@@ -99,7 +99,9 @@ typedef enum {
     STMT_ENUM_DECLARATION,
     STMT_LABEL,
     STMT_GOTO,
-    STMT_SWITCH
+    STMT_SWITCH,
+    STMT_TRY,
+    STMT_THROW
 } StmtType;
 
 typedef struct {
@@ -148,6 +150,9 @@ typedef struct {
 typedef struct {
     Token keyword;
     Expr* value;
+    Expr** extra_values;  // values after the first in `return a, b, ...`
+    int extra_count;
+    int extra_capacity;
 } ReturnStmt;
 
 
@@ -171,6 +176,7 @@ typedef struct {
     VarDecl* variables;
     int count;
     int capacity;
+    bool destructure;  // `var a, b = call();` unpacks the call's results
 } VarDeclStmt;
 
 typedef struct {
@@ -210,6 +216,17 @@ typedef struct {
     int default_index;  // -1 if no default
 } SwitchStmt;
 
+typedef struct {
+    Stmt* body;
+    Token catch_name;
+    bool has_name;  // false for `catch { ... }`
+    Stmt* handler;
+} TryStmt;
+
+typedef struct {
+    Expr* value;
+} ThrowStmt;
+
 struct Stmt {
     StmtType type;
     int line;
@@ -230,6 +247,8 @@ struct Stmt {
         LabelStmt            label;
         GotoStmt             goto_stmt;
         SwitchStmt           switch_stmt;
+        TryStmt              try_stmt;
+        ThrowStmt            throw_stmt;
     } as;
 };
 
@@ -274,4 +293,6 @@ Stmt* new_enum_decl_stmt(VM* vm, Token name, Token* variants, int variant_count,
 Stmt* new_label_stmt(VM* vm, Token label_name);
 Stmt* new_goto_stmt(VM* vm, Token keyword, Token target_label);
 Stmt* new_switch_stmt(VM* vm, Expr* expression, CaseClause* cases, int case_count, int case_capacity, int default_index, Token keyword);
+Stmt* new_try_stmt(VM* vm, Stmt* body, Token catch_name, bool has_name, Stmt* handler, Token keyword);
+Stmt* new_throw_stmt(VM* vm, Expr* value, Token keyword);
 void free_stmt(VM* vm, Stmt* stmt);
\ No newline at end of file
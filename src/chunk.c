@@ -5,6 +5,7 @@
 #include "./memory.h"
 #include "./vm.h"
 #include "gc.h"
+#include "./profile.h"
 
 void initChunk(Chunk* chunk) {
     chunk->count = 0;
@@ -12,12 +13,18 @@ void initChunk(Chunk* chunk) {
     chunk->code = NULL;
     chunk->lines = NULL;
     initValueArray(&chunk->constants);
+    chunk->handlers = NULL;
+    chunk->handler_count = 0;
+    chunk->handler_capacity = 0;
+    chunk->profile = NULL;
 }
 
 void freeChunk(VM* vm, Chunk* chunk) {
     FREE_ARRAY(vm, uint32_t, chunk->code, chunk->capacity);
     FREE_ARRAY(vm, int, chunk->lines, chunk->capacity);
     freeValueArray(vm, &chunk->constants);
+    FREE_ARRAY(vm, ExceptionHandler, chunk->handlers, chunk->handler_capacity);
+    freeChunkProfile(vm, chunk);
     initChunk(chunk);
 }
 
@@ -68,4 +75,20 @@ int addConstant(VM* vm, Chunk* chunk, Value value) {
         popTempRoot(vm);
     }
     return chunk->constants.count - 1;
-}
\ No newline at end of file
+}
+void addExceptionHandler(VM* vm, Chunk* chunk, ExceptionHandler handler) {
+    if (chunk->handler_capacity < chunk->handler_count + 1) {
+        int oldCapacity = chunk->handler_capacity;
+        chunk->handler_capacity = GROW_CAPACITY(oldCapacity);
+        chunk->handlers = GROW_ARRAY(vm, ExceptionHandler, chunk->handlers, oldCapacity, chunk->handler_capacity);
+    }
+    chunk->handlers[chunk->handler_count++] = handler;
+}
+
+const ExceptionHandler* findExceptionHandler(const Chunk* chunk, int offset) {
+    for (int i = 0; i < chunk->handler_count; i++) {
+        const ExceptionHandler* h = &chunk->handlers[i];
+        if (offset >= h->start && offset < h->end) return h;
+    }
+    return NULL;
+}
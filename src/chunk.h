@@ -6,16 +6,34 @@
 
 typedef struct VM VM;
 
+// Instructions in [start, end) are covered by a catch block beginning at
+// `handler`; the thrown value lands in register `reg`. Registers from
+// `close_from` up were opened inside the try and have their upvalues closed
+// before the handler runs. Entries are ordered innermost first.
+typedef struct {
+    int start;
+    int end;
+    int handler;
+    int reg;
+    int close_from;
+} ExceptionHandler;
+
 typedef struct Chunk {
     int count;
     int capacity;
     uint32_t* code;
     int* lines;
     ValueArray constants;
+    ExceptionHandler* handlers;
+    int handler_count;
+    int handler_capacity;
+    struct ChunkProfile* profile;  // execution counters, ZYM_PROFILE builds only
 } Chunk;
 
 void initChunk(Chunk* chunk);
 void freeChunk(VM* vm, Chunk* chunk);
 void writeInstruction(VM* vm, Chunk* chunk, uint32_t instruction, int line);
 void write64BitLiteral(VM* vm, Chunk* chunk, double value, int line);
-int addConstant(VM* vm, Chunk* chunk, Value value);
\ No newline at end of file
+int addConstant(VM* vm, Chunk* chunk, Value value);
+void addExceptionHandler(VM* vm, Chunk* chunk, ExceptionHandler handler);
+const ExceptionHandler* findExceptionHandler(const Chunk* chunk, int offset);
\ No newline at end of file
@@ -58,7 +58,7 @@ static int reserve_register(Compiler* compiler);
 static void free_register(Compiler* compiler);
 static int emit_jump_instruction(Compiler* compiler, OpCode opcode, int reg, int line);
 static void patch_jump(Compiler* compiler, int jump_address);
-static ObjFunction* compile_function_body(Compiler* current_compiler, FuncDeclStmt* stmt);
+static ObjFunction* compile_function_body(Compiler* current_compiler, FuncDeclStmt* stmt, ObjFunction* target);
 static int single_hoisted_arity(Compiler* c, const Token* name);
 static void collect_local_hoisted_in_stmt(Compiler* c, Stmt* s);
 static ObjStructSchema* get_struct_schema(Compiler* compiler, const Token* name);
@@ -434,8 +434,10 @@ static int try_emit_branch_compare(Compiler* compiler, Expr* condition, bool jum
                 case TOKEN_BANG_EQUAL:    neg_op = BRANCH_EQ; break;
                 default: restore_temp_top(compiler, saved_top); return -1;
             }
+            compiler->last_branch_start = compiler->compiling_chunk->count;
             emit_instruction(compiler, PACK_ABC(neg_op, left_reg, right_reg, 1), line);
         } else {
+            compiler->last_branch_start = compiler->compiling_chunk->count;
             emit_instruction(compiler, PACK_ABC(rr_op, left_reg, right_reg, 1), line);
         }
         int jump_addr = emit_jump_instruction(compiler, JUMP, 0, line);
@@ -444,6 +446,7 @@ static int try_emit_branch_compare(Compiler* compiler, Expr* condition, bool jum
     }
 
     int left_reg = compile_sub_expression(compiler, bin->left);
+    compiler->last_branch_start = compiler->compiling_chunk->count;
 
     if (use_immediate) {
         int64_t int_val = (int64_t)const_value;
@@ -461,6 +464,82 @@ static int try_emit_branch_compare(Compiler* compiler, Expr* condition, bool jum
     }
 }
 
+// Emits the conditional jump of an if statement: a fused compare-and-branch
+// when the condition allows it, JUMP_IF_* otherwise. Returns the jump to patch.
+static int emit_condition_jump(Compiler* compiler, Expr* condition, bool jump_if_true, int line) {
+    int jump = try_emit_branch_compare(compiler, condition, jump_if_true, line);
+    if (jump == -1) {
+        int condition_reg = compile_sub_expression(compiler, condition);
+        jump = emit_jump_instruction(compiler, jump_if_true ? JUMP_IF_TRUE : JUMP_IF_FALSE, condition_reg, line);
+        compiler->last_branch_start = jump;
+    }
+    return jump;
+}
+
+// --- Profile-guided layout ---
+
+// An if needs this many recorded executions before its arms are reordered
+#define PROFILE_MIN_EXECUTIONS 32
+
+// Offset the next instruction had in the unguided build the profile came from
+static int profile_offset(Compiler* compiler) {
+    return compiler->compiling_chunk->count + compiler->profile_bias;
+}
+
+// Record of the instruction emitted at offset, NULL if it never ran or the
+// surrounding code has no unguided counterpart
+static const ProfileRecord* profile_record_at(Compiler* compiler, int offset) {
+    if (compiler->profile_function == NULL || compiler->profile_unmapped) return NULL;
+    return findProfileRecord(compiler->profile_function, offset + compiler->profile_bias);
+}
+
+// Recompiling code that defines a function would compile it twice
+static bool added_function_constant(Compiler* compiler, int first_constant) {
+    ValueArray* constants = &compiler->compiling_chunk->constants;
+    for (int i = first_constant; i < constants->count; i++) {
+        if (IS_FUNCTION(constants->values[i])) return true;
+    }
+    return false;
+}
+
+// True if the profile shows the else arm of the if whose condition jump was
+// just emitted ran more often than the then arm. *else_start receives the
+// unguided offset of the else arm, known whenever this returns true.
+static bool profile_prefers_else(Compiler* compiler, int jump, int* else_start) {
+    const ProfileRecord* branch = profile_record_at(compiler, compiler->last_branch_start);
+    if (branch == NULL || branch->count < PROFILE_MIN_EXECUTIONS) return false;
+
+    uint32_t else_runs = branch->taken;
+    *else_start = branch->taken > 0 ? branch->target : -1;
+
+    // Register compares skip over a JUMP to the else arm rather than branching to it
+    Chunk* chunk = compiler->compiling_chunk;
+    if (jump == compiler->last_branch_start + 1 && OPCODE(chunk->code[jump]) == JUMP) {
+        const ProfileRecord* to_else = profile_record_at(compiler, jump);
+        else_runs = to_else != NULL ? to_else->count : 0;
+        *else_start = to_else != NULL ? to_else->target : -1;
+    }
+    return *else_start >= 0 && (uint64_t)else_runs * 2 > branch->count;
+}
+
+// True if ADDs between the unguided offsets from and to ran, and every one
+// that did only ever added two strings
+static bool profile_only_string_adds(Compiler* compiler, int from, int to) {
+    if (compiler->profile_function == NULL || compiler->profile_unmapped) return false;
+
+    const ProfileFunction* function = compiler->profile_function;
+    int adds = 0;
+    for (int i = 0; i < function->record_count; i++) {
+        const ProfileRecord* record = &function->records[i];
+        if (record->offset < from) continue;
+        if (record->offset >= to) break;
+        if (record->opcode != ADD) continue;
+        if (record->kinds != (PROFILE_KIND_STRING | PROFILE_KIND_STRING << 4)) return false;
+        adds++;
+    }
+    return adds > 0;
+}
+
 static void emit_loop(Compiler* compiler, int loop_start, int line) {
     int offset = loop_start - (compiler->compiling_chunk->count + 1);
     if (offset < MAX_JUMP_OFFSET_NEG) {
@@ -1026,6 +1105,7 @@ static bool is_tco_compile_time_safe(Compiler* compiler, Token* name, int arg_co
 }
 
 static void emit_dispatcher(Compiler* compiler, Token* name, int target_reg, int line, bool is_local);
+static bool emit_static_overload(Compiler* compiler, Token* name, int arg_count, int target_reg, int line, bool is_local);
 
 static void compile_tco_callee(Compiler* compiler, Token* name, int arg_count, int call_base, int line) {
     int reg = -1;
@@ -1039,7 +1119,9 @@ static void compile_tco_callee(Compiler* compiler, Token* name, int arg_count, i
     }
     // 1b. No exact local match, but local has variadic — needs dispatcher
     if (reg == -1 && has_any_hoisted_local(compiler, name) && has_variadic_hoisted_local(compiler, name)) {
-        emit_dispatcher(compiler, name, call_base, line, true);
+        if (!emit_static_overload(compiler, name, arg_count, call_base, line, true)) {
+            emit_dispatcher(compiler, name, call_base, line, true);
+        }
         return;
     }
 
@@ -1051,7 +1133,9 @@ static void compile_tco_callee(Compiler* compiler, Token* name, int arg_count, i
     // 2b. No exact global match but has variadic global — needs dispatcher
     else if (reg == -1 && has_any_hoisted_global(compiler, name) && has_variadic_hoisted_global(compiler, name)
              && !is_hoisted_global(compiler, name, arg_count)) {
-        emit_dispatcher(compiler, name, call_base, line, false);
+        if (!emit_static_overload(compiler, name, arg_count, call_base, line, false)) {
+            emit_dispatcher(compiler, name, call_base, line, false);
+        }
         return;
     }
     // Fall back to plain locals or a single "<base>@digits" block-local
@@ -1111,7 +1195,9 @@ static void compile_tco_callee(Compiler* compiler, Token* name, int arg_count, i
         }
 
         if (needs_dispatcher) {
-            emit_dispatcher(compiler, name, call_base, line, false);
+            if (!emit_static_overload(compiler, name, arg_count, call_base, line, false)) {
+                emit_dispatcher(compiler, name, call_base, line, false);
+            }
         } else if (should_mangle) {
             ScopedString mangled = scoped_mangle(compiler, name, arg_count);
             ObjString* str = copyString(compiler->vm, mangled.str, (int)strlen(mangled.str));
@@ -1128,6 +1214,11 @@ static void compile_tco_callee(Compiler* compiler, Token* name, int arg_count, i
 }
 
 static bool try_compile_tail_call(Compiler* compiler, Expr* return_expr, int line) {
+    // A tail call would discard the frame whose handler table covers this call
+    if (compiler->try_depth > 0) {
+        return false;
+    }
+
     CallExpr* call_expr = &return_expr->as.call;
     Expr* callee = call_expr->callee;
     int arg_count = call_expr->arg_count;
@@ -1344,6 +1435,216 @@ static void emit_dispatcher(Compiler* compiler, Token* name, int target_reg, int
     }
 }
 
+// Resolves a call with a known argument count to the overload the dispatcher would
+// pick at runtime and loads it directly, so the call site never builds a dispatcher.
+// Mirrors resolveOverload(): callers have already ruled out an exact script overload,
+// so this checks an exact native match, then the variadic fallback.
+// Returns false when nothing can be chosen statically.
+static bool emit_static_overload(Compiler* compiler, Token* name, int arg_count, int target_reg, int line, bool is_local) {
+    if (is_local) {
+        for (int i = 0; i < compiler->local_hoisted_count; i++) {
+            HoistedFn* fn = &compiler->local_hoisted[i];
+            if (!fn->is_variadic || !tokens_equal(&fn->name, name)) continue;
+            int fixed = fn->arity - 1;
+            if (arg_count < fixed) continue;
+            char* mangled = mangle_name_variadic(compiler, name, fixed);
+            Token mtoken = { .start = mangled, .length = (int)strlen(mangled), .line = name->line };
+            int reg = resolve_local(compiler, &mtoken);
+            FREE_ARRAY(compiler->vm, char, mangled, strlen(mangled) + 1);
+            if (reg != -1) {
+                emit_move(compiler, target_reg, reg, line);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Exact native overload (e.g., "name@2")
+    char buf[256 + 8];
+    snprintf(buf, sizeof(buf), "%.*s@%d", name->length, name->start, arg_count);
+    ObjString* key = copyString(compiler->vm, buf, (int)strlen(buf));
+    pushTempRoot(compiler->vm, (Obj*)key);
+    Value val;
+    if (tableGet(&compiler->vm->globals, key, &val) && IS_NATIVE_FUNCTION(val)) {
+        int k = make_constant(compiler, OBJ_VAL(key));
+        popTempRoot(compiler->vm);
+        emit_get_global(compiler, target_reg, k, line);
+        return true;
+    }
+    popTempRoot(compiler->vm);
+
+    // Script variadic fallback takes precedence over a native one
+    Compiler* root = root_compiler(compiler);
+    for (int i = 0; i < root->hoisted_count; i++) {
+        if (!root->hoisted[i].is_variadic || !tokens_equal(&root->hoisted[i].name, name)) continue;
+        int fixed = root->hoisted[i].arity - 1;
+        if (arg_count < fixed) return false;
+        char* mangled = mangle_name_variadic(compiler, name, fixed);
+        ObjString* str = copyString(compiler->vm, mangled, (int)strlen(mangled));
+        pushTempRoot(compiler->vm, (Obj*)str);
+        int k = make_constant(compiler, OBJ_VAL(str));
+        popTempRoot(compiler->vm);
+        FREE_ARRAY(compiler->vm, char, mangled, strlen(mangled) + 1);
+        emit_get_global(compiler, target_reg, k, line);
+        return true;
+    }
+
+    int fixed;
+    if (has_native_variadic_global(compiler, name, arg_count, &fixed)) {
+        snprintf(buf, sizeof(buf), "%.*s@v%d", name->length, name->start, fixed);
+        ObjString* str = copyString(compiler->vm, buf, (int)strlen(buf));
+        pushTempRoot(compiler->vm, (Obj*)str);
+        int k = make_constant(compiler, OBJ_VAL(str));
+        popTempRoot(compiler->vm);
+        emit_get_global(compiler, target_reg, k, line);
+        return true;
+    }
+    return false;
+}
+
+// Creates the hidden local name "name@*" that caches a scope's dispatcher.
+static char* mangle_dispatcher_cache(Compiler* compiler, const Token* name) {
+    char* buffer = ALLOCATE(compiler->vm, char, name->length + 3);
+    sprintf(buffer, "%.*s@*", name->length, name->start);
+    return buffer;
+}
+
+// Builds the hidden global name caching the dispatcher of a global overload set.
+// The key encodes every overload in the set ("name@*1,2,v1,n3"), so code compiled
+// against a different set never picks up a stale dispatcher.
+static bool dispatcher_cache_key(Compiler* compiler, const Token* name, char* buf, size_t size) {
+    int pos = snprintf(buf, size, "%.*s@*", name->length, name->start);
+    if (pos < 0 || (size_t)pos >= size) return false;
+
+    Compiler* root = root_compiler(compiler);
+    for (int i = 0; i < root->hoisted_count; i++) {
+        if (!tokens_equal(&root->hoisted[i].name, name)) continue;
+        if (root->hoisted[i].is_variadic) {
+            pos += snprintf(buf + pos, size - pos, ",v%d", root->hoisted[i].arity - 1);
+        } else {
+            pos += snprintf(buf + pos, size - pos, ",%d", root->hoisted[i].arity);
+        }
+        if ((size_t)pos >= size) return false;
+    }
+
+    char native_buf[256 + 8];
+    for (int arity = 0; arity <= MAX_NATIVE_ARITY; arity++) {
+        for (int variadic = 0; variadic < 2; variadic++) {
+            snprintf(native_buf, sizeof(native_buf), variadic ? "%.*s@v%d" : "%.*s@%d", name->length, name->start, arity);
+            ObjString* key = copyString(compiler->vm, native_buf, (int)strlen(native_buf));
+            pushTempRoot(compiler->vm, (Obj*)key);
+            Value val;
+            bool found = tableGet(&compiler->vm->globals, key, &val) && IS_NATIVE_FUNCTION(val);
+            popTempRoot(compiler->vm);
+            if (found) {
+                pos += snprintf(buf + pos, size - pos, variadic ? ",nv%d" : ",n%d", arity);
+                if ((size_t)pos >= size) return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Reserves a null-initialized "name@*" local for each overloaded function declared
+// directly in this block. Re-entering the block (e.g., in a loop) creates fresh
+// closures, so the reset to null doubles as the cache invalidation.
+static void declare_dispatcher_caches(Compiler* compiler, BlockStmt* block) {
+    for (int i = 0; i < block->count; i++) {
+        if (block->statements[i]->type != STMT_FUNC_DECLARATION) continue;
+        Token* name = &block->statements[i]->as.func_declaration.name;
+        if (single_local_hoisted_arity(compiler, name) != -2) continue;
+
+        char* cache_chars = mangle_dispatcher_cache(compiler, name);
+        Token cache_token = { .start = cache_chars, .length = (int)strlen(cache_chars), .line = name->line };
+
+        bool exists = false;
+        for (int j = compiler->local_count - 1; j >= 0; j--) {
+            Local* local = &compiler->locals[j];
+            if (local->depth != -1 && local->depth < compiler->scope_depth) break;
+            if (tokens_equal(&cache_token, &local->name)) { exists = true; break; }
+        }
+        if (exists) {
+            FREE_ARRAY(compiler->vm, char, cache_chars, strlen(cache_chars) + 1);
+            continue;
+        }
+
+        int cache_reg = reserve_register(compiler);
+        int null_const = make_constant(compiler, NULL_VAL);
+        emit_load_const(compiler, cache_reg, null_const, block->statements[i]->line);
+        add_local_at_reg(compiler, cache_token, cache_reg);
+        track_owned_name(compiler, cache_chars);
+    }
+}
+
+// Defines the hidden cache global for every overloaded top-level function. Runs with
+// the declaration pass, so re-running a script (or compiling more code into the same
+// VM) resets the cache before any dispatcher is materialized.
+static void define_dispatcher_caches(Compiler* compiler) {
+    int saved_top = save_temp_top(compiler);
+    for (int i = 0; i < compiler->hoisted_count; i++) {
+        Token* name = &compiler->hoisted[i].name;
+        bool seen = false;
+        for (int j = 0; j < i; j++) {
+            if (tokens_equal(&compiler->hoisted[j].name, name)) { seen = true; break; }
+        }
+        if (seen || single_hoisted_arity(compiler, name) != -2) continue;
+
+        char key[512];
+        if (!dispatcher_cache_key(compiler, name, key, sizeof(key))) continue;
+        ObjString* str = copyString(compiler->vm, key, (int)strlen(key));
+        pushTempRoot(compiler->vm, (Obj*)str);
+        int key_const = make_constant(compiler, OBJ_VAL(str));
+        popTempRoot(compiler->vm);
+
+        int null_reg = alloc_temp(compiler);
+        emit_load_const(compiler, null_reg, make_constant(compiler, NULL_VAL), name->line);
+        emit_instruction(compiler, PACK_ABx(DEFINE_GLOBAL, null_reg, key_const), name->line);
+        restore_temp_top(compiler, saved_top);
+    }
+}
+
+// Loads the dispatcher for an overloaded name used as a value. The dispatcher is
+// materialized on first use and reused afterwards instead of being rebuilt with
+// NEW_DISPATCHER/ADD_OVERLOAD every time the expression runs.
+static void emit_cached_dispatcher(Compiler* compiler, Token* name, int target_reg, int line, bool is_local) {
+    if (is_local) {
+        char* cache_chars = mangle_dispatcher_cache(compiler, name);
+        Token cache_token = { .start = cache_chars, .length = (int)strlen(cache_chars), .line = name->line };
+        int cache_reg = resolve_local(compiler, &cache_token);
+        FREE_ARRAY(compiler->vm, char, cache_chars, strlen(cache_chars) + 1);
+        if (cache_reg == -1) {
+            emit_dispatcher(compiler, name, target_reg, line, true);
+            return;
+        }
+
+        int skip = emit_jump_instruction(compiler, JUMP_IF_TRUE, cache_reg, line);
+        int saved_top = save_temp_top(compiler);
+        emit_dispatcher(compiler, name, cache_reg, line, true);
+        restore_temp_top(compiler, saved_top);
+        patch_jump(compiler, skip);
+        emit_move(compiler, target_reg, cache_reg, line);
+        return;
+    }
+
+    char key[512];
+    if (!dispatcher_cache_key(compiler, name, key, sizeof(key))) {
+        emit_dispatcher(compiler, name, target_reg, line, false);
+        return;
+    }
+    ObjString* str = copyString(compiler->vm, key, (int)strlen(key));
+    pushTempRoot(compiler->vm, (Obj*)str);
+    int key_const = make_constant(compiler, OBJ_VAL(str));
+    popTempRoot(compiler->vm);
+
+    emit_get_global(compiler, target_reg, key_const, line);
+    int skip = emit_jump_instruction(compiler, JUMP_IF_TRUE, target_reg, line);
+    int saved_top = save_temp_top(compiler);
+    emit_dispatcher(compiler, name, target_reg, line, false);
+    restore_temp_top_preserve(compiler, saved_top, target_reg);
+    emit_set_global(compiler, target_reg, key_const, line);
+    patch_jump(compiler, skip);
+}
+
 static bool resolve_and_load_function(Compiler* compiler, Token* name, int arg_count, int target_reg, int line) {
     int reg = -1;
 
@@ -1356,7 +1657,9 @@ static bool resolve_and_load_function(Compiler* compiler, Token* name, int arg_c
     }
     // 1b. If no exact local match, check if local has variadic — needs dispatcher
     if (reg == -1 && has_any_hoisted_local(compiler, name) && has_variadic_hoisted_local(compiler, name)) {
-        emit_dispatcher(compiler, name, target_reg, line, true);
+        if (!emit_static_overload(compiler, name, arg_count, target_reg, line, true)) {
+            emit_dispatcher(compiler, name, target_reg, line, true);
+        }
         return true;
     }
 
@@ -1368,7 +1671,9 @@ static bool resolve_and_load_function(Compiler* compiler, Token* name, int arg_c
     // 2b. No exact global match but has variadic global — needs dispatcher
     else if (reg == -1 && has_any_hoisted_global(compiler, name) && has_variadic_hoisted_global(compiler, name)
              && !is_hoisted_global(compiler, name, arg_count)) {
-        emit_dispatcher(compiler, name, target_reg, line, false);
+        if (!emit_static_overload(compiler, name, arg_count, target_reg, line, false)) {
+            emit_dispatcher(compiler, name, target_reg, line, false);
+        }
         return true;
     }
     // 3. Fall back to plain locals or a single "<base>@digits" block-local
@@ -1440,7 +1745,9 @@ static bool resolve_and_load_function(Compiler* compiler, Token* name, int arg_c
         }
 
         if (needs_dispatcher) {
-            emit_dispatcher(compiler, name, target_reg, line, false);
+            if (!emit_static_overload(compiler, name, arg_count, target_reg, line, false)) {
+                emit_dispatcher(compiler, name, target_reg, line, false);
+            }
         } else if (should_mangle) {
             char* mangled = mangle_name(compiler, name, arg_count);
             ObjString* str = copyString(compiler->vm, mangled, (int)strlen(mangled));
@@ -1457,6 +1764,110 @@ static bool resolve_and_load_function(Compiler* compiler, Token* name, int arg_c
     }
 }
 
+// True when obj.name has a compile-time resolution (enum variant or typed struct),
+// where EXPR_GET already emits a direct access that INVOKE would only slow down.
+static bool has_static_member_type(Compiler* compiler, Expr* object) {
+    if (object->type != EXPR_VARIABLE) return false;
+    Token* var_name = &object->as.variable.name;
+    if (get_enum_schema(compiler, var_name)) return true;
+
+    int reg = resolve_local(compiler, var_name);
+    if (reg != -1) {
+        Local* local = get_local_by_reg(compiler, reg);
+        return local && local->struct_type;
+    }
+    int upvalue_idx = resolve_upvalue(compiler, var_name);
+    if (upvalue_idx != -1) {
+        return compiler->upvalues[upvalue_idx].struct_type != NULL;
+    }
+    return get_global_type(compiler, var_name) != NULL;
+}
+
+static bool is_plus_expr(Expr* expr) {
+    return expr->type == EXPR_BINARY && expr->as.binary.operator.type == TOKEN_PLUS;
+}
+
+static bool is_string_literal(Expr* expr) {
+    return expr->type == EXPR_LITERAL && expr->as.literal.literal.type == TOKEN_STRING;
+}
+
+// Number of operands in a left-deep `a + b + c ...` chain, and whether any of
+// them is a string literal (the compile-time hint that the chain builds a string).
+static int concat_chain_length(Expr* expr, bool* has_string) {
+    int count = 1;
+    while (is_plus_expr(expr)) {
+        if (is_string_literal(expr->as.binary.right)) *has_string = true;
+        count++;
+        expr = expr->as.binary.left;
+    }
+    if (is_string_literal(expr)) *has_string = true;
+    return count;
+}
+
+// Operands that cannot run code when read: literals and variables.
+static bool is_quiet_operand(Expr* expr) {
+    return expr->type == EXPR_LITERAL || expr->type == EXPR_VARIABLE;
+}
+
+// CONCAT_N evaluates the operands left to right into their own registers,
+// which is the order the ADD chain it replaces sees them in, except for the
+// first ADD: it reads a local left operand in place, after the second operand
+// has run. When that operand can run code it may reassign the local, so the
+// chain keeps its ADDs.
+static bool concat_keeps_order(Compiler* compiler, Expr* expr) {
+    while (is_plus_expr(expr->as.binary.left)) expr = expr->as.binary.left;
+    Expr* first = expr->as.binary.left;
+    if (first->type != EXPR_VARIABLE || resolve_local(compiler, &first->as.variable.name) == -1) {
+        return true;
+    }
+    return is_quiet_operand(expr->as.binary.right);
+}
+
+// Compile the chain operands left to right into base, base+1, ...
+// Returns the number of operands written.
+static int compile_concat_operands(Compiler* compiler, Expr* expr, int base) {
+    if (!is_plus_expr(expr)) {
+        COMPILE_REQUIRED(compiler, expr, base);
+        return 1;
+    }
+    int index = compile_concat_operands(compiler, expr->as.binary.left, base);
+    COMPILE_REQUIRED(compiler, expr->as.binary.right, base + index);
+    return index + 1;
+}
+
+// Compiles a '+' chain without a string literal as plain ADDs, then swaps in
+// one CONCAT_N if the profile shows the chain only ever joined strings.
+static void compile_profiled_chain(Compiler* compiler, Expr* expr, int target_reg, int operand_count) {
+    Chunk* chunk = compiler->compiling_chunk;
+    int start = chunk->count;
+    int start_offset = profile_offset(compiler);
+    int saved_top = save_temp_top(compiler);
+    int first_constant = chunk->constants.count;
+
+    compiler->profile_probing = true;
+    compile_expression(compiler, expr, target_reg);
+    compiler->profile_probing = false;
+
+    int end_offset = profile_offset(compiler);
+    if (compiler->has_error || added_function_constant(compiler, first_constant) ||
+        !profile_only_string_adds(compiler, start_offset, end_offset)) {
+        return;
+    }
+
+    chunk->count = start;
+    restore_temp_top(compiler, saved_top);
+    bool saved_unmapped = compiler->profile_unmapped;
+    compiler->profile_unmapped = true;
+
+    int base = alloc_temp(compiler);
+    for (int i = 1; i < operand_count; i++) alloc_temp(compiler);
+    compile_concat_operands(compiler, expr, base);
+    emit_instruction(compiler, PACK_ABC(CONCAT_N, target_reg, base, operand_count), expr->line);
+
+    compiler->profile_unmapped = saved_unmapped;
+    compiler->profile_bias = end_offset - chunk->count;
+}
+
 static void compile_expression(Compiler* compiler, Expr* expr, int target_reg) {
     // Defensive check: if expr is NULL, report error and emit null constant
     if (expr == NULL) {
@@ -1504,8 +1915,8 @@ static void compile_expression(Compiler* compiler, Expr* expr, int target_reg) {
                 scoped_string_free(&mangled);
                 // fall through if somehow not found
             } else if (lar == -2) {
-                // Multiple local overloads exist - create a dispatcher
-                emit_dispatcher(compiler, &name, target_reg, expr->line, true);
+                // Multiple local overloads exist - use the scope's cached dispatcher
+                emit_cached_dispatcher(compiler, &name, target_reg, expr->line, true);
                 break;
             }
 
@@ -1524,8 +1935,8 @@ static void compile_expression(Compiler* compiler, Expr* expr, int target_reg) {
                     scoped_string_free(&mangled);
                     emit_get_global(compiler, target_reg, k, expr->line);
                 } else if (ar == -2) {
-                    // Multiple global overloads exist - create a dispatcher
-                    emit_dispatcher(compiler, &name, target_reg, expr->line, false);
+                    // Multiple global overloads exist - use the set's cached dispatcher
+                    emit_cached_dispatcher(compiler, &name, target_reg, expr->line, false);
                 } else {
                     // No overloads found
                     int k = identifier_constant(compiler, &name);
@@ -1735,6 +2146,30 @@ static void compile_expression(Compiler* compiler, Expr* expr, int target_reg) {
                 break;
             }
 
+            // String building chains (a + ":" + b + ...) become one CONCAT_N over
+            // a register range instead of allocating every intermediate string
+            if (is_plus_expr(expr)) {
+                bool has_string = false;
+                int operand_count = concat_chain_length(expr, &has_string);
+                bool flattenable = operand_count >= 3 && operand_count <= 255 &&
+                                   concat_keeps_order(compiler, expr);
+                if (has_string && flattenable) {
+                    int base = alloc_temp(compiler);
+                    for (int i = 1; i < operand_count; i++) alloc_temp(compiler);
+                    compile_concat_operands(compiler, expr, base);
+                    emit_instruction(compiler, PACK_ABC(CONCAT_N, target_reg, base, operand_count), expr->line);
+                    restore_temp_top_preserve(compiler, saved_top, target_reg);
+                    break;
+                }
+                if (!has_string && flattenable &&
+                    compiler->profile_function != NULL && !compiler->profile_unmapped &&
+                    !compiler->profile_probing) {
+                    compile_profiled_chain(compiler, expr, target_reg, operand_count);
+                    restore_temp_top_preserve(compiler, saved_top, target_reg);
+                    break;
+                }
+            }
+
             // Check if right operand is a constant number literal
             bool right_is_const = (expr->as.binary.right->type == EXPR_LITERAL &&
                                    expr->as.binary.right->as.literal.literal.type == TOKEN_NUMBER);
@@ -1912,6 +2347,11 @@ static void compile_expression(Compiler* compiler, Expr* expr, int target_reg) {
         case EXPR_CALL: {
             int saved_top = save_temp_top(compiler);
 
+            // Destructuring asks for several results in target_reg, target_reg + 1, ...
+            // Claim the request before the callee and arguments compile their own calls.
+            const int results = compiler->call_results;
+            compiler->call_results = 0;
+
             const int arg_count = expr->as.call.arg_count;
             Expr* callee = expr->as.call.callee;
 
@@ -1956,13 +2396,26 @@ static void compile_expression(Compiler* compiler, Expr* expr, int target_reg) {
                         COMPILE_REQUIRED(compiler, expr->as.call.args[i], value_reg);
                         emit_instruction(compiler, PACK_ABC(SET_STRUCT_FIELD, target_reg, i, value_reg), expr->line);
                     }
+
+                    // A struct is a single value: any further destructured names get null
+                    if (results > 1) {
+                        int null_const = make_constant(compiler, NULL_VAL);
+                        for (int i = 1; i < results; i++) {
+                            emit_instruction(compiler, PACK_ABx(LOAD_CONST, target_reg + i, null_const), expr->line);
+                        }
+                        if (compiler->max_register_seen < target_reg + results - 1) {
+                            compiler->max_register_seen = target_reg + results - 1;
+                        }
+                    }
                     restore_temp_top_preserve(compiler, saved_top, target_reg);
                     break;
                 }
             }
 
             // Not a struct - proceed with regular function call
-            const int call_slots_needed = 1 + arg_count;
+            // Multiple results come back in consecutive registers from the callee slot,
+            // so the call window must also cover every requested result.
+            const int call_slots_needed = results > 1 + arg_count ? results : 1 + arg_count;
 
             // Optimization: Try to use target_reg as call_base to avoid a MOVE after the call
             // The call needs contiguous registers: [callee, arg1, arg2, ...]
@@ -1979,7 +2432,7 @@ static void compile_expression(Compiler* compiler, Expr* expr, int target_reg) {
             // Special case: for zero-argument calls (call_slots_needed == 1), the only slot
             // used is target_reg itself. If target_reg is a local, we're assigning to it anyway,
             // so overwriting it with the callee and then the result is safe.
-            bool is_zero_arg_local_target = (arg_count == 0 && is_local_reg(compiler, target_reg));
+            bool is_zero_arg_local_target = (call_slots_needed == 1 && is_local_reg(compiler, target_reg));
 
             // Check 1: target_reg must be >= next_register_before_args (outside the local region)
             // We allow target_reg == next_register_before_args because it's at the boundary
@@ -2042,7 +2495,7 @@ static void compile_expression(Compiler* compiler, Expr* expr, int target_reg) {
             // Variadic functions cannot use CALL_SELF because the VM handler does not
             // update frame->arg_count, which PACK_REST relies on.
             bool is_self_call = false;
-            if (callee->type == EXPR_VARIABLE && compiler->function && compiler->function->name
+            if (results <= 1 && callee->type == EXPR_VARIABLE && compiler->function && compiler->function->name
                 && !compiler->function->is_variadic) {
                 Token* name = &callee->as.variable.name;
 
@@ -2054,8 +2507,15 @@ static void compile_expression(Compiler* compiler, Expr* expr, int target_reg) {
                 }
             }
 
+            // obj.method(args) on a dynamic receiver: load the receiver into the callee
+            // slot and let INVOKE fuse the property lookup with the call.
+            bool use_invoke = !is_self_call && results <= 1 && callee->type == EXPR_GET && arg_count <= 0xFF &&
+                              !has_static_member_type(compiler, callee->as.get.object);
+
             // For self-calls, we don't need to load the callee - the VM will get it from the frame
-            if (!is_self_call) {
+            if (use_invoke) {
+                COMPILE_REQUIRED(compiler, callee->as.get.object, call_base);
+            } else if (!is_self_call) {
                 if (callee->type == EXPR_VARIABLE) {
                     resolve_and_load_function(compiler, &callee->as.variable.name, arg_count, call_base, callee->line);
                 } else {
@@ -2070,8 +2530,8 @@ static void compile_expression(Compiler* compiler, Expr* expr, int target_reg) {
                 COMPILE_REQUIRED(compiler, arg, arg_slot);
             }
 
-            if (compiler->max_register_seen < call_base + arg_count) {
-                compiler->max_register_seen = call_base + arg_count;
+            if (compiler->max_register_seen < call_base + call_slots_needed - 1) {
+                compiler->max_register_seen = call_base + call_slots_needed - 1;
             }
 
             #ifdef DEBUG_CALL
@@ -2088,6 +2548,14 @@ static void compile_expression(Compiler* compiler, Expr* expr, int target_reg) {
 
             if (is_self_call) {
                 emit_instruction(compiler, PACK_ABx(CALL_SELF, call_base, arg_count), expr->line);
+            } else if (use_invoke) {
+                int key_const = identifier_constant(compiler, &callee->as.get.name);
+                emit_instruction(compiler, PACK_ABC(INVOKE, call_base, arg_count, 0), expr->line);
+                writeInstruction(compiler->vm, compiler->compiling_chunk, (uint32_t)key_const, expr->line);
+                writeInstruction(compiler->vm, compiler->compiling_chunk, 0, expr->line);
+            } else if (results > 1) {
+                // C = number of results the caller unpacks (args fit in B, see parser limit)
+                emit_instruction(compiler, PACK_ABC(CALL, call_base, arg_count, results), expr->line);
             } else {
                 emit_instruction(compiler, PACK_ABx(CALL, call_base, arg_count), expr->line);
             }
@@ -2095,6 +2563,9 @@ static void compile_expression(Compiler* compiler, Expr* expr, int target_reg) {
             // Only emit MOVE if the result isn't already in target_reg
             if (call_base != target_reg) {
                 EMIT_MOVE_IF_NEEDED(compiler, target_reg, call_base, expr->line);
+                for (int i = 1; i < results; i++) {
+                    emit_move(compiler, target_reg + i, call_base + i, expr->line);
+                }
             }
             restore_temp_top_preserve(compiler, saved_top, target_reg);
             break;
@@ -2527,7 +2998,7 @@ static void compile_expression(Compiler* compiler, Expr* expr, int target_reg) {
             temp_stmt.function = NULL;  // Initialize function field to NULL
 
             // Compile the function body
-            ObjFunction* function = compile_function_body(compiler, &temp_stmt);
+            ObjFunction* function = compile_function_body(compiler, &temp_stmt, NULL);
             int const_index = make_constant(compiler, OBJ_VAL(function));
             popTempRoot(compiler->vm);  // Pop protection from compile_function_body
 
@@ -2907,6 +3378,66 @@ static void record_global_decl(Compiler* compiler, Token name, int bytecode_pos)
     };
 }
 
+// var a, b, c = f(...): the call leaves its results in consecutive registers
+// starting at the first name's slot, so locals bind them without moves.
+static void compile_destructuring_var(Compiler* compiler, VarDeclStmt* var_stmt, int line) {
+    int count = var_stmt->count;
+    Expr* call = var_stmt->variables[count - 1].initializer;
+
+    if (compiler->scope_depth > 0) {
+        for (int i = 0; i < count; i++) {
+            declare_variable(compiler, &var_stmt->variables[i].name);
+        }
+        int first = reserve_register(compiler);
+        compiler->call_results = count;
+        COMPILE_REQUIRED(compiler, call, first);
+        add_local_at_reg(compiler, var_stmt->variables[0].name, first);
+        for (int i = 1; i < count; i++) {
+            int reg = reserve_register(compiler);
+            if (reg != first + i) {
+                compiler_error(compiler, line, "Destructured variables need consecutive registers.");
+                return;
+            }
+            add_local_at_reg(compiler, var_stmt->variables[i].name, reg);
+        }
+        return;
+    }
+
+    int first = alloc_temp(compiler);
+    compiler->call_results = count;
+    COMPILE_REQUIRED(compiler, call, first);
+    for (int i = 0; i < count; i++) {
+        int name_const = identifier_constant(compiler, &var_stmt->variables[i].name);
+        int bytecode_pos = compiler->compiling_chunk->count;
+        emit_instruction(compiler, PACK_ABx(DEFINE_GLOBAL, first + i, name_const), line);
+        record_global_decl(compiler, var_stmt->variables[i].name, bytecode_pos);
+    }
+}
+
+// Destructuring into names a block or function body already reserved back to
+// back: the call unpacks straight into their registers.
+static void compile_predeclared_destructure(Compiler* compiler, VarDeclStmt* var_stmt, int line) {
+    int first = resolve_local(compiler, &var_stmt->variables[0].name);
+    for (int j = 0; j < var_stmt->count; j++) {
+        if (first == -1 || resolve_local(compiler, &var_stmt->variables[j].name) != first + j) {
+            compiler_error(compiler, line, "Destructured variables need consecutive registers.");
+            return;
+        }
+    }
+
+    compiler->call_results = var_stmt->count;
+    COMPILE_REQUIRED(compiler, var_stmt->variables[var_stmt->count - 1].initializer, first);
+
+    for (int j = 0; j < var_stmt->count; j++) {
+        for (int k = 0; k < compiler->local_count; k++) {
+            if (compiler->locals[k].reg == first + j) {
+                compiler->locals[k].is_initialized = true;
+                break;
+            }
+        }
+    }
+}
+
 // --- Statement Compilation ---
 
 static bool compile_statement(Compiler* compiler, Stmt* stmt) {
@@ -2934,6 +3465,10 @@ static bool compile_statement(Compiler* compiler, Stmt* stmt) {
         }
         case STMT_VAR_DECLARATION: {
             VarDeclStmt* var_stmt = &stmt->as.var_declaration;
+            if (var_stmt->destructure) {
+                compile_destructuring_var(compiler, var_stmt, stmt->line);
+                return false;
+            }
             for (int i = 0; i < var_stmt->count; i++) {
                 VarDecl* var = &var_stmt->variables[i];
                 if (compiler->scope_depth > 0) { // Local variable
@@ -3130,7 +3665,7 @@ static bool compile_statement(Compiler* compiler, Stmt* stmt) {
             }
 
             // Compile the function body and create the closure.
-            ObjFunction* function = compile_function_body(compiler, func_stmt);
+            ObjFunction* function = compile_function_body(compiler, func_stmt, NULL);
             int const_index = make_constant(compiler, OBJ_VAL(function));
             popTempRoot(compiler->vm);  // Pop protection from compile_function_body
 
@@ -3214,6 +3749,8 @@ static bool compile_statement(Compiler* compiler, Stmt* stmt) {
                 }
             }
 
+            declare_dispatcher_caches(compiler, block);
+
             // Pre-declare all variable declarations WITHOUT evaluating initializers.
             // This reserves register slots for all local variables so they can be captured by closures
             // that are defined earlier in the block (function hoisting).
@@ -3270,6 +3807,10 @@ static bool compile_statement(Compiler* compiler, Stmt* stmt) {
                 // Handle pre-declared variable declarations specially
                 if (s->type == STMT_VAR_DECLARATION) {
                     VarDeclStmt* var_stmt = &s->as.var_declaration;
+                    if (var_stmt->destructure) {
+                        compile_predeclared_destructure(compiler, var_stmt, s->line);
+                        continue;
+                    }
                     for (int j = 0; j < var_stmt->count; j++) {
                         VarDecl* var = &var_stmt->variables[j];
                         int var_reg = resolve_local(compiler, &var->name);
@@ -3362,11 +3903,54 @@ static bool compile_statement(Compiler* compiler, Stmt* stmt) {
             bool if_negated = (if_cond->type == EXPR_UNARY && if_cond->as.unary.operator.type == TOKEN_BANG);
             Expr* if_inner = if_negated ? if_cond->as.unary.right : if_cond;
 
-            int then_jump = try_emit_branch_compare(compiler, if_inner, if_negated, stmt->line);
+            Stmt* else_branch = stmt->as.if_stmt.else_branch;
+
+            Chunk* chunk = compiler->compiling_chunk;
+            int cond_start = chunk->count;
+            int cond_bias = compiler->profile_bias;
+            int cond_top = save_temp_top(compiler);
+            int first_constant = chunk->constants.count;
 
-            if (then_jump == -1) {
-                int condition_reg = compile_sub_expression(compiler, if_inner);
-                then_jump = emit_jump_instruction(compiler, if_negated ? JUMP_IF_TRUE : JUMP_IF_FALSE, condition_reg, stmt->line);
+            int then_jump = emit_condition_jump(compiler, if_inner, if_negated, stmt->line);
+
+            // When the profile shows the else arm is the hot one, lay it out right
+            // after the condition so it runs without taking a jump
+            int else_offset = -1;
+            if (else_branch != NULL && !compiler->has_error &&
+                profile_prefers_else(compiler, then_jump, &else_offset) &&
+                !added_function_constant(compiler, first_constant)) {
+                int then_offset = profile_offset(compiler);
+                chunk->count = cond_start;
+                compiler->profile_bias = cond_bias;
+                restore_temp_top(compiler, cond_top);
+
+                int to_then = emit_condition_jump(compiler, if_inner, !if_negated, stmt->line);
+
+                compiler->profile_bias = else_offset - chunk->count;
+                compiler->in_tail_position = saved_tail_if;
+                bool else_terminates = compile_statement(compiler, else_branch);
+                compiler->in_tail_position = false;
+                int end_offset = profile_offset(compiler);
+
+                int end_jump = -1;
+                if (!else_terminates) {
+                    end_jump = emit_jump_instruction(compiler, JUMP, 0, stmt->line);
+                }
+
+                patch_jump(compiler, to_then);
+                compiler->profile_bias = then_offset - chunk->count;
+                compiler->in_tail_position = saved_tail_if;
+                bool then_terminates = compile_statement(compiler, stmt->as.if_stmt.then_branch);
+                compiler->in_tail_position = false;
+
+                if (end_jump != -1) {
+                    patch_jump(compiler, end_jump);
+                }
+
+                // Code after the if continues where the unguided build's else arm ended
+                compiler->profile_bias = end_offset - chunk->count;
+
+                return then_terminates && else_terminates;
             }
 
             // Propagate tail position to both branches
@@ -3581,6 +4165,22 @@ static bool compile_statement(Compiler* compiler, Stmt* stmt) {
             return false;
         }
         case STMT_RETURN: {
+            if (stmt->as.return_stmt.extra_count > 0) {
+                // return a, b, ...: evaluate into consecutive registers; RET's C
+                // carries the count and the VM copies them up to the callee slot.
+                ReturnStmt* ret = &stmt->as.return_stmt;
+                int value_count = 1 + ret->extra_count;
+                int first = alloc_temp(compiler);
+                for (int i = 1; i < value_count; i++) {
+                    alloc_temp(compiler);
+                }
+                COMPILE_REQUIRED(compiler, ret->value, first);
+                for (int i = 0; i < ret->extra_count; i++) {
+                    COMPILE_REQUIRED(compiler, ret->extra_values[i], first + 1 + i);
+                }
+                emit_instruction(compiler, PACK_ABC(RET, first, 0, value_count), stmt->line);
+                return true;
+            }
             if (stmt->as.return_stmt.value) {
                 // Check if we're returning an overloaded function by plain name
                 // If so, create a dispatcher that holds all overloads
@@ -3589,9 +4189,9 @@ static bool compile_statement(Compiler* compiler, Stmt* stmt) {
                     int lar = single_local_hoisted_arity(compiler, name);
 
                     if (lar == -2) {
-                        // Multiple overloads exist! Use emit_dispatcher
+                        // Multiple overloads exist! Return the scope's cached dispatcher
                         int reg = alloc_temp(compiler);
-                        emit_dispatcher(compiler, name, reg, stmt->line, true);
+                        emit_cached_dispatcher(compiler, name, reg, stmt->line, true);
                         emit_instruction(compiler, PACK_ABx(RET, reg, 0), stmt->line);
                         return true;
                     }
@@ -3819,6 +4419,59 @@ static bool compile_statement(Compiler* compiler, Stmt* stmt) {
             FREE_ARRAY(compiler->vm, int, case_body_jumps, stmt->as.switch_stmt.case_count);
             return false;
         }
+        case STMT_TRY: {
+            TryStmt* try_stmt = &stmt->as.try_stmt;
+            bool saved_tail_try = compiler->in_tail_position;
+            compiler->in_tail_position = false;
+
+            // Nothing is emitted on entry: the body's instruction range goes into
+            // the chunk's handler table and is only consulted when something throws.
+            // Registers from here up belong to the body once it is entered.
+            int close_from = compiler->next_register;
+            int body_start = compiler->compiling_chunk->count;
+            compiler->try_depth++;
+            bool body_terminates = compile_statement(compiler, try_stmt->body);
+            compiler->try_depth--;
+            int body_end = compiler->compiling_chunk->count;
+
+            int skip_handler = emit_jump_instruction(compiler, JUMP, 0, stmt->line);
+            int handler_start = compiler->compiling_chunk->count;
+
+            begin_scope(compiler);
+            int exception_reg;
+            if (try_stmt->has_name) {
+                declare_variable(compiler, &try_stmt->catch_name);
+                exception_reg = add_local(compiler, try_stmt->catch_name);
+                compiler->locals[compiler->local_count - 1].is_initialized = true;
+            } else {
+                exception_reg = reserve_register(compiler);
+            }
+
+            compiler->in_tail_position = saved_tail_try;
+            bool handler_terminates = compile_statement(compiler, try_stmt->handler);
+            compiler->in_tail_position = false;
+            end_scope(compiler);
+            patch_jump(compiler, skip_handler);
+
+            // Appended after the body so nested try statements come first and the
+            // first matching entry is always the innermost one.
+            if (body_end > body_start) {
+                addExceptionHandler(compiler->vm, compiler->compiling_chunk, (ExceptionHandler){
+                    .start = body_start,
+                    .end = body_end,
+                    .handler = handler_start,
+                    .reg = exception_reg,
+                    .close_from = close_from,
+                });
+            }
+            return body_terminates && handler_terminates;
+        }
+        case STMT_THROW: {
+            compiler->in_tail_position = false;
+            int value_reg = compile_sub_expression(compiler, stmt->as.throw_stmt.value);
+            emit_instruction(compiler, PACK_ABx(THROW, value_reg, 0), stmt->line);
+            return true;
+        }
         default: return false;
     }
     return false;
@@ -3881,9 +4534,11 @@ static void init_compiler(Compiler* compiler, VM* vm, Compiler* enclosing) {
 
     // Initially not in tail position
     compiler->in_tail_position = false;
+    compiler->try_depth = 0;
 
     // By default, expression results are needed
     compiler->result_needed = true;
+    compiler->call_results = 0;
 
     // Initialize label and goto tracking
     memset(compiler->labels, 0, sizeof(compiler->labels));
@@ -3896,6 +4551,14 @@ static void init_compiler(Compiler* compiler, VM* vm, Compiler* enclosing) {
     memset(compiler->global_decls, 0, sizeof(compiler->global_decls));
     compiler->global_decl_count = 0;
 
+    // The profile is shared; each function looks up its own records
+    compiler->profile = enclosing ? enclosing->profile : NULL;
+    compiler->profile_function = NULL;
+    compiler->profile_bias = 0;
+    compiler->profile_unmapped = false;
+    compiler->profile_probing = false;
+    compiler->last_branch_start = -1;
+
 
 }
 
@@ -4079,6 +4742,11 @@ static void collect_local_hoisted_in_stmt(Compiler* c, Stmt* s) {
                 // increment/condition are expressions; nothing to collect there.
                 break;
         }
+        case STMT_TRY: {
+                collect_local_hoisted_in_stmt(c, s->as.try_stmt.body);
+                collect_local_hoisted_in_stmt(c, s->as.try_stmt.handler);
+                break;
+        }
         default: break;
     }
 }
@@ -4192,6 +4860,10 @@ static bool is_name_assigned_in_stmt(const Token* name, Stmt* stmt) {
                    is_name_assigned_in_expr(name, stmt->as.for_stmt.increment) ||
                    is_name_assigned_in_stmt(name, stmt->as.for_stmt.body);
         case STMT_RETURN:
+            for (int i = 0; i < stmt->as.return_stmt.extra_count; i++) {
+                if (is_name_assigned_in_expr(name, stmt->as.return_stmt.extra_values[i]))
+                    return true;
+            }
             return is_name_assigned_in_expr(name, stmt->as.return_stmt.value);
         case STMT_VAR_DECLARATION: {
             for (int i = 0; i < stmt->as.var_declaration.count; i++) {
@@ -4211,17 +4883,23 @@ static bool is_name_assigned_in_stmt(const Token* name, Stmt* stmt) {
             }
             return false;
         }
+        case STMT_TRY:
+            return is_name_assigned_in_stmt(name, stmt->as.try_stmt.body) ||
+                   is_name_assigned_in_stmt(name, stmt->as.try_stmt.handler);
+        case STMT_THROW:
+            return is_name_assigned_in_expr(name, stmt->as.throw_stmt.value);
         default:
             return false;
     }
 }
 
-static ObjFunction* compile_function_body(Compiler* current_compiler, FuncDeclStmt* stmt) {
+// Compiles stmt's body into target, or into a fresh function when target is NULL.
+static ObjFunction* compile_function_body(Compiler* current_compiler, FuncDeclStmt* stmt, ObjFunction* target) {
     Compiler fn_compiler = {0};  // Zero-initialize to prevent garbage values during GC
     init_compiler(&fn_compiler, current_compiler->vm, current_compiler);
 
     // Create a new function object for the body we are about to compile.
-    ObjFunction* function = newFunction(fn_compiler.vm);
+    ObjFunction* function = target != NULL ? target : newFunction(fn_compiler.vm);
 
     // Assign function to compiler BEFORE registering with VM
     // This ensures the function is marked if GC triggers
@@ -4238,6 +4916,14 @@ static ObjFunction* compile_function_body(Compiler* current_compiler, FuncDeclSt
     function->is_variadic = is_variadic;
     function->fixed_arity = params_fixed_count(stmt->params, stmt->param_count);
 
+    if (current_compiler->profile_function != NULL) {
+        char key[PROFILE_KEY_MAX];
+        if (profileKey(key, sizeof(key), current_compiler->profile_function->key,
+                       stmt->name.start, stmt->name.length, stmt->param_count)) {
+            fn_compiler.profile_function = findProfileFunction(fn_compiler.profile, key);
+        }
+    }
+
     if (stmt->name.length > 9 && memcmp(stmt->name.start, "__module_", 9) == 0) {
         // Case 1: We are compiling a Module Factory.
         // Decode encoded path: "__module_src_slash_math_dot_zym" -> "src/math.zym"
@@ -4324,6 +5010,8 @@ static ObjFunction* compile_function_body(Compiler* current_compiler, FuncDeclSt
         }
     }
 
+    declare_dispatcher_caches(&fn_compiler, body);
+
     // Pass 1: Declare variables WITHOUT evaluating initializers.
     // This reserves register slots for all local variables so they can be captured by closures.
     // Check if the function body contains any function declarations (closures).
@@ -4389,7 +5077,9 @@ static ObjFunction* compile_function_body(Compiler* current_compiler, FuncDeclSt
             fn_compiler.in_tail_position = true;
         }
 
-        if (s->type == STMT_VAR_DECLARATION) {
+        if (s->type == STMT_VAR_DECLARATION && s->as.var_declaration.destructure) {
+            compile_predeclared_destructure(&fn_compiler, &s->as.var_declaration, s->line);
+        } else if (s->type == STMT_VAR_DECLARATION) {
             VarDeclStmt* var_stmt = &s->as.var_declaration;
             for (int j = 0; j < var_stmt->count; j++) {
                 VarDecl* var = &var_stmt->variables[j];
@@ -4474,9 +5164,169 @@ static ObjFunction* compile_function_body(Compiler* current_compiler, FuncDeclSt
     return fn_compiler.function;
 }
 
+// --- Lazy function bodies ---
+
+static void release_lazy_unit(VM* vm, LazyUnit* unit) {
+    if (--unit->ref_count > 0) return;
+
+    for (LazyUnit** link = &vm->lazy_units; *link != NULL; link = &(*link)->next) {
+        if (*link == unit) {
+            *link = unit->next;
+            break;
+        }
+    }
+
+    if (unit->ast.statements != NULL) {
+        for (int i = 0; unit->ast.statements[i] != NULL; i++) free_stmt(vm, unit->ast.statements[i]);
+        FREE_ARRAY(vm, Stmt*, unit->ast.statements, unit->ast.capacity);
+    }
+    if (unit->root != NULL) {
+        free_owned_names(unit->root);
+        if (unit->root->global_types) {
+            FREE_ARRAY(vm, GlobalType, unit->root->global_types, unit->root->global_type_capacity);
+        }
+        FREE(vm, Compiler, unit->root);
+    }
+    if (unit->profile != NULL) freeProfile(vm, unit->profile);
+    FREE_ARRAY(vm, char, unit->source, unit->source_length + 1);
+    FREE(vm, LazyUnit, unit);
+}
+
+void releaseLazyFunction(VM* vm, LazyFunction* lazy) {
+    LazyUnit* unit = lazy->unit;
+    FREE(vm, LazyFunction, lazy);
+    release_lazy_unit(vm, unit);
+}
+
+// Copies the top-level compiler as it stands after the declaration pass. Deferred
+// bodies are compiled against this copy, so they see the same hoisted functions,
+// schemas and dispatcher caches an eager compile would.
+static void snapshot_lazy_root(Compiler* compiler, LazyUnit* unit) {
+    VM* vm = compiler->vm;
+    Compiler* root = ALLOCATE(vm, Compiler, 1);
+    *root = *compiler;
+
+    root->function = NULL;
+    root->compiling_chunk = NULL;
+    root->break_jumps = NULL;
+    root->break_count = 0;
+    root->break_capacity = 0;
+    root->pending_gotos = NULL;
+    root->pending_goto_count = 0;
+    root->pending_goto_capacity = 0;
+    root->owned_names = NULL;
+    root->owned_names_count = 0;
+    root->owned_names_cap = 0;
+    if (compiler->global_types != NULL) {
+        root->global_types = ALLOCATE(vm, GlobalType, compiler->global_type_capacity);
+        memcpy(root->global_types, compiler->global_types, sizeof(GlobalType) * compiler->global_type_count);
+    }
+
+    // Top-level functions never capture: the script has no locals while they are defined.
+    for (int i = 0; i < root->hoisted_count; i++) {
+        root->hoisted[i].upvalue_count = 0;
+    }
+    unit->root = root;
+}
+
+// Emits the closure for a top-level function whose body is deferred. The stub
+// carries everything callers check before entering the body.
+static void emit_lazy_function(Compiler* compiler, Stmt* stmt, LazyUnit* unit) {
+    VM* vm = compiler->vm;
+    FuncDeclStmt* func_stmt = &stmt->as.func_declaration;
+    bool is_variadic = params_have_rest(func_stmt->params, func_stmt->param_count);
+    int fixed = params_fixed_count(func_stmt->params, func_stmt->param_count);
+
+    char* mangled = is_variadic ? mangle_name_variadic(compiler, &func_stmt->name, fixed)
+                                : mangle_name(compiler, &func_stmt->name, func_stmt->param_count);
+    ObjString* str = copyString(vm, mangled, strlen(mangled));
+    pushTempRoot(vm, (Obj*)str);
+    int name_ident = make_constant(compiler, OBJ_VAL(str));
+    popTempRoot(vm);
+    FREE_ARRAY(vm, char, mangled, strlen(mangled) + 1);
+
+    ObjFunction* function = newFunction(vm);
+    pushTempRoot(vm, (Obj*)function);
+    function->name = copyString(vm, func_stmt->name.start, func_stmt->name.length);
+    function->arity = func_stmt->param_count;
+    function->is_variadic = is_variadic;
+    function->fixed_arity = fixed;
+
+    LazyFunction* lazy = ALLOCATE(vm, LazyFunction, 1);
+    lazy->unit = unit;
+    lazy->decl = func_stmt;
+    lazy->tco_mode = compiler->tco_mode;
+    unit->ref_count++;
+    function->lazy = lazy;
+
+    int const_index = make_constant(compiler, OBJ_VAL(function));
+    popTempRoot(vm);
+
+    for (int i = 0; i < compiler->hoisted_count; i++) {
+        if (tokens_equal(&compiler->hoisted[i].name, &func_stmt->name) &&
+            compiler->hoisted[i].is_variadic == is_variadic &&
+            (is_variadic || compiler->hoisted[i].arity == func_stmt->param_count)) {
+            compiler->hoisted[i].upvalue_count = 0;
+            break;
+        }
+    }
+
+    int closure_reg = alloc_temp(compiler);
+    emit_closure(compiler, closure_reg, const_index, stmt->line);
+    emit_set_global(compiler, closure_reg, name_ident, stmt->line);
+}
+
+bool compileLazyFunction(VM* vm, ObjFunction* function) {
+    LazyFunction* lazy = function->lazy;
+    Compiler* root = lazy->unit->root;
+    struct Compiler* saved_compiler = vm->compiler;
+
+    root->has_error = false;
+    root->tco_mode = lazy->tco_mode;
+    vm->compiler = root;
+    compile_function_body(root, lazy->decl, function);
+    popTempRoot(vm);  // Pop protection from compile_function_body
+    vm->compiler = saved_compiler;
+
+    if (root->has_error) {
+        // Leave the stub pending so every later call reports the failure too.
+        freeChunk(vm, &function->chunk);
+        initChunk(&function->chunk);
+        function->max_regs = 1;
+        runtimeError(vm, "Failed to compile function '%s'.", function->name->chars);
+        return false;
+    }
+
+    function->lazy = NULL;
+    releaseLazyFunction(vm, lazy);
+    return true;
+}
+
 bool compile(VM* vm, const char* source, Chunk* chunk, const LineMap* line_map, const char* entry_file, CompilerConfig config) {
+    // In lazy mode the AST outlives this call, so parse from a copy of the source
+    // that the lazy unit owns; deferred function bodies are compiled from it later.
+    LazyUnit* lazy_unit = NULL;
+    if (config.lazy_functions) {
+        lazy_unit = ALLOCATE(vm, LazyUnit, 1);
+        lazy_unit->ref_count = 1;
+        lazy_unit->source_length = strlen(source);
+        lazy_unit->source = ALLOCATE(vm, char, lazy_unit->source_length + 1);
+        memcpy(lazy_unit->source, source, lazy_unit->source_length + 1);
+        lazy_unit->ast.statements = NULL;
+        lazy_unit->ast.capacity = 0;
+        lazy_unit->root = NULL;
+        lazy_unit->profile = NULL;
+        lazy_unit->next = vm->lazy_units;
+        vm->lazy_units = lazy_unit;
+        source = lazy_unit->source;
+    }
+
     AstResult ast = parse(vm, source, line_map, entry_file);
-    if (ast.statements == NULL) return false;
+    if (ast.statements == NULL) {
+        if (lazy_unit) release_lazy_unit(vm, lazy_unit);
+        return false;
+    }
+    if (lazy_unit) lazy_unit->ast = ast;
 
     // Use init_compiler to set up the top-level compiler correctly.
     Compiler compiler = {0};  // Zero-initialize to prevent garbage values during GC
@@ -4497,6 +5347,19 @@ bool compile(VM* vm, const char* source, Chunk* chunk, const LineMap* line_map,
         vm->entry_file = compiler.function->module_name;
     }
     compiler.compiling_chunk = &compiler.function->chunk;
+
+    // Deferred bodies are compiled against the profile too, so the lazy unit owns it
+    Profile* profile = NULL;
+    if (config.profile != NULL) {
+        profile = parseProfile(vm, config.profile, config.profile_size);
+        if (profile == NULL) {
+            compiler_error(&compiler, -1, "Malformed profile.");
+            goto cleanup_on_error;
+        }
+        if (lazy_unit) lazy_unit->profile = profile;
+        compiler.profile = profile;
+        compiler.profile_function = findProfileFunction(profile, "<script>");
+    }
     // ---------------
 
     // --- PASS 1: DECLARATION ---
@@ -4515,6 +5378,9 @@ bool compile(VM* vm, const char* source, Chunk* chunk, const LineMap* line_map,
         }
     }
 
+    define_dispatcher_caches(&compiler);
+    if (lazy_unit) snapshot_lazy_root(&compiler, lazy_unit);
+
     // --- PASS 2: CODE GENERATION ---
     // Pass 2a: Compile function definitions and process directives in source order.
     // This ensures directives affect functions that come after them.
@@ -4533,7 +5399,11 @@ bool compile(VM* vm, const char* source, Chunk* chunk, const LineMap* line_map,
                 }
             }
         } else if (ast.statements[i]->type == STMT_FUNC_DECLARATION) {
-            compile_statement(&compiler, ast.statements[i]);
+            if (lazy_unit) {
+                emit_lazy_function(&compiler, ast.statements[i], lazy_unit);
+            } else {
+                compile_statement(&compiler, ast.statements[i]);
+            }
             if (compiler.has_error) goto cleanup_on_error;
 
             // Reset register allocator for next statement at top level
@@ -4608,6 +5478,10 @@ cleanup_on_error:
         FREE_ARRAY(vm, PendingGoto, compiler.pending_gotos, compiler.pending_goto_capacity);
     }
 
+    if (profile != NULL && !lazy_unit) {
+        freeProfile(vm, profile);
+    }
+
     // Check if any errors occurred during compilation
     bool success = !compiler.has_error;
 
@@ -4624,9 +5498,13 @@ cleanup_on_error:
     // We don't manually free it here - the GC will handle cleanup
     // Manually freeing it would cause a double-free during freeVM()
 
-    // Free the AST
-    for (int i = 0; ast.statements[i] != NULL; i++) free_stmt(vm, ast.statements[i]);
-    FREE_ARRAY(vm, Stmt*, ast.statements, ast.capacity);
+    // Free the AST, unless deferred function bodies still refer to it
+    if (lazy_unit) {
+        release_lazy_unit(vm, lazy_unit);
+    } else {
+        for (int i = 0; ast.statements[i] != NULL; i++) free_stmt(vm, ast.statements[i]);
+        FREE_ARRAY(vm, Stmt*, ast.statements, ast.capacity);
+    }
 
     // Deep copy the compiled chunk to the external chunk parameter
     // We compiled into compiler.function->chunk, but caller expects results in chunk parameter
@@ -4636,12 +5514,18 @@ cleanup_on_error:
         chunk->code = compiler.function->chunk.code;
         chunk->lines = compiler.function->chunk.lines;
         chunk->constants = compiler.function->chunk.constants;
+        chunk->handlers = compiler.function->chunk.handlers;
+        chunk->handler_count = compiler.function->chunk.handler_count;
+        chunk->handler_capacity = compiler.function->chunk.handler_capacity;
 
         // Mark the function's chunk as "don't free" by NULLing the pointers
         // This prevents double-free when the function is eventually freed by GC
         compiler.function->chunk.code = NULL;
         compiler.function->chunk.lines = NULL;
         compiler.function->chunk.constants.values = NULL;
+        compiler.function->chunk.handlers = NULL;
+        compiler.function->chunk.handler_count = 0;
+        compiler.function->chunk.handler_capacity = 0;
         compiler.function->chunk.count = 0;
         compiler.function->chunk.capacity = 0;
         compiler.function->chunk.constants.count = 0;
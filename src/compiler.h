@@ -4,6 +4,7 @@
 #include "./chunk.h"
 #include "./linemap.h"
 #include "./config.h"
+#include "./profile.h"
 
 typedef struct VM VM;
 typedef struct ObjString ObjString;
@@ -144,7 +145,9 @@ typedef struct Compiler {
 
     TcoMode tco_mode;
     bool in_tail_position;
+    int try_depth;  // enclosing try bodies; tail calls are off inside them
     bool result_needed;
+    int call_results;  // results the next compiled call unpacks (0: single value)
 
     Label labels[MAX_LABELS];
     int label_count;
@@ -157,6 +160,40 @@ typedef struct Compiler {
     int global_decl_count;
 
     ObjString* current_module_name;
+
+    // Profile-guided layout (CompilerConfig.profile). Records are looked up by
+    // the offset the instruction had in the unguided build: count + profile_bias.
+    const struct Profile* profile;
+    const ProfileFunction* profile_function;  // NULL: no records for this function
+    int profile_bias;
+    bool profile_unmapped;      // offsets in this region have no unguided counterpart
+    bool profile_probing;       // compiling a '+' chain plainly to read its records
+    int last_branch_start;      // offset of the conditional try_emit_branch_compare emitted
 } Compiler;
 
-bool compile(VM* vm, const char* source, Chunk* chunk, const LineMap* line_map, const char* entry_file, CompilerConfig config);
\ No newline at end of file
+// Lazy compilation state shared by every top-level function of one compile()
+// call. The unit owns a copy of the source and the parsed AST (whose tokens
+// point into that copy), plus a snapshot of the top-level compiler taken after
+// the declaration pass. It is freed when the last pending function releases it.
+typedef struct LazyUnit {
+    struct LazyUnit* next;
+    int ref_count;
+    char* source;
+    size_t source_length;
+    AstResult ast;
+    Compiler* root;
+    Profile* profile;
+} LazyUnit;
+
+struct LazyFunction {
+    LazyUnit* unit;
+    FuncDeclStmt* decl;
+    TcoMode tco_mode;
+};
+
+bool compile(VM* vm, const char* source, Chunk* chunk, const LineMap* line_map, const char* entry_file, CompilerConfig config);
+
+// Generates bytecode for a function deferred by CompilerConfig.lazy_functions.
+// Reports a runtime error and returns false if the body fails to compile.
+bool compileLazyFunction(VM* vm, ObjFunction* function);
+void releaseLazyFunction(VM* vm, struct LazyFunction* lazy);
@@ -1,9 +1,20 @@
 #pragma once
 
 #include <stdbool.h>
+#include <stddef.h>
 
 typedef struct CompilerConfig {
     bool include_line_info;
+    // Defer code generation for top-level function bodies until their first call.
+    // Syntax errors are still reported by compile(); other errors in a body
+    // surface as a runtime error when that function is first called.
+    bool lazy_functions;
+    // Text from zym_writeProfile for an earlier build of the same source that
+    // was compiled without a profile. Hot if/else arms are laid out to skip the
+    // jump over the other arm, and '+' chains that only ever joined strings are
+    // built with one concatenation. NULL compiles without it.
+    const char* profile;
+    size_t profile_size;
 } CompilerConfig;
 
 typedef CompilerConfig ZymCompilerConfig;
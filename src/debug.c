@@ -118,7 +118,11 @@ static int constantInstruction(const char* name, Chunk* chunk, uint32_t instr, i
 static int callInstruction(const char* name, uint32_t instr, int offset) {
     uint8_t a = REG_A(instr);
     uint16_t argc = REG_Bx(instr);
-    printf("%-16s R%-2u, %4u args\n", name, a, argc);
+    if (REG_C(instr) > 1) {
+        printf("%-16s R%-2u, %4u args -> %u results\n", name, a, REG_B(instr), REG_C(instr));
+    } else {
+        printf("%-16s R%-2u, %4u args\n", name, a, argc);
+    }
     return offset + 1;
 }
 
@@ -201,6 +205,12 @@ void disassembleChunkToFile(Chunk* chunk, const char* name, FILE* file) {
         offset = disassembleInstruction(chunk, offset);
     }
 
+    for (int i = 0; i < chunk->handler_count; i++) {
+        ExceptionHandler* h = &chunk->handlers[i];
+        fprintf(file, "handler [%04d, %04d) -> %04d, R%d (close from R%d)\n",
+                h->start, h->end, h->handler, h->reg, h->close_from);
+    }
+
     for (int i = 0; i < chunk->constants.count; i++) {
         Value v = chunk->constants.values[i];
         if (IS_OBJ(v) && IS_FUNCTION(v)) {
@@ -221,6 +231,12 @@ void disassembleChunk(Chunk* chunk, const char* name) {
         offset = disassembleInstruction(chunk, offset);
     }
 
+    for (int i = 0; i < chunk->handler_count; i++) {
+        ExceptionHandler* h = &chunk->handlers[i];
+        printf("handler [%04d, %04d) -> %04d, R%d (close from R%d)\n",
+               h->start, h->end, h->handler, h->reg, h->close_from);
+    }
+
     for (int i = 0; i < chunk->constants.count; i++) {
         Value v = chunk->constants.values[i];
         if (IS_OBJ(v) && IS_FUNCTION(v)) {
@@ -392,6 +408,22 @@ int disassembleInstruction(Chunk* chunk, int offset) {
             printf("%-16s R%d, field[%d], R%d\n", "SET_FIELD_IC", a, b, c);
             return offset + 2;
         }
+        case GET_VEC_COMPONENT_IC: {
+            uint8_t a = REG_A(instruction);
+            uint8_t b = REG_B(instruction);
+            uint8_t c = REG_C(instruction);
+            printf("%-16s R%d, R%d, comp[%d]\n", "GET_VEC_IC", a, b, c);
+            return offset + 2;
+        }
+        case INVOKE: {
+            uint8_t a = REG_A(instruction);
+            uint8_t b = REG_B(instruction);
+            uint32_t ci = chunk->code[offset + 1];
+            ObjString* key = AS_STRING(chunk->constants.values[ci]);
+            printf("%-16s R%d, @%u(\"%.*s\"), %d args\n", "INVOKE", a, ci, key->length, key->chars, b);
+            return offset + 3;
+        }
+        case CONCAT_N:      return reg_instruction_abc("CONCAT_N", instruction, offset);
         case NEW_DISPATCHER: return reg_instruction_a("NEW_DISPATCHER", instruction, offset);
         case ADD_OVERLOAD:   return reg2_instruction("ADD_OVERLOAD", chunk, offset);
         case SET_VARIADIC_FALLBACK: return reg_instruction_abc("SET_VAR_FALLBACK", instruction, offset);
@@ -407,14 +439,16 @@ int disassembleInstruction(Chunk* chunk, int offset) {
         case RET: {
             uint32_t instr = instruction;
             uint8_t  a  = REG_A(instr);
-            uint16_t bx = REG_Bx(instr);
-            if (bx == 1) {
+            if (REG_B(instr) == 1) {
                 printf("%-16s (implicit null)\n", "RET");
+            } else if (REG_C(instr) > 1) {
+                printf("%-16s R%-2u..R%-2u\n", "RET", a, a + REG_C(instr) - 1);
             } else {
                 printf("%-16s R%-2u\n", "RET", a);
             }
             return offset + 1;
         }
+        case THROW: return reg_instruction_a("THROW", instruction, offset);
         default:
             printf("Unknown opcode %u\n", opcode);
             return offset + 1;
@@ -9,11 +9,14 @@
 #include "./value.h"
 #include "./table.h"
 #include "./chunk.h"
+#include "./profile.h"
 
 static void markRoots(VM* vm);
 static void traceReferences(VM* vm);
 static void blackenObject(VM* vm, Obj* object);
 static void sweep(VM* vm);
+static void finalizeObject(VM* vm, Obj* object);
+static size_t releaseObject(const ZymAllocator* allocator, Obj* object);
 static void markChunk(VM* vm, Chunk* chunk);
 
 void pushTempRoot(VM* vm, Obj* object) {
@@ -155,6 +158,111 @@ static void markChunk(VM* vm, Chunk* chunk) {
     }
 }
 
+static void markCompilerRoots(VM* vm, struct Compiler* compiler) {
+    #ifdef GC_DEBUG_FULL
+    printf("  Compiler chain: %p (enclosing=%p)\n", (void*)compiler, (void*)compiler->enclosing);
+    fflush(stdout);
+    #endif
+    #ifdef GC_DEBUG_FULL
+    printf("  Marking function being compiled: %p\n", (void*)compiler->function);
+    fflush(stdout);
+    #endif
+    if (compiler->function != NULL) {
+        if (compiler->current_module_name != NULL) {
+            markObject(vm, (Obj*)compiler->current_module_name);
+        }
+        Obj* fn_obj = (Obj*)compiler->function;
+        if (fn_obj->type < 0 || fn_obj->type > 20) {
+            printf("  ERROR: compiler->function has invalid type %d, skipping\n", fn_obj->type);
+            fflush(stdout);
+        } else {
+            markObject(vm, fn_obj);
+        }
+    }
+
+    #ifdef GC_DEBUG_FULL
+    printf("  Marking %d struct schemas\n", compiler->struct_schema_count);
+    fflush(stdout);
+    #endif
+    for (int i = 0; i < compiler->struct_schema_count; i++) {
+        #ifdef GC_DEBUG_FULL
+        printf("    struct_schema[%d]: schema=%p, field_count=%d, field_names=%p\n",
+               i, (void*)compiler->struct_schemas[i].schema,
+               compiler->struct_schemas[i].field_count,
+               (void*)compiler->struct_schemas[i].field_names);
+        fflush(stdout);
+        #endif
+        if (compiler->struct_schemas[i].schema) {
+            markObject(vm, (Obj*)compiler->struct_schemas[i].schema);
+        }
+        if (compiler->struct_schemas[i].field_names) {
+            for (int j = 0; j < compiler->struct_schemas[i].field_count; j++) {
+                if (compiler->struct_schemas[i].field_names[j]) {
+                    markObject(vm, (Obj*)compiler->struct_schemas[i].field_names[j]);
+                }
+            }
+        }
+    }
+
+    for (int i = 0; i < compiler->enum_schema_count; i++) {
+        if (compiler->enum_schemas[i].schema) {
+            markObject(vm, (Obj*)compiler->enum_schemas[i].schema);
+        }
+        if (compiler->enum_schemas[i].variant_names) {
+            for (int j = 0; j < compiler->enum_schemas[i].variant_count; j++) {
+                if (compiler->enum_schemas[i].variant_names[j]) {
+                    markObject(vm, (Obj*)compiler->enum_schemas[i].variant_names[j]);
+                }
+            }
+        }
+    }
+
+    #ifdef GC_DEBUG_FULL
+    printf("  Marking %d local struct types\n", compiler->local_count);
+    fflush(stdout);
+    #endif
+    for (int i = 0; i < compiler->local_count; i++) {
+        if (compiler->locals[i].struct_type) {
+            #ifdef GC_DEBUG_FULL
+            printf("    local[%d].struct_type = %p\n", i, (void*)compiler->locals[i].struct_type);
+            fflush(stdout);
+            #endif
+            markObject(vm, (Obj*)compiler->locals[i].struct_type);
+        }
+    }
+
+    #ifdef GC_DEBUG_FULL
+    printf("  Marking %d upvalue struct types\n", compiler->upvalue_count);
+    fflush(stdout);
+    #endif
+    for (int i = 0; i < compiler->upvalue_count; i++) {
+        if (compiler->upvalues[i].struct_type) {
+            #ifdef GC_DEBUG_FULL
+            printf("    upvalue[%d].struct_type = %p\n", i, (void*)compiler->upvalues[i].struct_type);
+            fflush(stdout);
+            #endif
+            markObject(vm, (Obj*)compiler->upvalues[i].struct_type);
+        }
+    }
+
+    #ifdef GC_DEBUG_FULL
+    printf("  Marking %d global types\n", compiler->global_type_count);
+    fflush(stdout);
+    #endif
+    for (int i = 0; i < compiler->global_type_count; i++) {
+        if (compiler->global_types[i].name) {
+            markObject(vm, (Obj*)compiler->global_types[i].name);
+        }
+        if (compiler->global_types[i].schema) {
+            #ifdef GC_DEBUG_FULL
+            printf("    global_type[%d].schema = %p\n", i, (void*)compiler->global_types[i].schema);
+            fflush(stdout);
+            #endif
+            markObject(vm, (Obj*)compiler->global_types[i].schema);
+        }
+    }
+}
+
 static void markRoots(VM* vm) {
     #ifdef GC_DEBUG_FULL
     printf("Marking %d temporary roots\n", vm->temp_root_count);
@@ -185,6 +293,11 @@ static void markRoots(VM* vm) {
     for (int i = 0; i < vm->globalSlots.count; i++) {
         markValue(vm, vm->globalSlots.values[i]);
     }
+    markTable(vm, &vm->reset_globals);
+    for (int i = 0; i < vm->reset_slots.count; i++) {
+        markValue(vm, vm->reset_slots.values[i]);
+    }
+    markValue(vm, vm->reset_preempt_callback);
 
     for (int i = 0; i < vm->frame_count; i++) {
         markObject(vm, (Obj*)vm->frames[i].closure);
@@ -202,116 +315,42 @@ static void markRoots(VM* vm) {
     }
     markChunk(vm, &vm->api_trampoline);
     markValue(vm, vm->on_preempt_callback);
+    if (vm->reader_type != NULL) {
+        markObject(vm, (Obj*)vm->reader_type);
+    }
+
+    for (int i = 0; i < vm->enum_schema_capacity; i++) {
+        if (vm->enum_schemas[i] != NULL) markObject(vm, (Obj*)vm->enum_schemas[i]);
+    }
+
+    // Error records fall back to the entry file for frames without a module
+    if (vm->entry_file != NULL) {
+        markObject(vm, (Obj*)vm->entry_file);
+    }
+
+    // A held runtime error resolves names and lines lazily
+    for (int i = 0; i < vm->error.frame_count; i++) {
+        if (vm->error.frames[i].function != NULL) markObject(vm, (Obj*)vm->error.frames[i].function);
+        if (vm->error.frames[i].file != NULL) markObject(vm, (Obj*)vm->error.frames[i].file);
+    }
     #ifdef GC_DEBUG_FULL
     printf("Marking compiler roots (compiler=%p)\n", (void*)vm->compiler);
     fflush(stdout);
     #endif
     if (vm->compiler != NULL) {
         for (struct Compiler* compiler = vm->compiler; compiler != NULL; compiler = compiler->enclosing) {
-            #ifdef GC_DEBUG_FULL
-            printf("  Compiler chain: %p (enclosing=%p)\n", (void*)compiler, (void*)compiler->enclosing);
-            fflush(stdout);
-            #endif
-            #ifdef GC_DEBUG_FULL
-            printf("  Marking function being compiled: %p\n", (void*)compiler->function);
-            fflush(stdout);
-            #endif
-            if (compiler->function != NULL) {
-                if (compiler->current_module_name != NULL) {
-                    markObject(vm, (Obj*)compiler->current_module_name);
-                }
-                Obj* fn_obj = (Obj*)compiler->function;
-                if (fn_obj->type < 0 || fn_obj->type > 20) {
-                    printf("  ERROR: compiler->function has invalid type %d, skipping\n", fn_obj->type);
-                    fflush(stdout);
-                } else {
-                    markObject(vm, fn_obj);
-                }
-            }
-
-            #ifdef GC_DEBUG_FULL
-            printf("  Marking %d struct schemas\n", compiler->struct_schema_count);
-            fflush(stdout);
-            #endif
-            for (int i = 0; i < compiler->struct_schema_count; i++) {
-                #ifdef GC_DEBUG_FULL
-                printf("    struct_schema[%d]: schema=%p, field_count=%d, field_names=%p\n",
-                       i, (void*)compiler->struct_schemas[i].schema,
-                       compiler->struct_schemas[i].field_count,
-                       (void*)compiler->struct_schemas[i].field_names);
-                fflush(stdout);
-                #endif
-                if (compiler->struct_schemas[i].schema) {
-                    markObject(vm, (Obj*)compiler->struct_schemas[i].schema);
-                }
-                if (compiler->struct_schemas[i].field_names) {
-                    for (int j = 0; j < compiler->struct_schemas[i].field_count; j++) {
-                        if (compiler->struct_schemas[i].field_names[j]) {
-                            markObject(vm, (Obj*)compiler->struct_schemas[i].field_names[j]);
-                        }
-                    }
-                }
-            }
-
-            for (int i = 0; i < compiler->enum_schema_count; i++) {
-                if (compiler->enum_schemas[i].schema) {
-                    markObject(vm, (Obj*)compiler->enum_schemas[i].schema);
-                }
-                if (compiler->enum_schemas[i].variant_names) {
-                    for (int j = 0; j < compiler->enum_schemas[i].variant_count; j++) {
-                        if (compiler->enum_schemas[i].variant_names[j]) {
-                            markObject(vm, (Obj*)compiler->enum_schemas[i].variant_names[j]);
-                        }
-                    }
-                }
-            }
-
-            #ifdef GC_DEBUG_FULL
-            printf("  Marking %d local struct types\n", compiler->local_count);
-            fflush(stdout);
-            #endif
-            for (int i = 0; i < compiler->local_count; i++) {
-                if (compiler->locals[i].struct_type) {
-                    #ifdef GC_DEBUG_FULL
-                    printf("    local[%d].struct_type = %p\n", i, (void*)compiler->locals[i].struct_type);
-                    fflush(stdout);
-                    #endif
-                    markObject(vm, (Obj*)compiler->locals[i].struct_type);
-                }
-            }
-
-            #ifdef GC_DEBUG_FULL
-            printf("  Marking %d upvalue struct types\n", compiler->upvalue_count);
-            fflush(stdout);
-            #endif
-            for (int i = 0; i < compiler->upvalue_count; i++) {
-                if (compiler->upvalues[i].struct_type) {
-                    #ifdef GC_DEBUG_FULL
-                    printf("    upvalue[%d].struct_type = %p\n", i, (void*)compiler->upvalues[i].struct_type);
-                    fflush(stdout);
-                    #endif
-                    markObject(vm, (Obj*)compiler->upvalues[i].struct_type);
-                }
-            }
-
-            #ifdef GC_DEBUG_FULL
-            printf("  Marking %d global types\n", compiler->global_type_count);
-            fflush(stdout);
-            #endif
-            for (int i = 0; i < compiler->global_type_count; i++) {
-                if (compiler->global_types[i].name) {
-                    markObject(vm, (Obj*)compiler->global_types[i].name);
-                }
-                if (compiler->global_types[i].schema) {
-                    #ifdef GC_DEBUG_FULL
-                    printf("    global_type[%d].schema = %p\n", i, (void*)compiler->global_types[i].schema);
-                    fflush(stdout);
-                    #endif
-                    markObject(vm, (Obj*)compiler->global_types[i].schema);
-                }
-            }
+            markCompilerRoots(vm, compiler);
+        }
+    }
+#ifndef ZYM_RUNTIME_ONLY
+    for (LazyUnit* unit = vm->lazy_units; unit != NULL; unit = unit->next) {
+        if (unit->root == NULL) continue;
+        if (unit->root->current_module_name != NULL) {
+            markObject(vm, (Obj*)unit->root->current_module_name);
         }
+        markCompilerRoots(vm, unit->root);
     }
+#endif
 
     for (int i = 0; i < vm->prompt_count; i++) {
         if (vm->prompt_stack[i].tag != NULL) {
@@ -374,6 +413,9 @@ static void blackenObject(VM* vm, Obj* object) {
             if (function->module_name != NULL) {
                 markObject(vm, (Obj*)function->module_name);
             }
+            if (function->shared_closure != NULL) {
+                markObject(vm, (Obj*)function->shared_closure);
+            }
             markChunk(vm, &function->chunk);
             break;
         }
@@ -537,6 +579,49 @@ static void blackenObject(VM* vm, Obj* object) {
             }
             break;
         }
+
+        case OBJ_USERDATA_TYPE: {
+            ObjUserdataType* type = (ObjUserdataType*)object;
+            markObject(vm, (Obj*)type->name);
+            markTable(vm, &type->methods);
+            break;
+        }
+
+        case OBJ_USERDATA: {
+            ObjUserdata* userdata = (ObjUserdata*)object;
+            markObject(vm, (Obj*)userdata->type);
+            break;
+        }
+
+        case OBJ_VEC:
+            break;
+    }
+}
+
+// Park an unreachable vector on its size's freelist for newVec to reuse.
+// Returns false when that freelist is full and the vector should be freed.
+static bool recycleVec(VM* vm, ObjVec* vec) {
+    int slot = vec->size - VEC_MIN_SIZE;
+    if (vm->vec_free_count[slot] >= VEC_FREELIST_MAX) {
+        return false;
+    }
+    vm->bytes_allocated -= VEC_BYTES(vec->size);
+    vec->obj.next = (Obj*)vm->vec_freelist[slot];
+    vm->vec_freelist[slot] = vec;
+    vm->vec_free_count[slot]++;
+    return true;
+}
+
+void releaseVecFreelists(VM* vm) {
+    for (int slot = 0; slot <= VEC_MAX_SIZE - VEC_MIN_SIZE; slot++) {
+        ObjVec* vec = vm->vec_freelist[slot];
+        while (vec != NULL) {
+            ObjVec* next = (ObjVec*)vec->obj.next;
+            ZYM_FREE(&vm->allocator, vec, VEC_BYTES(vec->size));
+            vec = next;
+        }
+        vm->vec_freelist[slot] = NULL;
+        vm->vec_free_count[slot] = 0;
     }
 }
 
@@ -546,12 +631,30 @@ static void sweep(VM* vm) {
         exit(1);
     }
 
+    // With a garbage handler installed, unreachable objects are finalized here
+    // but their memory is handed to the host in one batch instead of being freed.
+    bool deferred = vm->garbage_handler != NULL;
+    Obj* garbage = NULL;
+
     Obj** object = &vm->objects;
     while (*object != NULL) {
         if (!(*object)->is_marked) {
             Obj* unreached = *object;
             *object = unreached->next;
 
+            // Vectors own no other memory and need no finalizer: recycle them whole
+            if (unreached->type == OBJ_VEC && recycleVec(vm, (ObjVec*)unreached)) {
+                continue;
+            }
+
+            if (deferred) {
+                finalizeObject(vm, unreached);
+                vm->bytes_allocated -= releaseObject(NULL, unreached);
+                unreached->next = garbage;
+                garbage = unreached;
+                continue;
+            }
+
             #ifdef GC_DEBUG_FULL
             printf("%p free type %d (next=%p)", (void*)unreached, unreached->type, (void*)unreached->next);
             if (unreached->type == OBJ_FUNCTION) {
@@ -570,35 +673,49 @@ static void sweep(VM* vm) {
             object = &(*object)->next;
         }
     }
-}
 
-void freeObject(VM* vm, Obj* object) {
-    #ifdef GC_DEBUG_FULL
-    printf("%p free type %d\n", (void*)object, object->type);
-    fflush(stdout);
-    #endif
+    if (garbage != NULL) {
+        GarbageBatch* batch = (GarbageBatch*)ZYM_ALLOC(&vm->allocator, sizeof(GarbageBatch));
+        if (batch == NULL) {
+            // No memory for the hand-off: release the objects synchronously.
+            while (garbage != NULL) {
+                Obj* next = garbage->next;
+                releaseObject(&vm->allocator, garbage);
+                garbage = next;
+            }
+            return;
+        }
+        batch->objects = garbage;
+        batch->allocator = vm->allocator;
+        vm->garbage_handler(batch, vm->garbage_user_data);
+    }
+}
 
+// Runs the parts of destroying an object that must happen on the VM thread:
+// host and native finalizers, and bookkeeping in VM-owned structures.
+static void finalizeObject(VM* vm, Obj* object) {
     switch (object->type) {
         case OBJ_STRING: {
             ObjString* string = (ObjString*)object;
-            FREE_ARRAY(vm, char, string->chars, string->byte_length + 1);
-            FREE(vm, ObjString, object);
+            if (string->is_external) {
+                ObjExternalString* external = (ObjExternalString*)string;
+                vm->live_external_strings--;
+                if (external->finalizer != NULL) {
+                    external->finalizer(external->userdata, string->chars, string->byte_length);
+                }
+            }
             break;
         }
 
         case OBJ_FUNCTION: {
             ObjFunction* function = (ObjFunction*)object;
-            if (function->upvalues != NULL && function->upvalue_capacity > 0) {
-                FREE_ARRAY(vm, Upvalue, function->upvalues, function->upvalue_capacity);
+            freeChunkProfile(vm, &function->chunk);
+#ifndef ZYM_RUNTIME_ONLY
+            if (function->lazy != NULL) {
+                releaseLazyFunction(vm, function->lazy);
+                function->lazy = NULL;
             }
-            freeChunk(vm, &function->chunk);
-            FREE(vm, ObjFunction, object);
-            break;
-        }
-
-        case OBJ_NATIVE_FUNCTION: {
-            ObjNativeFunction* native = (ObjNativeFunction*)object;
-            FREE(vm, ObjNativeFunction, object);
+#endif
             break;
         }
 
@@ -607,101 +724,195 @@ void freeObject(VM* vm, Obj* object) {
             if (context->finalizer) {
                 context->finalizer(vm, context->native_data);
             }
-            FREE(vm, ObjNativeContext, object);
             break;
         }
 
-        case OBJ_NATIVE_CLOSURE: {
-            ObjNativeClosure* closure = (ObjNativeClosure*)object;
-            FREE(vm, ObjNativeClosure, object);
+        case OBJ_USERDATA: {
+            ObjUserdata* userdata = (ObjUserdata*)object;
+            if (userdata->finalizer) {
+                userdata->finalizer(vm, userdata->payload);
+            }
             break;
         }
 
+        default:
+            break;
+    }
+}
+
+// Returns the number of bytes owned by a finalized object. When allocator is
+// non-NULL the memory is also released through it; this half touches nothing
+// but the object itself, so it may run off the VM thread.
+static size_t releaseObject(const ZymAllocator* allocator, Obj* object) {
+    size_t bytes = 0;
+    #define RELEASE(pointer, size) do { \
+        size_t size_ = (size); \
+        if (allocator != NULL && (pointer) != NULL) ZYM_FREE(allocator, (pointer), size_); \
+        bytes += size_; \
+    } while (0)
+
+    switch (object->type) {
+        case OBJ_STRING: {
+            ObjString* string = (ObjString*)object;
+            if (string->format != NULL) {
+                RELEASE(string->format, STRING_FORMAT_SIZE(string->format->segment_count));
+            }
+            if (string->pack_plan != NULL) {
+                RELEASE(string->pack_plan, PACK_PLAN_SIZE(string->pack_plan->step_count));
+            }
+            if (string->is_external) {
+                RELEASE(object, sizeof(ObjExternalString));
+                break;
+            }
+            RELEASE(string->chars, sizeof(char) * (string->byte_length + 1));
+            RELEASE(object, sizeof(ObjString));
+            break;
+        }
+
+        case OBJ_FUNCTION: {
+            ObjFunction* function = (ObjFunction*)object;
+            if (function->upvalues != NULL && function->upvalue_capacity > 0) {
+                RELEASE(function->upvalues, sizeof(Upvalue) * function->upvalue_capacity);
+            }
+            RELEASE(function->chunk.code, sizeof(uint32_t) * function->chunk.capacity);
+            RELEASE(function->chunk.lines, sizeof(int) * function->chunk.capacity);
+            RELEASE(function->chunk.constants.values, sizeof(Value) * function->chunk.constants.capacity);
+            RELEASE(function->chunk.handlers, sizeof(ExceptionHandler) * function->chunk.handler_capacity);
+            RELEASE(object, sizeof(ObjFunction));
+            break;
+        }
+
+        case OBJ_NATIVE_FUNCTION:
+            RELEASE(object, sizeof(ObjNativeFunction));
+            break;
+
+        case OBJ_NATIVE_CONTEXT:
+            RELEASE(object, sizeof(ObjNativeContext));
+            break;
+
+        case OBJ_NATIVE_CLOSURE:
+            RELEASE(object, sizeof(ObjNativeClosure));
+            break;
 
         case OBJ_CLOSURE: {
             ObjClosure* closure = (ObjClosure*)object;
             if (closure->upvalues != NULL && closure->upvalue_count > 0) {
-                FREE_ARRAY(vm, ObjUpvalue*, closure->upvalues, closure->upvalue_count);
+                RELEASE(closure->upvalues, sizeof(ObjUpvalue*) * closure->upvalue_count);
             }
-            FREE(vm, ObjClosure, object);
+            RELEASE(object, sizeof(ObjClosure));
             break;
         }
 
         case OBJ_UPVALUE:
-            FREE(vm, ObjUpvalue, object);
+            RELEASE(object, sizeof(ObjUpvalue));
             break;
 
         case OBJ_LIST: {
             ObjList* list = (ObjList*)object;
             if (list->items.values) {
-                freeValueArray(vm, &list->items);
+                RELEASE(list->items.values, sizeof(Value) * list->items.capacity);
             }
-            FREE(vm, ObjList, object);
+            RELEASE(object, sizeof(ObjList));
             break;
         }
 
         case OBJ_MAP: {
             ObjMap* map = (ObjMap*)object;
-            freeTable(vm, &map->table);
-            FREE(vm, ObjMap, object);
+            RELEASE(map->table.entries, sizeof(Entry) * map->table.capacity);
+            RELEASE(object, sizeof(ObjMap));
             break;
         }
 
-
-        case OBJ_DISPATCHER: {
-            FREE(vm, ObjDispatcher, object);
+        case OBJ_DISPATCHER:
+            RELEASE(object, sizeof(ObjDispatcher));
             break;
-        }
 
         case OBJ_STRUCT_SCHEMA: {
             ObjStructSchema* schema = (ObjStructSchema*)object;
             if (schema->field_names) {
-                FREE_ARRAY(vm, ObjString*, schema->field_names, schema->field_count);
+                RELEASE(schema->field_names, sizeof(ObjString*) * schema->field_count);
             }
-            FREE(vm, ObjStructSchema, object);
+            RELEASE(object, sizeof(ObjStructSchema));
             break;
         }
 
         case OBJ_STRUCT_INSTANCE: {
             ObjStructInstance* instance = (ObjStructInstance*)object;
             // Single allocation: instance + fields are one contiguous block
-            size_t size = sizeof(ObjStructInstance) + sizeof(Value) * instance->field_count;
-            reallocate(vm, object, size, 0);
+            RELEASE(object, sizeof(ObjStructInstance) + sizeof(Value) * instance->field_count);
             break;
         }
 
         case OBJ_ENUM_SCHEMA: {
             ObjEnumSchema* schema = (ObjEnumSchema*)object;
             if (schema->variant_names && schema->variant_count > 0) {
-                FREE_ARRAY(vm, ObjString*, schema->variant_names, schema->variant_count);
+                RELEASE(schema->variant_names, sizeof(ObjString*) * schema->variant_count);
             }
-            FREE(vm, ObjEnumSchema, object);
+            RELEASE(object, sizeof(ObjEnumSchema));
             break;
         }
 
         case OBJ_INT64:
-            FREE(vm, ObjInt64, object);
+            RELEASE(object, sizeof(ObjInt64));
             break;
 
         case OBJ_PROMPT_TAG:
-            FREE(vm, ObjPromptTag, object);
+            RELEASE(object, sizeof(ObjPromptTag));
             break;
 
         case OBJ_CONTINUATION: {
             ObjContinuation* cont = (ObjContinuation*)object;
-
             if (cont->frames != NULL && cont->frame_count > 0) {
-                FREE_ARRAY(vm, CallFrame, cont->frames, cont->frame_count);
+                RELEASE(cont->frames, sizeof(CallFrame) * cont->frame_count);
             }
-
             if (cont->stack != NULL && cont->stack_size > 0) {
-                FREE_ARRAY(vm, Value, cont->stack, cont->stack_size);
+                RELEASE(cont->stack, sizeof(Value) * cont->stack_size);
             }
+            RELEASE(object, sizeof(ObjContinuation));
+            break;
+        }
+
+        case OBJ_USERDATA_TYPE: {
+            ObjUserdataType* type = (ObjUserdataType*)object;
+            RELEASE(type->methods.entries, sizeof(Entry) * type->methods.capacity);
+            RELEASE(object, sizeof(ObjUserdataType));
+            break;
+        }
 
-            FREE(vm, ObjContinuation, object);
+        case OBJ_USERDATA: {
+            ObjUserdata* userdata = (ObjUserdata*)object;
+            RELEASE(object, sizeof(ObjUserdata) + userdata->size);
             break;
         }
+
+        case OBJ_VEC:
+            RELEASE(object, VEC_BYTES(((ObjVec*)object)->size));
+            break;
+    }
+
+    #undef RELEASE
+    return bytes;
+}
+
+void freeObject(VM* vm, Obj* object) {
+    #ifdef GC_DEBUG_FULL
+    printf("%p free type %d\n", (void*)object, object->type);
+    fflush(stdout);
+    #endif
+
+    finalizeObject(vm, object);
+    vm->bytes_allocated -= releaseObject(&vm->allocator, object);
+}
+
+void freeGarbage(GarbageBatch* batch) {
+    Obj* object = batch->objects;
+    while (object != NULL) {
+        Obj* next = object->next;
+        releaseObject(&batch->allocator, object);
+        object = next;
     }
+    ZymAllocator allocator = batch->allocator;
+    ZYM_FREE(&allocator, batch, sizeof(GarbageBatch));
 }
 
 void tableRemoveWhite(Table* table) {
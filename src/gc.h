@@ -15,6 +15,18 @@ void popTempRoot(VM* vm);
 
 void freeObject(VM* vm, Obj* object);
 
+// Unreachable objects handed to VM.garbage_handler, already finalized. The
+// batch owns a copy of the VM's allocator so it can be released on any thread.
+struct GarbageBatch {
+    Obj* objects;
+    ZymAllocator allocator;
+};
+
+void freeGarbage(GarbageBatch* batch);
+
+// Free the vectors parked for reuse by sweep (see newVec).
+void releaseVecFreelists(VM* vm);
+
 #define GC_HEAP_GROW_FACTOR 2
 
 //#define GC_DEBUG
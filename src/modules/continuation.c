@@ -37,6 +37,18 @@ PromptEntry* findPrompt(VM* vm, ObjPromptTag* tag) {
     return NULL;
 }
 
+// Slot that receives a frame's value when it returns, as RET picks it: the
+// result slot of a resume entered at that depth, else the callee slot the
+// frame was pushed at. -1 for frames no call instruction entered (host API
+// calls and preemption callbacks).
+static int frameResultSlot(VM* vm, int depth, const CallFrame* frame) {
+    if (frame->caller_chunk == &vm->api_trampoline || (frame->flags & FRAME_FLAG_PREEMPT)) return -1;
+    for (int i = vm->resume_depth - 1; i >= 0 && vm->resume_stack[i].frame_boundary >= depth; i--) {
+        if (vm->resume_stack[i].frame_boundary == depth) return vm->resume_stack[i].result_slot;
+    }
+    return frame->stack_base;
+}
+
 ObjContinuation* captureContinuation(VM* vm, ObjPromptTag* tag, int return_slot) {
     PromptEntry* prompt = findPrompt(vm, tag);
     if (prompt == NULL) {
@@ -175,6 +187,7 @@ bool resumeContinuation(VM* vm, ObjContinuation* cont, Value resume_value) {
         dst->ip = src->ip;
         dst->caller_chunk = src->caller_chunk;
         dst->flags = src->flags;
+        dst->result_count = src->result_count;
 
         int original_offset = src->stack_base - cont->stack_base_offset;
         dst->stack_base = restore_base + original_offset;
@@ -292,23 +305,7 @@ static ZymValue cont_withPrompt(ZymVM* vm, ZymValue context, ZymValue tag, ZymVa
         return ZYM_ERROR;
     }
 
-    int callee_slot = -1;
-    if (vm->chunk != NULL && vm->ip > vm->chunk->code) {
-        uint32_t prev_instr = *(vm->ip - 1);
-        int opcode = prev_instr & 0xFF;
-
-        if (opcode == CALL || opcode == CALL_SELF || opcode == TAIL_CALL ||
-            opcode == TAIL_CALL_SELF) {
-            int result_reg = (prev_instr >> 8) & 0xFF;
-            int frame_base = (vm->frame_count > 0) ? vm->frames[vm->frame_count - 1].stack_base : 0;
-            callee_slot = frame_base + result_reg;
-        }
-    }
-
-    if (callee_slot < 0) {
-        zym_runtimeError(vm, "Cont.withPrompt: could not determine call context.");
-        return ZYM_ERROR;
-    }
+    int callee_slot = vm->native_call_slot;
 
     if (vm->frame_count >= FRAMES_MAX) {
         zym_runtimeError(vm, "Cont.withPrompt: stack overflow (max call depth reached).");
@@ -320,6 +317,10 @@ static ZymValue cont_withPrompt(ZymVM* vm, ZymValue context, ZymValue tag, ZymVa
         return ZYM_ERROR;
     }
 
+    if (!ensureFunctionCompiled(vm, function)) {
+        return ZYM_ERROR;
+    }
+
     int needed_top = callee_slot + function->max_regs;
     if (needed_top > STACK_MAX) {
         zym_runtimeError(vm, "Cont.withPrompt: stack overflow.");
@@ -358,6 +359,7 @@ static ZymValue cont_withPrompt(ZymVM* vm, ZymValue context, ZymValue tag, ZymVa
     frame->stack_base = callee_slot;
     frame->caller_chunk = vm->chunk;
     frame->flags = 0;
+    frame->result_count = 0;
 
     vm->current_frame = frame;
     vm->cur_base = callee_slot;
@@ -387,27 +389,13 @@ static ZymValue cont_capture(ZymVM* vm, ZymValue context, ZymValue tag_val) {
         return ZYM_ERROR;
     }
 
-    int return_slot = 0;
-
-    if (vm->chunk != NULL && vm->ip > vm->chunk->code) {
-        uint32_t prev_instr = *(vm->ip - 1);
-        int opcode = prev_instr & 0xFF;
-
-        if (opcode == CALL || opcode == CALL_SELF || opcode == TAIL_CALL ||
-            opcode == TAIL_CALL_SELF) {
-            int result_reg = (prev_instr >> 8) & 0xFF;
-            int frame_base = (vm->frame_count > 0) ? vm->frames[vm->frame_count - 1].stack_base : 0;
-            int absolute_slot = frame_base + result_reg;
-
-            return_slot = absolute_slot - prompt->stack_base;
-        }
-    }
-
+    int return_slot = vm->native_call_slot - prompt->stack_base;
     ObjContinuation* cont = captureContinuation(vm, tag, return_slot);
     if (cont == NULL) {
         return ZYM_ERROR;
     }
 
+    int result_slot = vm->native_call_slot;
     unwindFrames(vm, prompt->frame_index);
     vm->stack_top = prompt->stack_base;
 
@@ -415,6 +403,7 @@ static ZymValue cont_capture(ZymVM* vm, ZymValue context, ZymValue tag_val) {
         CallFrame* captured_frame = &cont->frames[0];
         vm->ip = captured_frame->ip;
         vm->chunk = captured_frame->caller_chunk;
+        result_slot = frameResultSlot(vm, vm->frame_count, captured_frame);
 
         if (vm->chunk == NULL && vm->frame_count > 0) {
             vm->chunk = &vm->frames[vm->frame_count - 1].closure->function->chunk;
@@ -423,6 +412,7 @@ static ZymValue cont_capture(ZymVM* vm, ZymValue context, ZymValue tag_val) {
         CallFrame* frame = &vm->frames[vm->frame_count - 1];
         vm->ip = frame->ip;
         vm->chunk = frame->caller_chunk ? frame->caller_chunk : &frame->closure->function->chunk;
+        result_slot = frameResultSlot(vm, vm->frame_count - 1, frame);
     }
 
     popPrompt(vm);
@@ -434,21 +424,8 @@ static ZymValue cont_capture(ZymVM* vm, ZymValue context, ZymValue tag_val) {
         vm->stack[ctx->result_slot] = OBJ_VAL(cont);
     }
 
-    if (vm->chunk != NULL && vm->ip > vm->chunk->code) {
-        uint32_t prev_instr = *(vm->ip - 1);
-        int opcode = prev_instr & 0xFF;
-
-        if (opcode == CALL || opcode == CALL_SELF || opcode == TAIL_CALL ||
-            opcode == TAIL_CALL_SELF) {
-            int result_reg = (prev_instr >> 8) & 0xFF;
-            int frame_base = (vm->frame_count > 0) ? vm->frames[vm->frame_count - 1].stack_base : 0;
-            int result_slot = frame_base + result_reg;
-
-            vm->stack[result_slot] = OBJ_VAL(cont);
-        } else {
-            vm->stack[vm->stack_top] = OBJ_VAL(cont);
-            vm->stack_top++;
-        }
+    if (result_slot >= 0) {
+        vm->stack[result_slot] = OBJ_VAL(cont);
     } else {
         vm->stack[vm->stack_top] = OBJ_VAL(cont);
         vm->stack_top++;
@@ -472,24 +449,7 @@ static ZymValue cont_resume(ZymVM* vm, ZymValue context, ZymValue continuation,
         return ZYM_ERROR;
     }
 
-    int resume_result_slot = -1;
-    if (vm->chunk != NULL && vm->ip > vm->chunk->code) {
-        uint32_t prev_instr = *(vm->ip - 1);
-        int opcode = prev_instr & 0xFF;
-
-        if (opcode == CALL || opcode == CALL_SELF || opcode == TAIL_CALL ||
-            opcode == TAIL_CALL_SELF) {
-            int result_reg = (prev_instr >> 8) & 0xFF;
-            int frame_base = (vm->frame_count > 0) ? vm->frames[vm->frame_count - 1].stack_base : 0;
-            resume_result_slot = frame_base + result_reg;
-        }
-    }
-
-    if (resume_result_slot < 0) {
-        zym_runtimeError(vm, "Cont.resume must be called in a value position (as part of a call expression).");
-        return ZYM_ERROR;
-    }
-
+    int resume_result_slot = vm->native_call_slot;
     uint32_t* resume_return_ip = vm->ip;
     Chunk* resume_return_chunk = vm->chunk;
     int frames_before = vm->frame_count;
@@ -533,10 +493,12 @@ static ZymValue cont_abort(ZymVM* vm, ZymValue context, ZymValue tag_val, ZymVal
 
     uint32_t* saved_ip = NULL;
     Chunk* saved_chunk = NULL;
+    int result_slot = vm->native_call_slot;
     if (vm->frame_count > prompt->frame_index) {
         CallFrame* first_unwound_frame = &vm->frames[prompt->frame_index];
         saved_ip = first_unwound_frame->ip;
         saved_chunk = first_unwound_frame->caller_chunk;
+        result_slot = frameResultSlot(vm, prompt->frame_index, first_unwound_frame);
     }
 
     unwindFrames(vm, prompt->frame_index);
@@ -553,6 +515,7 @@ static ZymValue cont_abort(ZymVM* vm, ZymValue context, ZymValue tag_val, ZymVal
         CallFrame* frame = &vm->frames[vm->frame_count - 1];
         vm->ip = frame->ip;
         vm->chunk = frame->caller_chunk ? frame->caller_chunk : &frame->closure->function->chunk;
+        result_slot = frameResultSlot(vm, vm->frame_count - 1, frame);
     }
 
     popPrompt(vm);
@@ -564,21 +527,8 @@ static ZymValue cont_abort(ZymVM* vm, ZymValue context, ZymValue tag_val, ZymVal
         vm->stack[ctx->result_slot] = abort_value;
     }
 
-    if (vm->chunk != NULL && vm->ip > vm->chunk->code) {
-        uint32_t prev_instr = *(vm->ip - 1);
-        int opcode = prev_instr & 0xFF;
-
-        if (opcode == CALL || opcode == CALL_SELF || opcode == TAIL_CALL ||
-            opcode == TAIL_CALL_SELF) {
-            int result_reg = (prev_instr >> 8) & 0xFF;
-            int frame_base = (vm->frame_count > 0) ? vm->frames[vm->frame_count - 1].stack_base : 0;
-            int result_slot = frame_base + result_reg;
-
-            vm->stack[result_slot] = abort_value;
-        } else {
-            vm->stack[vm->stack_top] = abort_value;
-            vm->stack_top++;
-        }
+    if (result_slot >= 0) {
+        vm->stack[result_slot] = abort_value;
     } else {
         vm->stack[vm->stack_top] = abort_value;
         vm->stack_top++;
@@ -608,6 +558,10 @@ static ZymValue cont_shift(ZymVM* vm, ZymValue context, ZymValue tag_val, ZymVal
         return ZYM_ERROR;
     }
 
+    if (!ensureFunctionCompiled(vm, handler_fn)) {
+        return ZYM_ERROR;
+    }
+
     ObjPromptTag* tag = AS_PROMPT_TAG(tag_val);
 
     PromptEntry* prompt = findPrompt(vm, tag);
@@ -616,21 +570,7 @@ static ZymValue cont_shift(ZymVM* vm, ZymValue context, ZymValue tag_val, ZymVal
         return ZYM_ERROR;
     }
 
-    int return_slot = 0;
-    if (vm->chunk != NULL && vm->ip > vm->chunk->code) {
-        uint32_t prev_instr = *(vm->ip - 1);
-        int opcode = prev_instr & 0xFF;
-
-        if (opcode == CALL || opcode == CALL_SELF || opcode == TAIL_CALL ||
-            opcode == TAIL_CALL_SELF) {
-            int result_reg = (prev_instr >> 8) & 0xFF;
-            int frame_base = (vm->frame_count > 0) ? vm->frames[vm->frame_count - 1].stack_base : 0;
-            int absolute_slot = frame_base + result_reg;
-
-            return_slot = absolute_slot - prompt->stack_base;
-        }
-    }
-
+    int return_slot = vm->native_call_slot - prompt->stack_base;
     ObjContinuation* cont = captureContinuation(vm, tag, return_slot);
     if (cont == NULL) {
         return ZYM_ERROR;
@@ -639,6 +579,7 @@ static ZymValue cont_shift(ZymVM* vm, ZymValue context, ZymValue tag_val, ZymVal
     pushTempRoot(vm, (Obj*)cont);
     pushTempRoot(vm, (Obj*)handler_closure);
 
+    int callee_slot = vm->native_call_slot;
     unwindFrames(vm, prompt->frame_index);
     vm->stack_top = prompt->stack_base;
 
@@ -646,6 +587,7 @@ static ZymValue cont_shift(ZymVM* vm, ZymValue context, ZymValue tag_val, ZymVal
         CallFrame* captured_frame = &cont->frames[0];
         vm->ip = captured_frame->ip;
         vm->chunk = captured_frame->caller_chunk;
+        callee_slot = frameResultSlot(vm, vm->frame_count, captured_frame);
 
         if (vm->chunk == NULL && vm->frame_count > 0) {
             vm->chunk = &vm->frames[vm->frame_count - 1].closure->function->chunk;
@@ -654,23 +596,11 @@ static ZymValue cont_shift(ZymVM* vm, ZymValue context, ZymValue tag_val, ZymVal
         CallFrame* frame = &vm->frames[vm->frame_count - 1];
         vm->ip = frame->ip;
         vm->chunk = frame->caller_chunk ? frame->caller_chunk : &frame->closure->function->chunk;
+        callee_slot = frameResultSlot(vm, vm->frame_count - 1, frame);
     }
 
     popPrompt(vm);
 
-    int callee_slot = -1;
-    if (vm->chunk != NULL && vm->ip > vm->chunk->code) {
-        uint32_t prev_instr = *(vm->ip - 1);
-        int opcode = prev_instr & 0xFF;
-
-        if (opcode == CALL || opcode == CALL_SELF || opcode == TAIL_CALL ||
-            opcode == TAIL_CALL_SELF) {
-            int result_reg = (prev_instr >> 8) & 0xFF;
-            int frame_base = (vm->frame_count > 0) ? vm->frames[vm->frame_count - 1].stack_base : 0;
-            callee_slot = frame_base + result_reg;
-        }
-    }
-
     if (callee_slot < 0) {
         popTempRoot(vm);  // handler_closure
         popTempRoot(vm);  // cont
@@ -721,6 +651,7 @@ static ZymValue cont_shift(ZymVM* vm, ZymValue context, ZymValue tag_val, ZymVal
     frame->stack_base = callee_slot;
     frame->caller_chunk = vm->chunk;
     frame->flags = 0;
+    frame->result_count = 0;
 
     vm->current_frame = frame;
     vm->chunk = &handler_fn->chunk;
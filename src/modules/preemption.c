@@ -14,7 +14,8 @@
 
 void preemptionEnable(VM* vm) {
     vm->preemption_enabled = true;
-    vm->preempt_counter = vm->default_timeslice;
+    vm->preempt_counter = preemptionBudget(vm);
+    preemptionRearmPending(vm);
 }
 
 void preemptionDisable(VM* vm) {
@@ -35,6 +36,7 @@ void preemptionPopDisable(VM* vm) {
         vm->preemption_disable_depth--;
         if (vm->preemption_disable_depth == 0 && vm->preemption_enabled) {
             vm->preempt_counter = vm->saved_budget;
+            preemptionRearmPending(vm);
         }
     }
 }
@@ -44,8 +46,9 @@ bool preemptionIsEnabled(VM* vm) {
 }
 
 void preemptionSetTimeslice(VM* vm, int instructions) {
-    if (instructions < 1) {
-        instructions = 1;
+    // 0 selects deadline mode (see preemptionBudget)
+    if (instructions < 0) {
+        instructions = 0;
     }
     vm->default_timeslice = instructions;
 }
@@ -60,8 +63,9 @@ void preemptionRequest(VM* vm) {
 }
 
 void preemptionReset(VM* vm) {
-    vm->preempt_counter = vm->preemption_enabled ? vm->default_timeslice : INT32_MAX;
+    vm->preempt_counter = vm->preemption_enabled ? preemptionBudget(vm) : INT32_MAX;
     vm->preempt_requested = false;
+    atomic_store_explicit(&vm->preempt_signal, false, memory_order_relaxed);
 }
 
 int preemptionRemaining(VM* vm) {
@@ -132,26 +136,14 @@ static ZymValue preempt_withDisabled(ZymVM* vm, ZymValue context, ZymValue fn) {
         return ZYM_ERROR;
     }
 
-    int callee_slot = -1;
-    if (vm->chunk != NULL && vm->ip > vm->chunk->code) {
-        uint32_t prev_instr = *(vm->ip - 1);
-        int opcode = prev_instr & 0xFF;
+    int callee_slot = vm->native_call_slot;
 
-        if (opcode == CALL || opcode == CALL_SELF || opcode == TAIL_CALL ||
-            opcode == TAIL_CALL_SELF) {
-            int result_reg = (prev_instr >> 8) & 0xFF;
-            int frame_base = (vm->frame_count > 0) ? vm->frames[vm->frame_count - 1].stack_base : 0;
-            callee_slot = frame_base + result_reg;
-        }
-    }
-
-    if (callee_slot < 0) {
-        zym_runtimeError(vm, "Preempt.withDisabled: could not determine call context.");
+    if (vm->frame_count >= FRAMES_MAX) {
+        zym_runtimeError(vm, "Preempt.withDisabled: stack overflow (max call depth reached).");
         return ZYM_ERROR;
     }
 
-    if (vm->frame_count >= FRAMES_MAX) {
-        zym_runtimeError(vm, "Preempt.withDisabled: stack overflow (max call depth reached).");
+    if (!ensureFunctionCompiled(vm, function)) {
         return ZYM_ERROR;
     }
 
@@ -186,6 +178,7 @@ static ZymValue preempt_withDisabled(ZymVM* vm, ZymValue context, ZymValue fn) {
     frame->stack_base = callee_slot;
     frame->caller_chunk = vm->chunk;
     frame->flags = FRAME_FLAG_DISABLE_PREEMPT;
+    frame->result_count = 0;
 
     vm->current_frame = frame;
     vm->cur_base = callee_slot;
@@ -3,7 +3,10 @@
 #include <string.h>
 #include <ctype.h>
 #include "conversions.h"
+#include "../object.h"
 #include "../memory.h"
+#include "../gc.h"
+#include "../vm.h"
 
 // =============================================================================
 // CONVERSION FUNCTIONS
@@ -47,41 +50,78 @@ ZymValue nativeConversions_num(ZymVM* vm, ZymValue value) {
     return zym_newNumber(result);
 }
 
-// Helper to ensure buffer has space
-static bool ensureBufferSpace(ZymAllocator* alloc, char** buffer, size_t* buffer_size, size_t* current_pos, size_t needed) {
-    while (*current_pos + needed >= *buffer_size) {
-        size_t old = *buffer_size;
-        *buffer_size *= 2;
-        *buffer = ZYM_REALLOC(alloc, *buffer, old, *buffer_size);
-        if (*buffer == NULL) {
-            return false;
+// Compile a format string into literal/specifier segments. Escaped "%%"
+// becomes a literal segment covering the first '%' only.
+static StringFormat* compileFormat(VM* vm, ObjString* format) {
+    const char* chars = format->chars;
+    int length = format->byte_length;
+
+    int max_segments = 0;
+    for (int i = 0; i < length; i++) {
+        if (chars[i] == '%') max_segments += 2;
+    }
+    max_segments++;
+
+    StringFormat* compiled = (StringFormat*)reallocate(vm, NULL, 0, STRING_FORMAT_SIZE(max_segments));
+    int count = 0;
+    int literal_bytes = 0;
+    int literal_start = 0;
+    int i = 0;
+
+    while (i < length) {
+        if (chars[i] != '%') {
+            i++;
+            continue;
+        }
+
+        bool escaped = i + 1 < length && chars[i + 1] == '%';
+        int literal_end = escaped ? i + 1 : i;
+        if (literal_end > literal_start) {
+            compiled->segments[count++] = (FormatSegment){literal_start, literal_end - literal_start, 0};
+            literal_bytes += literal_end - literal_start;
         }
+
+        if (escaped) {
+            i += 2;
+        } else if (i + 1 >= length) {
+            compiled->segments[count++] = (FormatSegment){i, 0, '%'};
+            i++;
+        } else {
+            compiled->segments[count++] = (FormatSegment){i, 0, chars[i + 1]};
+            i += 2;
+        }
+        literal_start = i;
     }
-    return true;
-}
 
-// Helper to append string to buffer
-static bool appendToBuffer(ZymAllocator* alloc, char** buffer, size_t* buffer_size, size_t* current_pos, const char* str, size_t len) {
-    if (!ensureBufferSpace(alloc, buffer, buffer_size, current_pos, len)) {
-        return false;
+    if (length > literal_start) {
+        compiled->segments[count++] = (FormatSegment){literal_start, length - literal_start, 0};
+        literal_bytes += length - literal_start;
     }
-    memcpy(*buffer + *current_pos, str, len);
-    *current_pos += len;
-    return true;
+
+    // Shrink to the exact segment count so freeObject can size the block
+    compiled = (StringFormat*)reallocate(vm, compiled, STRING_FORMAT_SIZE(max_segments), STRING_FORMAT_SIZE(count));
+    compiled->segment_count = count;
+    compiled->literal_bytes = literal_bytes;
+    return compiled;
 }
 
-// Helper to append formatted value to buffer using zym_valueToString
-static bool appendFormattedValue(ZymVM* vm, ZymAllocator* alloc, char** buffer, size_t* buffer_size, size_t* current_pos,
-                                  char format, ZymValue val, int argIndex) {
-    char temp[256];
+typedef struct {
+    const char* chars;
+    int length;
+    char number[32];
+} FormatPiece;
 
-    switch (format) {
+// Resolve one specifier to the bytes it contributes to the output
+static bool formatPiece(ZymVM* vm, char spec, ZymValue val, int argIndex, FormatPiece* piece) {
+    switch (spec) {
         case 's': // String
             if (!zym_isString(val)) {
                 zym_runtimeError(vm, "str() format %%s at position %d expects string, got %s", argIndex, zym_typeName(val));
                 return false;
             }
-            return appendToBuffer(alloc, buffer, buffer_size, current_pos, zym_asCString(val), strlen(zym_asCString(val)));
+            piece->chars = AS_CSTRING(val);
+            piece->length = AS_STRING(val)->byte_length;
+            return true;
 
         case 'n': // Number
             if (!zym_isNumber(val)) {
@@ -90,13 +130,13 @@ static bool appendFormattedValue(ZymVM* vm, ZymAllocator* alloc, char** buffer,
             }
             {
                 double num = zym_asNumber(val);
-                int len;
                 if (num == (long long)num && num >= -1e15 && num <= 1e15) {
-                    len = snprintf(temp, sizeof(temp), "%.0f", num);
+                    piece->length = snprintf(piece->number, sizeof(piece->number), "%.0f", num);
                 } else {
-                    len = snprintf(temp, sizeof(temp), "%g", num);
+                    piece->length = snprintf(piece->number, sizeof(piece->number), "%g", num);
                 }
-                return appendToBuffer(alloc, buffer, buffer_size, current_pos, temp, len);
+                piece->chars = piece->number;
+                return true;
             }
 
         case 'b': // Boolean
@@ -104,95 +144,99 @@ static bool appendFormattedValue(ZymVM* vm, ZymAllocator* alloc, char** buffer,
                 zym_runtimeError(vm, "str() format %%b at position %d expects bool, got %s", argIndex, zym_typeName(val));
                 return false;
             }
-            {
-                const char* str = zym_asBool(val) ? "true" : "false";
-                return appendToBuffer(alloc, buffer, buffer_size, current_pos, str, strlen(str));
-            }
+            piece->chars = zym_asBool(val) ? "true" : "false";
+            piece->length = zym_asBool(val) ? 4 : 5;
+            return true;
 
         case 'v': // Any value
             {
                 ZymValue str_val = zym_valueToString(vm, val);
                 if (str_val == ZYM_ERROR) return false;
-                const char* str = zym_asCString(str_val);
-                return appendToBuffer(alloc, buffer, buffer_size, current_pos, str, strlen(str));
+                // Keep the converted string alive until the result is assembled
+                pushTempRoot(vm, AS_OBJ(str_val));
+                piece->chars = AS_CSTRING(str_val);
+                piece->length = AS_STRING(str_val)->byte_length;
+                return true;
             }
 
         default:
-            zym_runtimeError(vm, "str() unknown format specifier '%%%c'", format);
+            zym_runtimeError(vm, "str() unknown format specifier '%%%c'", spec);
             return false;
     }
 }
 
-// Core str implementation that processes format string and arguments
-static ZymValue str_impl(ZymVM* vm, const char* format_str, ZymValue* args, int arg_count) {
-    ZymAllocator* alloc = (ZymAllocator*)zym_getAllocator(vm);
-    size_t buffer_size = 256;
-    char* buffer = ZYM_ALLOC(alloc, buffer_size);
-    if (buffer == NULL) {
-        zym_runtimeError(vm, "str() out of memory");
-        return ZYM_ERROR;
-    }
+#define FORMAT_STACK_PIECES 16
 
-    size_t current_pos = 0;
-    const char* ptr = format_str;
-    int arg_index = 0;
+// Core str implementation: resolves each specifier of the cached compiled
+// format, then copies all segments into one exactly-sized buffer
+static ZymValue str_impl(ZymVM* vm, ObjString* format, ZymValue* args, int arg_count) {
+    if (format->format == NULL) {
+        format->format = compileFormat(vm, format);
+    }
+    StringFormat* compiled = format->format;
 
-    while (*ptr) {
-        if (*ptr == '%') {
-            ptr++;
-            if (*ptr == '\0') {
-                ZYM_FREE(alloc, buffer, buffer_size);
-                zym_runtimeError(vm, "str() format string ends with incomplete format specifier");
-                return ZYM_ERROR;
-            }
+    FormatPiece stack_pieces[FORMAT_STACK_PIECES];
+    FormatPiece* pieces = stack_pieces;
+    if (arg_count > FORMAT_STACK_PIECES) {
+        pieces = ALLOCATE(vm, FormatPiece, arg_count);
+    }
 
-            if (*ptr == '%') {
-                // Escaped % - append literal %
-                if (!ensureBufferSpace(alloc, &buffer, &buffer_size, &current_pos, 1)) {
-                    zym_runtimeError(vm, "str() out of memory");
-                    return ZYM_ERROR;
-                }
-                buffer[current_pos++] = '%';
-                ptr++;
-            } else {
-                // Format specifier
-                if (arg_index >= arg_count) {
-                    ZYM_FREE(alloc, buffer, buffer_size);
-                    zym_runtimeError(vm, "str() format string requires more arguments than provided");
-                    return ZYM_ERROR;
-                }
+    int temp_roots = vm->temp_root_count;
+    int arg_index = 0;
+    size_t total = (size_t)compiled->literal_bytes;
+    bool ok = true;
 
-                if (!appendFormattedValue(vm, alloc, &buffer, &buffer_size, &current_pos, *ptr, args[arg_index], arg_index + 1)) {
-                    ZYM_FREE(alloc, buffer, buffer_size);
-                    return ZYM_ERROR;
-                }
+    for (int i = 0; i < compiled->segment_count; i++) {
+        char spec = compiled->segments[i].spec;
+        if (spec == 0) continue;
 
-                arg_index++;
-                ptr++;
-            }
-        } else {
-            // Regular character
-            if (!ensureBufferSpace(alloc, &buffer, &buffer_size, &current_pos, 1)) {
-                zym_runtimeError(vm, "str() out of memory");
-                return ZYM_ERROR;
-            }
-            buffer[current_pos++] = *ptr;
-            ptr++;
+        if (spec == '%') {
+            zym_runtimeError(vm, "str() format string ends with incomplete format specifier");
+            ok = false;
+            break;
         }
+        if (arg_index >= arg_count) {
+            zym_runtimeError(vm, "str() format string requires more arguments than provided");
+            ok = false;
+            break;
+        }
+        if (!formatPiece(vm, spec, args[arg_index], arg_index + 1, &pieces[arg_index])) {
+            ok = false;
+            break;
+        }
+        total += (size_t)pieces[arg_index].length;
+        arg_index++;
     }
 
-    // Check if we have unused arguments
-    if (arg_index < arg_count) {
-        ZYM_FREE(alloc, buffer, buffer_size);
+    if (ok && arg_index < arg_count) {
         zym_runtimeError(vm, "str() provided %d arguments but format string only uses %d", arg_count, arg_index);
-        return ZYM_ERROR;
+        ok = false;
     }
 
-    // Null-terminate and create string
-    buffer[current_pos] = '\0';
-    ZymValue result = zym_newString(vm, buffer);
-    ZYM_FREE(alloc, buffer, buffer_size);
+    ZymValue result = ZYM_ERROR;
+    if (ok) {
+        char* buffer = ALLOCATE(vm, char, total + 1);
+        char* out = buffer;
+        int piece = 0;
+        for (int i = 0; i < compiled->segment_count; i++) {
+            FormatSegment* segment = &compiled->segments[i];
+            if (segment->spec == 0) {
+                memcpy(out, format->chars + segment->start, segment->length);
+                out += segment->length;
+            } else {
+                memcpy(out, pieces[piece].chars, pieces[piece].length);
+                out += pieces[piece].length;
+                piece++;
+            }
+        }
+        *out = '\0';
+        result = OBJ_VAL(takeString(vm, buffer, (int)total));
+    }
 
+    vm->temp_root_count = temp_roots;
+    if (pieces != stack_pieces) {
+        FREE_ARRAY(vm, FormatPiece, pieces, arg_count);
+    }
     return result;
 }
 
@@ -217,7 +261,7 @@ ZymValue nativeConversions_str(ZymVM* vm, ZymValue value) {
         }
 
         // Has format specifiers but no args - treat as format string with no arguments
-        return str_impl(vm, format_str, NULL, 0);
+        return str_impl(vm, AS_STRING(value), NULL, 0);
     }
 
     // Single non-string value - convert to string using zym_valueToString
@@ -236,7 +280,7 @@ ZymValue nativeConversions_str_variadic(ZymVM* vm, ZymValue format, ZymValue* va
         return ZYM_ERROR;
     }
 
-    return str_impl(vm, zym_asCString(format), vargs, vargc);
+    return str_impl(vm, AS_STRING(format), vargs, vargc);
 }
 
 // =============================================================================
@@ -1,13 +1,18 @@
 #include "core_natives.h"
 #include "gc_native.h"
 #include "conversions.h"
+#include "csv.h"
 #include "error.h"
+#include "hash.h"
 #include "list.h"
 #include "map.h"
+#include "pack.h"
+#include "reader.h"
 #include "shared.h"
 #include "string_natives.h"
 #include "math.h"
 #include "typeof.h"
+#include "vec.h"
 
 // ============================================================================
 // Core Natives Registration
@@ -22,5 +27,10 @@ void setupCoreNatives(VM* vm) {
     registerMapNatives(vm);
     registerStringNatives(vm);
     registerMathNatives(vm);
+    registerHashNatives(vm);
+    registerPackNatives(vm);
+    registerReaderType(vm);
+    registerCsvNatives(vm);
     registerTypeofNative(vm);
+    registerVecNatives(vm);
 }
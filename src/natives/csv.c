@@ -0,0 +1,540 @@
+#include <string.h>
+#include <stdlib.h>
+#include "csv.h"
+#include "reader.h"
+#include "../object.h"
+#include "../memory.h"
+#include "../gc.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define ZYM_CSV_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define ZYM_CSV_NEON 1
+#endif
+
+// =============================================================================
+// SCANNING
+// =============================================================================
+
+// First byte in [p, end) that is delim, '\n' or '\r', or end. Unquoted cells
+// are skipped 16 bytes at a time where the target has SIMD compares.
+static const char* findSpecial(const char* p, const char* end, char delim) {
+#if defined(ZYM_CSV_SSE2)
+    const __m128i vdelim = _mm_set1_epi8(delim);
+    const __m128i vlf = _mm_set1_epi8('\n');
+    const __m128i vcr = _mm_set1_epi8('\r');
+    while (end - p >= 16) {
+        __m128i chunk = _mm_loadu_si128((const __m128i*)p);
+        __m128i hits = _mm_or_si128(_mm_cmpeq_epi8(chunk, vdelim),
+                                    _mm_or_si128(_mm_cmpeq_epi8(chunk, vlf), _mm_cmpeq_epi8(chunk, vcr)));
+        int mask = _mm_movemask_epi8(hits);
+        if (mask != 0) return p + __builtin_ctz((unsigned)mask);
+        p += 16;
+    }
+#elif defined(ZYM_CSV_NEON)
+    const uint8x16_t vdelim = vdupq_n_u8((uint8_t)delim);
+    const uint8x16_t vlf = vdupq_n_u8('\n');
+    const uint8x16_t vcr = vdupq_n_u8('\r');
+    while (end - p >= 16) {
+        uint8x16_t chunk = vld1q_u8((const uint8_t*)p);
+        uint8x16_t hits = vorrq_u8(vceqq_u8(chunk, vdelim),
+                                   vorrq_u8(vceqq_u8(chunk, vlf), vceqq_u8(chunk, vcr)));
+        if (vmaxvq_u8(hits) != 0) break;  // the scalar loop pins down the lane
+        p += 16;
+    }
+#endif
+    while (p < end && *p != delim && *p != '\n' && *p != '\r') p++;
+    return p;
+}
+
+typedef struct {
+    const char* start;
+    int length;
+    bool quoted;
+    bool escaped;   // holds "" pairs that collapse to one quote
+} CsvCell;
+
+typedef struct {
+    CsvCell* cells;
+    int cell_count;
+    int cell_capacity;
+    int* row_ends;  // one past each record's last cell
+    int row_count;
+    int row_capacity;
+} CsvTable;
+
+static void freeCsvTable(ZymVM* vm, CsvTable* table) {
+    FREE_ARRAY(vm, CsvCell, table->cells, table->cell_capacity);
+    FREE_ARRAY(vm, int, table->row_ends, table->row_capacity);
+}
+
+static void addCell(ZymVM* vm, CsvTable* table, CsvCell cell) {
+    if (table->cell_count == table->cell_capacity) {
+        int old_capacity = table->cell_capacity;
+        table->cell_capacity = GROW_CAPACITY(old_capacity);
+        table->cells = GROW_ARRAY(vm, CsvCell, table->cells, old_capacity, table->cell_capacity);
+    }
+    table->cells[table->cell_count++] = cell;
+}
+
+static void endRow(ZymVM* vm, CsvTable* table) {
+    if (table->row_count == table->row_capacity) {
+        int old_capacity = table->row_capacity;
+        table->row_capacity = GROW_CAPACITY(old_capacity);
+        table->row_ends = GROW_ARRAY(vm, int, table->row_ends, old_capacity, table->row_capacity);
+    }
+    table->row_ends[table->row_count++] = table->cell_count;
+}
+
+// Parse one record starting at p and return the position after its line
+// terminator. Blank lines add no record.
+static const char* parseRecord(ZymVM* vm, CsvTable* table, const char* p, const char* end, char delim) {
+    int first_cell = table->cell_count;
+
+    for (;;) {
+        CsvCell cell = {p, 0, false, false};
+        if (p < end && *p == '"') {
+            cell.quoted = true;
+            cell.start = ++p;
+            for (;;) {
+                const char* quote = memchr(p, '"', (size_t)(end - p));
+                if (quote == NULL) {
+                    p = end;  // Unterminated quote runs to the end of input
+                    break;
+                }
+                if (quote + 1 < end && quote[1] == '"') {
+                    cell.escaped = true;
+                    p = quote + 2;
+                    continue;
+                }
+                p = quote;
+                break;
+            }
+            cell.length = (int)(p - cell.start);
+            if (p < end) p++;
+            // Bytes between a closing quote and the next delimiter are dropped
+            p = findSpecial(p, end, delim);
+        } else {
+            p = findSpecial(p, end, delim);
+            cell.length = (int)(p - cell.start);
+        }
+        addCell(vm, table, cell);
+
+        if (p < end && *p == delim) {
+            p++;
+            continue;
+        }
+        if (p < end && *p == '\r') p++;
+        if (p < end && *p == '\n') p++;
+        break;
+    }
+
+    bool blank = table->cell_count == first_cell + 1 &&
+                 !table->cells[first_cell].quoted && table->cells[first_cell].length == 0;
+    if (blank) {
+        table->cell_count = first_cell;
+    } else {
+        endRow(vm, table);
+    }
+    return p;
+}
+
+// Length of the first complete record in [p, end), terminator included, or
+// 0 when the record continues past end. As in parseRecord, a quote opens a
+// quoted cell only at the start of a cell; quoted newlines do not end a record.
+static size_t findRecordEnd(const char* p, const char* end, char delim, bool at_eof) {
+    const char* start = p;
+    while (p < end) {
+        if (*p == '"') {
+            p++;
+            for (;;) {
+                const char* quote = memchr(p, '"', (size_t)(end - p));
+                if (quote == NULL || quote + 1 == end) return 0;  // might be half of ""
+                if (quote[1] == '"') {
+                    p = quote + 2;
+                    continue;
+                }
+                p = quote + 1;
+                break;
+            }
+        }
+        p = findSpecial(p, end, delim);
+        if (p == end) return 0;
+        if (*p == delim) {
+            p++;
+            continue;
+        }
+        if (*p == '\r') {
+            if (p + 1 == end && !at_eof) return 0;  // might be half of "\r\n"
+            if (p + 1 < end && p[1] == '\n') p++;
+        }
+        return (size_t)(p + 1 - start);
+    }
+    return 0;
+}
+
+// =============================================================================
+// CELL VALUES
+// =============================================================================
+
+// Columnar cell strings are not interned: their bytes live in one arena per
+// parse, shared by external strings and freed when the last of them is
+// collected. Row output interns every cell and uses the arena only as scratch
+// for unescaping, so a row kept alive never pins the whole parse buffer.
+typedef struct {
+    ZymAllocator* allocator;
+    size_t size;
+    size_t used;
+    int refs;
+    bool shared;    // cells become external strings backed by bytes
+    char bytes[];
+} CsvArena;
+
+static CsvArena* newArena(ZymVM* vm, size_t size, bool shared) {
+    ZymAllocator* allocator = (ZymAllocator*)zym_getAllocator(vm);
+    CsvArena* arena = ZYM_ALLOC(allocator, sizeof(CsvArena) + size);
+    if (arena == NULL) return NULL;
+    arena->allocator = allocator;
+    arena->size = size;
+    arena->used = 0;
+    arena->refs = 1;  // held by the parser until it finishes
+    arena->shared = shared;
+    return arena;
+}
+
+static void releaseArena(void* userdata, const char* chars, int length) {
+    (void)chars;
+    (void)length;
+    CsvArena* arena = (CsvArena*)userdata;
+    if (--arena->refs == 0) {
+        ZYM_FREE(arena->allocator, arena, sizeof(CsvArena) + arena->size);
+    }
+}
+
+static size_t cellStringBytes(const CsvCell* cell) {
+    return cell->length > 0 ? (size_t)cell->length + 1 : 0;
+}
+
+static ZymValue cellString(ZymVM* vm, const CsvCell* cell, CsvArena* arena) {
+    if (cell->length == 0) {
+        return zym_newString(vm, "");
+    }
+
+    char* out = arena->bytes + arena->used;
+    int length = 0;
+    if (cell->escaped) {
+        for (int i = 0; i < cell->length; i++) {
+            out[length++] = cell->start[i];
+            if (cell->start[i] == '"') i++;
+        }
+    } else {
+        memcpy(out, cell->start, (size_t)cell->length);
+        length = cell->length;
+    }
+    out[length] = '\0';
+    if (!arena->shared) {
+        return zym_newStringN(vm, out, length);
+    }
+    arena->used += (size_t)length + 1;
+    arena->refs++;
+    return zym_newExternalString(vm, out, length, releaseArena, arena);
+}
+
+// Plain decimal/scientific notation only: no whitespace, hex, inf or nan
+static bool cellNumber(const CsvCell* cell, double* out) {
+    if (cell->quoted || cell->length == 0 || cell->length > 63) return false;
+
+    char digits[64];
+    for (int i = 0; i < cell->length; i++) {
+        char c = cell->start[i];
+        if (!((c >= '0' && c <= '9') || c == '.' || c == '-' || c == '+' || c == 'e' || c == 'E')) {
+            return false;
+        }
+        digits[i] = c;
+    }
+    digits[cell->length] = '\0';
+
+    char* parsed_end;
+    *out = strtod(digits, &parsed_end);
+    return parsed_end == digits + cell->length;
+}
+
+// =============================================================================
+// OPTIONS
+// =============================================================================
+
+typedef struct {
+    char delimiter;
+    bool numbers;
+    bool columns;
+    bool header;
+} CsvOptions;
+
+static bool readBoolOption(ZymVM* vm, const char* fn, ZymValue options, const char* key, bool* out) {
+    ZymValue value = zym_mapGet(vm, options, key);
+    if (value == ZYM_ERROR) return true;
+    if (!zym_isBool(value)) {
+        zym_runtimeError(vm, "%s() option '%s' must be a bool", fn, key);
+        return false;
+    }
+    *out = zym_asBool(value);
+    return true;
+}
+
+static bool readOptions(ZymVM* vm, const char* fn, ZymValue options, CsvOptions* out) {
+    *out = (CsvOptions){',', true, false, false};
+    if (zym_isNull(options)) return true;
+    if (!zym_isMap(options)) {
+        zym_runtimeError(vm, "%s() options must be a map", fn);
+        return false;
+    }
+
+    ZymValue delimiter = zym_mapGet(vm, options, "delimiter");
+    if (delimiter != ZYM_ERROR) {
+        const char* chars;
+        int length;
+        if (!zym_toStringBytes(delimiter, &chars, &length) || length != 1 ||
+            chars[0] == '"' || chars[0] == '\n' || chars[0] == '\r') {
+            zym_runtimeError(vm, "%s() delimiter must be a single byte other than a quote or newline", fn);
+            return false;
+        }
+        out->delimiter = chars[0];
+    }
+
+    return readBoolOption(vm, fn, options, "numbers", &out->numbers) &&
+           readBoolOption(vm, fn, options, "columns", &out->columns) &&
+           readBoolOption(vm, fn, options, "header", &out->header);
+}
+
+// =============================================================================
+// RESULT BUILDING
+// =============================================================================
+
+static ZymValue cellValue(ZymVM* vm, const CsvCell* cell, CsvArena* arena, bool numbers) {
+    double number;
+    if (numbers && cellNumber(cell, &number)) {
+        return zym_newNumber(number);
+    }
+    return cellString(vm, cell, arena);
+}
+
+// Append record row of table to list as a list of cells
+static void appendRecord(ZymVM* vm, ZymValue list, const CsvTable* table, int row,
+                         CsvArena* arena, bool numbers) {
+    int first = row == 0 ? 0 : table->row_ends[row - 1];
+    int last = table->row_ends[row];
+
+    ZymValue record = zym_newList(vm);
+    zym_listAppend(vm, list, record);
+    zym_listReserve(vm, record, last - first);
+    for (int i = first; i < last; i++) {
+        zym_listAppend(vm, record, cellValue(vm, &table->cells[i], arena, numbers));
+    }
+}
+
+static const CsvCell* cellAt(const CsvTable* table, int row, int column) {
+    int first = row == 0 ? 0 : table->row_ends[row - 1];
+    if (first + column >= table->row_ends[row]) return NULL;
+    return &table->cells[first + column];
+}
+
+static ZymValue buildColumn(ZymVM* vm, const CsvTable* table, int first_row, int column,
+                            CsvArena* arena, bool numbers) {
+    int count = table->row_count - first_row;
+
+    bool numeric = numbers && count > 0;
+    for (int row = first_row; numeric && row < table->row_count; row++) {
+        const CsvCell* cell = cellAt(table, row, column);
+        double number;
+        numeric = cell != NULL && cellNumber(cell, &number);
+    }
+
+    if (numeric) {
+        double* values = ALLOCATE(vm, double, count);
+        for (int row = first_row; row < table->row_count; row++) {
+            cellNumber(cellAt(table, row, column), &values[row - first_row]);
+        }
+        ZymValue list = zym_newListFromDoubles(vm, values, count);
+        FREE_ARRAY(vm, double, values, count);
+        return list;
+    }
+
+    ZymValue list = zym_newList(vm);
+    zym_pushRoot(vm, list);
+    zym_listReserve(vm, list, count);
+    for (int row = first_row; row < table->row_count; row++) {
+        const CsvCell* cell = cellAt(table, row, column);
+        zym_listAppend(vm, list, cell != NULL ? cellString(vm, cell, arena) : zym_newNull());
+    }
+    zym_popRoot(vm);
+    return list;
+}
+
+static ZymValue buildColumns(ZymVM* vm, const CsvTable* table, CsvArena* arena, const CsvOptions* options) {
+    int column_count = table->row_count > 0 ? table->row_ends[0] : 0;
+    int first_row = options->header && table->row_count > 0 ? 1 : 0;
+
+    ZymValue result = options->header ? zym_newMap(vm) : zym_newList(vm);
+    zym_pushRoot(vm, result);
+    if (!options->header) zym_listReserve(vm, result, column_count);
+    for (int column = 0; column < column_count; column++) {
+        ZymValue values = buildColumn(vm, table, first_row, column, arena, options->numbers);
+        if (!options->header) {
+            zym_listAppend(vm, result, values);
+            continue;
+        }
+        zym_pushRoot(vm, values);
+
+        // Map keys need the unescaped name as a C string
+        const CsvCell* name = &table->cells[column];
+        char* key = ALLOCATE(vm, char, name->length + 1);
+        int length = 0;
+        for (int i = 0; i < name->length; i++) {
+            key[length++] = name->start[i];
+            if (name->escaped && name->start[i] == '"') i++;
+        }
+        key[length] = '\0';
+        zym_mapSet(vm, result, key, values);
+        zym_popRoot(vm);
+        FREE_ARRAY(vm, char, key, name->length + 1);
+    }
+    zym_popRoot(vm);
+    return result;
+}
+
+// A shared arena holds every cell; scratch only needs room for the largest
+static CsvArena* arenaForTable(ZymVM* vm, const CsvTable* table, bool shared) {
+    size_t size = 0;
+    for (int i = 0; i < table->cell_count; i++) {
+        size_t bytes = cellStringBytes(&table->cells[i]);
+        if (shared) {
+            size += bytes;
+        } else if (bytes > size) {
+            size = bytes;
+        }
+    }
+    return newArena(vm, size, shared);
+}
+
+// =============================================================================
+// CSV NATIVES
+// =============================================================================
+
+ZymValue nativeCsv_parseWithOptions(ZymVM* vm, ZymValue text, ZymValue options_val) {
+    CsvOptions options;
+    if (!readOptions(vm, "csvParse", options_val, &options)) return ZYM_ERROR;
+
+    const char* chars;
+    int length;
+    if (!zym_toStringBytes(text, &chars, &length)) {
+        zym_runtimeError(vm, "csvParse() requires a string");
+        return ZYM_ERROR;
+    }
+
+    CsvTable table = {0};
+    const char* p = chars;
+    const char* end = chars + length;
+    while (p < end) {
+        p = parseRecord(vm, &table, p, end, options.delimiter);
+    }
+
+    CsvArena* arena = arenaForTable(vm, &table, options.columns);
+    if (arena == NULL) {
+        freeCsvTable(vm, &table);
+        zym_runtimeError(vm, "csvParse() out of memory");
+        return ZYM_ERROR;
+    }
+
+    ZymValue result;
+    if (options.columns) {
+        result = buildColumns(vm, &table, arena, &options);
+    } else {
+        result = zym_newList(vm);
+        zym_pushRoot(vm, result);
+        zym_listReserve(vm, result, table.row_count);
+        for (int row = 0; row < table.row_count; row++) {
+            appendRecord(vm, result, &table, row, arena, options.numbers);
+        }
+        zym_popRoot(vm);
+    }
+
+    releaseArena(arena, NULL, 0);
+    freeCsvTable(vm, &table);
+    return result;
+}
+
+ZymValue nativeCsv_parse(ZymVM* vm, ZymValue text) {
+    return nativeCsv_parseWithOptions(vm, text, zym_newNull());
+}
+
+ZymValue nativeCsv_readRowWithOptions(ZymVM* vm, ZymValue reader_val, ZymValue options_val) {
+    CsvOptions options;
+    if (!readOptions(vm, "csvReadRow", options_val, &options)) return ZYM_ERROR;
+    Reader* reader = readerFromValue(reader_val);
+    if (reader == NULL) {
+        zym_runtimeError(vm, "csvReadRow() requires a reader, got %s", zym_typeName(reader_val));
+        return ZYM_ERROR;
+    }
+
+    CsvTable table = {0};
+    while (table.row_count == 0) {
+        const char* data = reader->buffer + reader->start;
+        size_t available = reader->end - reader->start;
+        size_t record = findRecordEnd(data, data + available, options.delimiter, reader->eof);
+
+        if (record == 0 && !reader->eof) {
+            // Whole records are parsed in place, so grow for oversized ones
+            if (reader->start == 0 && reader->end == reader->capacity) {
+                readerGrow(vm, reader);
+            }
+            if (readerRefill(vm, reader, "csvReadRow") < 0) {
+                freeCsvTable(vm, &table);
+                return ZYM_ERROR;
+            }
+            continue;
+        }
+        if (record == 0) {
+            record = available;
+            if (record == 0) {
+                freeCsvTable(vm, &table);
+                return zym_newNull();
+            }
+        }
+
+        const char* parsed = parseRecord(vm, &table, data, data + record, options.delimiter);
+        reader->start += (size_t)(parsed - data);
+    }
+
+    CsvArena* arena = arenaForTable(vm, &table, false);
+    if (arena == NULL) {
+        freeCsvTable(vm, &table);
+        zym_runtimeError(vm, "csvReadRow() out of memory");
+        return ZYM_ERROR;
+    }
+
+    ZymValue holder = zym_newList(vm);
+    zym_pushRoot(vm, holder);
+    appendRecord(vm, holder, &table, 0, arena, options.numbers);
+    zym_popRoot(vm);
+
+    releaseArena(arena, NULL, 0);
+    freeCsvTable(vm, &table);
+    return zym_listData(holder, NULL)[0];
+}
+
+ZymValue nativeCsv_readRow(ZymVM* vm, ZymValue reader) {
+    return nativeCsv_readRowWithOptions(vm, reader, zym_newNull());
+}
+
+// =============================================================================
+// REGISTRATION
+// =============================================================================
+
+void registerCsvNatives(VM* vm) {
+    zym_defineNative(vm, "csvParse(text)", nativeCsv_parse);
+    zym_defineNative(vm, "csvParse(text, options)", nativeCsv_parseWithOptions);
+    zym_defineNative(vm, "csvReadRow(reader)", nativeCsv_readRow);
+    zym_defineNative(vm, "csvReadRow(reader, options)", nativeCsv_readRowWithOptions);
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "../vm.h"
+#include "zym/zym.h"
+
+// RFC 4180 CSV/TSV parsing. options is a map with optional keys:
+//   delimiter  one-byte string, default ","  (use "\t" for TSV)
+//   numbers    convert numeric cells to numbers, default true
+//   columns    return columns instead of rows, default false
+//   header     first record names the columns (columnar mode only), default false
+// Row mode returns a list of records, each a list of cells. Columnar mode
+// returns a list of columns, or a map keyed by header name; a column whose
+// cells are all numeric is a packed number list, otherwise cells are strings.
+ZymValue nativeCsv_parse(ZymVM* vm, ZymValue text);
+ZymValue nativeCsv_parseWithOptions(ZymVM* vm, ZymValue text, ZymValue options);
+
+// Streaming mode: the next record from a reader as a list of cells, or null
+// at end of stream. Quoted cells may span lines and buffer refills.
+ZymValue nativeCsv_readRow(ZymVM* vm, ZymValue reader);
+ZymValue nativeCsv_readRowWithOptions(ZymVM* vm, ZymValue reader, ZymValue options);
+
+// Register CSV natives into the VM
+void registerCsvNatives(VM* vm);
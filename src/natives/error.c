@@ -14,7 +14,7 @@ ZymValue nativeError_error(ZymVM* vm, ZymValue message) {
     }
 
     const char* msg = zym_asCString(message);
-    zym_runtimeError(vm, msg);
+    zym_runtimeError(vm, "%s", msg);
     return ZYM_ERROR;
 }
 
@@ -39,7 +39,7 @@ ZymValue nativeError_assert(ZymVM* vm, ZymValue condition, ZymValue message) {
     if (!conditionMet) {
         if (zym_isString(message)) {
             const char* msg = zym_asCString(message);
-            zym_runtimeError(vm, msg);
+            zym_runtimeError(vm, "%s", msg);
         } else {
             zym_runtimeError(vm, "Assertion failed");
         }
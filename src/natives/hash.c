@@ -0,0 +1,529 @@
+#include <string.h>
+#include <math.h>
+#include "hash.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <nmmintrin.h>
+#define ZYM_HASH_X86_CRC 1
+#endif
+
+#if defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#define ZYM_HASH_ARM_CRC 1
+#endif
+
+// =============================================================================
+// BYTE INPUT
+// =============================================================================
+
+typedef void (*HashUpdateFn)(void* state, const uint8_t* data, size_t len);
+
+// Feed a string's bytes directly, or a list of byte values (0-255) through a
+// stack chunk, so no intermediate buffer is allocated either way.
+static bool feedBytes(ZymValue data, HashUpdateFn update, void* state) {
+    const char* chars;
+    int byte_length;
+    if (zym_toStringBytes(data, &chars, &byte_length)) {
+        update(state, (const uint8_t*)chars, (size_t)byte_length);
+        return true;
+    }
+
+    if (!zym_isList(data)) {
+        return false;
+    }
+    int count;
+    ZymValue* values = zym_listData(data, &count);
+
+    uint8_t chunk[256];
+    size_t used = 0;
+    for (int i = 0; i < count; i++) {
+        if (!zym_isNumber(values[i])) return false;
+        double byte = zym_asNumber(values[i]);
+        if (byte < 0 || byte > 255 || byte != floor(byte)) return false;
+        chunk[used++] = (uint8_t)byte;
+        if (used == sizeof(chunk)) {
+            update(state, chunk, used);
+            used = 0;
+        }
+    }
+    if (used > 0) {
+        update(state, chunk, used);
+    }
+    return true;
+}
+
+static ZymValue newHexString(ZymVM* vm, const uint8_t* bytes, int count) {
+    static const char digits[] = "0123456789abcdef";
+    char hex[64];
+    for (int i = 0; i < count; i++) {
+        hex[i * 2] = digits[bytes[i] >> 4];
+        hex[i * 2 + 1] = digits[bytes[i] & 0x0f];
+    }
+    return zym_newStringN(vm, hex, count * 2);
+}
+
+static inline uint64_t readLE64(const uint8_t* p) {
+    return (uint64_t)p[0] | ((uint64_t)p[1] << 8) | ((uint64_t)p[2] << 16) | ((uint64_t)p[3] << 24) |
+           ((uint64_t)p[4] << 32) | ((uint64_t)p[5] << 40) | ((uint64_t)p[6] << 48) | ((uint64_t)p[7] << 56);
+}
+
+static inline uint32_t readLE32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+// =============================================================================
+// CRC-32 (IEEE 802.3) AND CRC-32C (CASTAGNOLI)
+// =============================================================================
+
+static const uint32_t crc32_ieee_table[256] = {
+    0x00000000, 0x77073096, 0xee0e612c, 0x990951ba, 0x076dc419, 0x706af48f,
+    0xe963a535, 0x9e6495a3, 0x0edb8832, 0x79dcb8a4, 0xe0d5e91e, 0x97d2d988,
+    0x09b64c2b, 0x7eb17cbd, 0xe7b82d07, 0x90bf1d91, 0x1db71064, 0x6ab020f2,
+    0xf3b97148, 0x84be41de, 0x1adad47d, 0x6ddde4eb, 0xf4d4b551, 0x83d385c7,
+    0x136c9856, 0x646ba8c0, 0xfd62f97a, 0x8a65c9ec, 0x14015c4f, 0x63066cd9,
+    0xfa0f3d63, 0x8d080df5, 0x3b6e20c8, 0x4c69105e, 0xd56041e4, 0xa2677172,
+    0x3c03e4d1, 0x4b04d447, 0xd20d85fd, 0xa50ab56b, 0x35b5a8fa, 0x42b2986c,
+    0xdbbbc9d6, 0xacbcf940, 0x32d86ce3, 0x45df5c75, 0xdcd60dcf, 0xabd13d59,
+    0x26d930ac, 0x51de003a, 0xc8d75180, 0xbfd06116, 0x21b4f4b5, 0x56b3c423,
+    0xcfba9599, 0xb8bda50f, 0x2802b89e, 0x5f058808, 0xc60cd9b2, 0xb10be924,
+    0x2f6f7c87, 0x58684c11, 0xc1611dab, 0xb6662d3d, 0x76dc4190, 0x01db7106,
+    0x98d220bc, 0xefd5102a, 0x71b18589, 0x06b6b51f, 0x9fbfe4a5, 0xe8b8d433,
+    0x7807c9a2, 0x0f00f934, 0x9609a88e, 0xe10e9818, 0x7f6a0dbb, 0x086d3d2d,
+    0x91646c97, 0xe6635c01, 0x6b6b51f4, 0x1c6c6162, 0x856530d8, 0xf262004e,
+    0x6c0695ed, 0x1b01a57b, 0x8208f4c1, 0xf50fc457, 0x65b0d9c6, 0x12b7e950,
+    0x8bbeb8ea, 0xfcb9887c, 0x62dd1ddf, 0x15da2d49, 0x8cd37cf3, 0xfbd44c65,
+    0x4db26158, 0x3ab551ce, 0xa3bc0074, 0xd4bb30e2, 0x4adfa541, 0x3dd895d7,
+    0xa4d1c46d, 0xd3d6f4fb, 0x4369e96a, 0x346ed9fc, 0xad678846, 0xda60b8d0,
+    0x44042d73, 0x33031de5, 0xaa0a4c5f, 0xdd0d7cc9, 0x5005713c, 0x270241aa,
+    0xbe0b1010, 0xc90c2086, 0x5768b525, 0x206f85b3, 0xb966d409, 0xce61e49f,
+    0x5edef90e, 0x29d9c998, 0xb0d09822, 0xc7d7a8b4, 0x59b33d17, 0x2eb40d81,
+    0xb7bd5c3b, 0xc0ba6cad, 0xedb88320, 0x9abfb3b6, 0x03b6e20c, 0x74b1d29a,
+    0xead54739, 0x9dd277af, 0x04db2615, 0x73dc1683, 0xe3630b12, 0x94643b84,
+    0x0d6d6a3e, 0x7a6a5aa8, 0xe40ecf0b, 0x9309ff9d, 0x0a00ae27, 0x7d079eb1,
+    0xf00f9344, 0x8708a3d2, 0x1e01f268, 0x6906c2fe, 0xf762575d, 0x806567cb,
+    0x196c3671, 0x6e6b06e7, 0xfed41b76, 0x89d32be0, 0x10da7a5a, 0x67dd4acc,
+    0xf9b9df6f, 0x8ebeeff9, 0x17b7be43, 0x60b08ed5, 0xd6d6a3e8, 0xa1d1937e,
+    0x38d8c2c4, 0x4fdff252, 0xd1bb67f1, 0xa6bc5767, 0x3fb506dd, 0x48b2364b,
+    0xd80d2bda, 0xaf0a1b4c, 0x36034af6, 0x41047a60, 0xdf60efc3, 0xa867df55,
+    0x316e8eef, 0x4669be79, 0xcb61b38c, 0xbc66831a, 0x256fd2a0, 0x5268e236,
+    0xcc0c7795, 0xbb0b4703, 0x220216b9, 0x5505262f, 0xc5ba3bbe, 0xb2bd0b28,
+    0x2bb45a92, 0x5cb36a04, 0xc2d7ffa7, 0xb5d0cf31, 0x2cd99e8b, 0x5bdeae1d,
+    0x9b64c2b0, 0xec63f226, 0x756aa39c, 0x026d930a, 0x9c0906a9, 0xeb0e363f,
+    0x72076785, 0x05005713, 0x95bf4a82, 0xe2b87a14, 0x7bb12bae, 0x0cb61b38,
+    0x92d28e9b, 0xe5d5be0d, 0x7cdcefb7, 0x0bdbdf21, 0x86d3d2d4, 0xf1d4e242,
+    0x68ddb3f8, 0x1fda836e, 0x81be16cd, 0xf6b9265b, 0x6fb077e1, 0x18b74777,
+    0x88085ae6, 0xff0f6a70, 0x66063bca, 0x11010b5c, 0x8f659eff, 0xf862ae69,
+    0x616bffd3, 0x166ccf45, 0xa00ae278, 0xd70dd2ee, 0x4e048354, 0x3903b3c2,
+    0xa7672661, 0xd06016f7, 0x4969474d, 0x3e6e77db, 0xaed16a4a, 0xd9d65adc,
+    0x40df0b66, 0x37d83bf0, 0xa9bcae53, 0xdebb9ec5, 0x47b2cf7f, 0x30b5ffe9,
+    0xbdbdf21c, 0xcabac28a, 0x53b39330, 0x24b4a3a6, 0xbad03605, 0xcdd70693,
+    0x54de5729, 0x23d967bf, 0xb3667a2e, 0xc4614ab8, 0x5d681b02, 0x2a6f2b94,
+    0xb40bbe37, 0xc30c8ea1, 0x5a05df1b, 0x2d02ef8d,
+};
+
+static const uint32_t crc32c_table[256] = {
+    0x00000000, 0xf26b8303, 0xe13b70f7, 0x1350f3f4, 0xc79a971f, 0x35f1141c,
+    0x26a1e7e8, 0xd4ca64eb, 0x8ad958cf, 0x78b2dbcc, 0x6be22838, 0x9989ab3b,
+    0x4d43cfd0, 0xbf284cd3, 0xac78bf27, 0x5e133c24, 0x105ec76f, 0xe235446c,
+    0xf165b798, 0x030e349b, 0xd7c45070, 0x25afd373, 0x36ff2087, 0xc494a384,
+    0x9a879fa0, 0x68ec1ca3, 0x7bbcef57, 0x89d76c54, 0x5d1d08bf, 0xaf768bbc,
+    0xbc267848, 0x4e4dfb4b, 0x20bd8ede, 0xd2d60ddd, 0xc186fe29, 0x33ed7d2a,
+    0xe72719c1, 0x154c9ac2, 0x061c6936, 0xf477ea35, 0xaa64d611, 0x580f5512,
+    0x4b5fa6e6, 0xb93425e5, 0x6dfe410e, 0x9f95c20d, 0x8cc531f9, 0x7eaeb2fa,
+    0x30e349b1, 0xc288cab2, 0xd1d83946, 0x23b3ba45, 0xf779deae, 0x05125dad,
+    0x1642ae59, 0xe4292d5a, 0xba3a117e, 0x4851927d, 0x5b016189, 0xa96ae28a,
+    0x7da08661, 0x8fcb0562, 0x9c9bf696, 0x6ef07595, 0x417b1dbc, 0xb3109ebf,
+    0xa0406d4b, 0x522bee48, 0x86e18aa3, 0x748a09a0, 0x67dafa54, 0x95b17957,
+    0xcba24573, 0x39c9c670, 0x2a993584, 0xd8f2b687, 0x0c38d26c, 0xfe53516f,
+    0xed03a29b, 0x1f682198, 0x5125dad3, 0xa34e59d0, 0xb01eaa24, 0x42752927,
+    0x96bf4dcc, 0x64d4cecf, 0x77843d3b, 0x85efbe38, 0xdbfc821c, 0x2997011f,
+    0x3ac7f2eb, 0xc8ac71e8, 0x1c661503, 0xee0d9600, 0xfd5d65f4, 0x0f36e6f7,
+    0x61c69362, 0x93ad1061, 0x80fde395, 0x72966096, 0xa65c047d, 0x5437877e,
+    0x4767748a, 0xb50cf789, 0xeb1fcbad, 0x197448ae, 0x0a24bb5a, 0xf84f3859,
+    0x2c855cb2, 0xdeeedfb1, 0xcdbe2c45, 0x3fd5af46, 0x7198540d, 0x83f3d70e,
+    0x90a324fa, 0x62c8a7f9, 0xb602c312, 0x44694011, 0x5739b3e5, 0xa55230e6,
+    0xfb410cc2, 0x092a8fc1, 0x1a7a7c35, 0xe811ff36, 0x3cdb9bdd, 0xceb018de,
+    0xdde0eb2a, 0x2f8b6829, 0x82f63b78, 0x709db87b, 0x63cd4b8f, 0x91a6c88c,
+    0x456cac67, 0xb7072f64, 0xa457dc90, 0x563c5f93, 0x082f63b7, 0xfa44e0b4,
+    0xe9141340, 0x1b7f9043, 0xcfb5f4a8, 0x3dde77ab, 0x2e8e845f, 0xdce5075c,
+    0x92a8fc17, 0x60c37f14, 0x73938ce0, 0x81f80fe3, 0x55326b08, 0xa759e80b,
+    0xb4091bff, 0x466298fc, 0x1871a4d8, 0xea1a27db, 0xf94ad42f, 0x0b21572c,
+    0xdfeb33c7, 0x2d80b0c4, 0x3ed04330, 0xccbbc033, 0xa24bb5a6, 0x502036a5,
+    0x4370c551, 0xb11b4652, 0x65d122b9, 0x97baa1ba, 0x84ea524e, 0x7681d14d,
+    0x2892ed69, 0xdaf96e6a, 0xc9a99d9e, 0x3bc21e9d, 0xef087a76, 0x1d63f975,
+    0x0e330a81, 0xfc588982, 0xb21572c9, 0x407ef1ca, 0x532e023e, 0xa145813d,
+    0x758fe5d6, 0x87e466d5, 0x94b49521, 0x66df1622, 0x38cc2a06, 0xcaa7a905,
+    0xd9f75af1, 0x2b9cd9f2, 0xff56bd19, 0x0d3d3e1a, 0x1e6dcdee, 0xec064eed,
+    0xc38d26c4, 0x31e6a5c7, 0x22b65633, 0xd0ddd530, 0x0417b1db, 0xf67c32d8,
+    0xe52cc12c, 0x1747422f, 0x49547e0b, 0xbb3ffd08, 0xa86f0efc, 0x5a048dff,
+    0x8ecee914, 0x7ca56a17, 0x6ff599e3, 0x9d9e1ae0, 0xd3d3e1ab, 0x21b862a8,
+    0x32e8915c, 0xc083125f, 0x144976b4, 0xe622f5b7, 0xf5720643, 0x07198540,
+    0x590ab964, 0xab613a67, 0xb831c993, 0x4a5a4a90, 0x9e902e7b, 0x6cfbad78,
+    0x7fab5e8c, 0x8dc0dd8f, 0xe330a81a, 0x115b2b19, 0x020bd8ed, 0xf0605bee,
+    0x24aa3f05, 0xd6c1bc06, 0xc5914ff2, 0x37faccf1, 0x69e9f0d5, 0x9b8273d6,
+    0x88d28022, 0x7ab90321, 0xae7367ca, 0x5c18e4c9, 0x4f48173d, 0xbd23943e,
+    0xf36e6f75, 0x0105ec76, 0x12551f82, 0xe03e9c81, 0x34f4f86a, 0xc69f7b69,
+    0xd5cf889d, 0x27a40b9e, 0x79b737ba, 0x8bdcb4b9, 0x988c474d, 0x6ae7c44e,
+    0xbe2da0a5, 0x4c4623a6, 0x5f16d052, 0xad7d5351,
+};
+
+static void crc32Update(void* state, const uint8_t* data, size_t len) {
+    uint32_t crc = *(uint32_t*)state;
+#ifdef ZYM_HASH_ARM_CRC
+    for (; len >= 8; data += 8, len -= 8) {
+        crc = __crc32d(crc, readLE64(data));
+    }
+    for (; len > 0; data++, len--) {
+        crc = __crc32b(crc, *data);
+    }
+#else
+    for (; len > 0; data++, len--) {
+        crc = crc32_ieee_table[(crc ^ *data) & 0xff] ^ (crc >> 8);
+    }
+#endif
+    *(uint32_t*)state = crc;
+}
+
+#ifdef ZYM_HASH_X86_CRC
+// The SSE4.2 crc32 instruction implements the Castagnoli polynomial only
+__attribute__((target("sse4.2")))
+static uint32_t crc32cHardware(uint32_t crc, const uint8_t* data, size_t len) {
+    uint64_t crc64 = crc;
+    for (; len >= 8; data += 8, len -= 8) {
+        uint64_t word;
+        memcpy(&word, data, sizeof(word));
+        crc64 = _mm_crc32_u64(crc64, word);
+    }
+    crc = (uint32_t)crc64;
+    for (; len > 0; data++, len--) {
+        crc = _mm_crc32_u8(crc, *data);
+    }
+    return crc;
+}
+#endif
+
+static void crc32cUpdate(void* state, const uint8_t* data, size_t len) {
+    uint32_t crc = *(uint32_t*)state;
+#if defined(ZYM_HASH_ARM_CRC)
+    for (; len >= 8; data += 8, len -= 8) {
+        crc = __crc32cd(crc, readLE64(data));
+    }
+    for (; len > 0; data++, len--) {
+        crc = __crc32cb(crc, *data);
+    }
+#else
+#ifdef ZYM_HASH_X86_CRC
+    if (__builtin_cpu_supports("sse4.2")) {
+        *(uint32_t*)state = crc32cHardware(crc, data, len);
+        return;
+    }
+#endif
+    for (; len > 0; data++, len--) {
+        crc = crc32c_table[(crc ^ *data) & 0xff] ^ (crc >> 8);
+    }
+#endif
+    *(uint32_t*)state = crc;
+}
+
+// =============================================================================
+// FNV-1a (32-bit, the VM's string hash)
+// =============================================================================
+
+static void fnv1aUpdate(void* state, const uint8_t* data, size_t len) {
+    uint32_t hash = *(uint32_t*)state;
+    for (size_t i = 0; i < len; i++) {
+        hash ^= data[i];
+        hash *= 16777619u;
+    }
+    *(uint32_t*)state = hash;
+}
+
+// =============================================================================
+// XXH64
+// =============================================================================
+
+#define XXH_PRIME64_1 0x9E3779B185EBCA87ULL
+#define XXH_PRIME64_2 0xC2B2AE3D27D4EB4FULL
+#define XXH_PRIME64_3 0x165667B19E3779F9ULL
+#define XXH_PRIME64_4 0x85EBCA77C2B2AE63ULL
+#define XXH_PRIME64_5 0x27D4EB2F165667C5ULL
+
+typedef struct {
+    uint64_t total_len;
+    uint64_t acc[4];
+    uint8_t buffer[32];
+    size_t buffered;
+} XXH64State;
+
+static inline uint64_t rotl64(uint64_t x, int r) {
+    return (x << r) | (x >> (64 - r));
+}
+
+static inline uint64_t xxh64Round(uint64_t acc, uint64_t input) {
+    acc += input * XXH_PRIME64_2;
+    acc = rotl64(acc, 31);
+    return acc * XXH_PRIME64_1;
+}
+
+static inline uint64_t xxh64MergeRound(uint64_t acc, uint64_t val) {
+    acc ^= xxh64Round(0, val);
+    return acc * XXH_PRIME64_1 + XXH_PRIME64_4;
+}
+
+static void xxh64Init(XXH64State* state, uint64_t seed) {
+    state->total_len = 0;
+    state->acc[0] = seed + XXH_PRIME64_1 + XXH_PRIME64_2;
+    state->acc[1] = seed + XXH_PRIME64_2;
+    state->acc[2] = seed;
+    state->acc[3] = seed - XXH_PRIME64_1;
+    state->buffered = 0;
+}
+
+static void xxh64Stripe(XXH64State* state, const uint8_t* p) {
+    state->acc[0] = xxh64Round(state->acc[0], readLE64(p));
+    state->acc[1] = xxh64Round(state->acc[1], readLE64(p + 8));
+    state->acc[2] = xxh64Round(state->acc[2], readLE64(p + 16));
+    state->acc[3] = xxh64Round(state->acc[3], readLE64(p + 24));
+}
+
+static void xxh64Update(void* opaque, const uint8_t* data, size_t len) {
+    XXH64State* state = (XXH64State*)opaque;
+    state->total_len += len;
+
+    if (state->buffered + len < 32) {
+        memcpy(state->buffer + state->buffered, data, len);
+        state->buffered += len;
+        return;
+    }
+
+    if (state->buffered > 0) {
+        size_t fill = 32 - state->buffered;
+        memcpy(state->buffer + state->buffered, data, fill);
+        xxh64Stripe(state, state->buffer);
+        data += fill;
+        len -= fill;
+        state->buffered = 0;
+    }
+
+    for (; len >= 32; data += 32, len -= 32) {
+        xxh64Stripe(state, data);
+    }
+
+    memcpy(state->buffer, data, len);
+    state->buffered = len;
+}
+
+static uint64_t xxh64Digest(const XXH64State* state, uint64_t seed) {
+    uint64_t h;
+    if (state->total_len >= 32) {
+        h = rotl64(state->acc[0], 1) + rotl64(state->acc[1], 7) +
+            rotl64(state->acc[2], 12) + rotl64(state->acc[3], 18);
+        for (int i = 0; i < 4; i++) {
+            h = xxh64MergeRound(h, state->acc[i]);
+        }
+    } else {
+        h = seed + XXH_PRIME64_5;
+    }
+    h += state->total_len;
+
+    const uint8_t* p = state->buffer;
+    size_t len = state->buffered;
+    for (; len >= 8; p += 8, len -= 8) {
+        h ^= xxh64Round(0, readLE64(p));
+        h = rotl64(h, 27) * XXH_PRIME64_1 + XXH_PRIME64_4;
+    }
+    if (len >= 4) {
+        h ^= (uint64_t)readLE32(p) * XXH_PRIME64_1;
+        h = rotl64(h, 23) * XXH_PRIME64_2 + XXH_PRIME64_3;
+        p += 4;
+        len -= 4;
+    }
+    for (; len > 0; p++, len--) {
+        h ^= (uint64_t)(*p) * XXH_PRIME64_5;
+        h = rotl64(h, 11) * XXH_PRIME64_1;
+    }
+
+    h ^= h >> 33;
+    h *= XXH_PRIME64_2;
+    h ^= h >> 29;
+    h *= XXH_PRIME64_3;
+    h ^= h >> 32;
+    return h;
+}
+
+// =============================================================================
+// SHA-256
+// =============================================================================
+
+typedef struct {
+    uint32_t h[8];
+    uint64_t total_len;
+    uint8_t block[64];
+    size_t buffered;
+} SHA256State;
+
+static const uint32_t sha256_k[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+static inline uint32_t rotr32(uint32_t x, int r) {
+    return (x >> r) | (x << (32 - r));
+}
+
+static void sha256Init(SHA256State* state) {
+    static const uint32_t initial[8] = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+        0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+    };
+    memcpy(state->h, initial, sizeof(initial));
+    state->total_len = 0;
+    state->buffered = 0;
+}
+
+static void sha256Block(SHA256State* state, const uint8_t* p) {
+    uint32_t w[64];
+    for (int i = 0; i < 16; i++) {
+        w[i] = ((uint32_t)p[i * 4] << 24) | ((uint32_t)p[i * 4 + 1] << 16) |
+               ((uint32_t)p[i * 4 + 2] << 8) | (uint32_t)p[i * 4 + 3];
+    }
+    for (int i = 16; i < 64; i++) {
+        uint32_t s0 = rotr32(w[i - 15], 7) ^ rotr32(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        uint32_t s1 = rotr32(w[i - 2], 17) ^ rotr32(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    uint32_t a = state->h[0], b = state->h[1], c = state->h[2], d = state->h[3];
+    uint32_t e = state->h[4], f = state->h[5], g = state->h[6], h = state->h[7];
+    for (int i = 0; i < 64; i++) {
+        uint32_t s1 = rotr32(e, 6) ^ rotr32(e, 11) ^ rotr32(e, 25);
+        uint32_t ch = (e & f) ^ (~e & g);
+        uint32_t t1 = h + s1 + ch + sha256_k[i] + w[i];
+        uint32_t s0 = rotr32(a, 2) ^ rotr32(a, 13) ^ rotr32(a, 22);
+        uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+        uint32_t t2 = s0 + maj;
+        h = g; g = f; f = e; e = d + t1;
+        d = c; c = b; b = a; a = t1 + t2;
+    }
+    state->h[0] += a; state->h[1] += b; state->h[2] += c; state->h[3] += d;
+    state->h[4] += e; state->h[5] += f; state->h[6] += g; state->h[7] += h;
+}
+
+static void sha256Update(void* opaque, const uint8_t* data, size_t len) {
+    SHA256State* state = (SHA256State*)opaque;
+    state->total_len += len;
+
+    if (state->buffered > 0) {
+        size_t fill = 64 - state->buffered;
+        if (len < fill) {
+            memcpy(state->block + state->buffered, data, len);
+            state->buffered += len;
+            return;
+        }
+        memcpy(state->block + state->buffered, data, fill);
+        sha256Block(state, state->block);
+        data += fill;
+        len -= fill;
+        state->buffered = 0;
+    }
+
+    for (; len >= 64; data += 64, len -= 64) {
+        sha256Block(state, data);
+    }
+
+    memcpy(state->block, data, len);
+    state->buffered = len;
+}
+
+static void sha256Final(SHA256State* state, uint8_t digest[32]) {
+    uint64_t bit_len = state->total_len * 8;
+    uint8_t pad[72] = { 0x80 };
+    size_t pad_len = (state->buffered < 56) ? (56 - state->buffered) : (120 - state->buffered);
+    for (int i = 0; i < 8; i++) {
+        pad[pad_len + i] = (uint8_t)(bit_len >> (56 - i * 8));
+    }
+    sha256Update(state, pad, pad_len + 8);
+
+    for (int i = 0; i < 8; i++) {
+        digest[i * 4] = (uint8_t)(state->h[i] >> 24);
+        digest[i * 4 + 1] = (uint8_t)(state->h[i] >> 16);
+        digest[i * 4 + 2] = (uint8_t)(state->h[i] >> 8);
+        digest[i * 4 + 3] = (uint8_t)state->h[i];
+    }
+}
+
+// =============================================================================
+// HASH NATIVES
+// =============================================================================
+
+ZymValue nativeHash_crc32(ZymVM* vm, ZymValue data) {
+    uint32_t crc = 0xffffffffu;
+    if (!feedBytes(data, crc32Update, &crc)) {
+        zym_runtimeError(vm, "crc32() requires a string or a list of bytes");
+        return ZYM_ERROR;
+    }
+    return zym_newNumber((double)(crc ^ 0xffffffffu));
+}
+
+ZymValue nativeHash_crc32c(ZymVM* vm, ZymValue data) {
+    uint32_t crc = 0xffffffffu;
+    if (!feedBytes(data, crc32cUpdate, &crc)) {
+        zym_runtimeError(vm, "crc32c() requires a string or a list of bytes");
+        return ZYM_ERROR;
+    }
+    return zym_newNumber((double)(crc ^ 0xffffffffu));
+}
+
+ZymValue nativeHash_fnv1a(ZymVM* vm, ZymValue data) {
+    uint32_t hash = 2166136261u;
+    if (!feedBytes(data, fnv1aUpdate, &hash)) {
+        zym_runtimeError(vm, "fnv1a() requires a string or a list of bytes");
+        return ZYM_ERROR;
+    }
+    return zym_newNumber((double)hash);
+}
+
+ZymValue nativeHash_xxhash64(ZymVM* vm, ZymValue data) {
+    XXH64State state;
+    xxh64Init(&state, 0);
+    if (!feedBytes(data, xxh64Update, &state)) {
+        zym_runtimeError(vm, "xxhash64() requires a string or a list of bytes");
+        return ZYM_ERROR;
+    }
+    uint64_t h = xxh64Digest(&state, 0);
+    uint8_t bytes[8];
+    for (int i = 0; i < 8; i++) {
+        bytes[i] = (uint8_t)(h >> (56 - i * 8));
+    }
+    return newHexString(vm, bytes, 8);
+}
+
+ZymValue nativeHash_sha256(ZymVM* vm, ZymValue data) {
+    SHA256State state;
+    sha256Init(&state);
+    if (!feedBytes(data, sha256Update, &state)) {
+        zym_runtimeError(vm, "sha256() requires a string or a list of bytes");
+        return ZYM_ERROR;
+    }
+    uint8_t digest[32];
+    sha256Final(&state, digest);
+    return newHexString(vm, digest, 32);
+}
+
+// =============================================================================
+// REGISTRATION
+// =============================================================================
+
+void registerHashNatives(VM* vm) {
+    zym_defineNative(vm, "crc32(data)", nativeHash_crc32);
+    zym_defineNative(vm, "crc32c(data)", nativeHash_crc32c);
+    zym_defineNative(vm, "fnv1a(data)", nativeHash_fnv1a);
+    zym_defineNative(vm, "xxhash64(data)", nativeHash_xxhash64);
+    zym_defineNative(vm, "sha256(data)", nativeHash_sha256);
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "../vm.h"
+#include "zym/zym.h"
+
+// Checksums, returned as numbers. data is a string or a list of byte values.
+ZymValue nativeHash_crc32(ZymVM* vm, ZymValue data);
+ZymValue nativeHash_crc32c(ZymVM* vm, ZymValue data);
+ZymValue nativeHash_fnv1a(ZymVM* vm, ZymValue data);
+
+// Wide hashes, returned as lowercase hex strings
+ZymValue nativeHash_xxhash64(ZymVM* vm, ZymValue data);
+ZymValue nativeHash_sha256(ZymVM* vm, ZymValue data);
+
+// Register hash natives into the VM
+void registerHashNatives(VM* vm);
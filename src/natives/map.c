@@ -1,6 +1,8 @@
 #include <stdio.h>
 #include <string.h>
 #include "map.h"
+#include "../object.h"
+#include "../table.h"
 
 // =============================================================================
 // MAP MANIPULATION FUNCTIONS
@@ -26,22 +28,46 @@ ZymValue nativeMap_isEmpty(ZymVM* vm, ZymValue map) {
     return zym_newBool(zym_mapSize(map) == 0);
 }
 
-// Helper structure for collecting keys
-typedef struct {
-    ZymVM* vm;
-    ZymValue list;
-    bool failed;
-} KeyCollector;
-
-// Callback for collecting keys
-static bool collectKeys(ZymVM* vm, const char* key, ZymValue val, void* userdata) {
-    KeyCollector* collector = (KeyCollector*)userdata;
-    ZymValue keyStr = zym_newString(vm, key);
-    if (!zym_listAppend(vm, collector->list, keyStr)) {
-        collector->failed = true;
-        return false; // Stop iteration
-    }
-    return true; // Continue iteration
+// Which part of each entry collectEntries puts in the result list
+typedef enum {
+    COLLECT_KEYS,
+    COLLECT_VALUES,
+    COLLECT_PAIRS
+} CollectPart;
+
+// Lists one element per map entry straight from the table. Keys are the
+// map's own interned strings, and the list is sized once up front.
+static ZymValue collectEntries(ZymVM* vm, ZymValue map, CollectPart part) {
+    Table* table = &AS_MAP(map)->table;
+
+    ZymValue list = zym_newList(vm);
+    zym_pushRoot(vm, list);
+    zym_listReserve(vm, list, table->count);
+    ValueArray* items = &AS_LIST(list)->items;
+
+    for (int i = 0; i < table->capacity; i++) {
+        Entry* entry = &table->entries[i];
+        if (entry->key == NULL) continue;
+
+        switch (part) {
+            case COLLECT_KEYS:
+                items->values[items->count++] = OBJ_VAL(entry->key);
+                break;
+            case COLLECT_VALUES:
+                items->values[items->count++] = entry->value;
+                break;
+            case COLLECT_PAIRS: {
+                // The key and value stay reachable through the map
+                ZymValue pair[2] = { OBJ_VAL(entry->key), entry->value };
+                ZymValue pairList = zym_newListFrom(vm, pair, 2);
+                items->values[items->count++] = pairList;
+                break;
+            }
+        }
+    }
+
+    zym_popRoot(vm);
+    return list;
 }
 
 // Get list of all keys in map
@@ -51,30 +77,7 @@ ZymValue nativeMap_keys(ZymVM* vm, ZymValue map) {
         return ZYM_ERROR;
     }
 
-    ZymValue keyList = zym_newList(vm);
-    zym_pushRoot(vm, keyList);
-
-    KeyCollector collector = { vm, keyList, false };
-    zym_mapForEach(vm, map, collectKeys, &collector);
-
-    zym_popRoot(vm);
-
-    if (collector.failed) {
-        zym_runtimeError(vm, "keys() failed to build key list");
-        return ZYM_ERROR;
-    }
-
-    return keyList;
-}
-
-// Callback for collecting values
-static bool collectValues(ZymVM* vm, const char* key, ZymValue val, void* userdata) {
-    KeyCollector* collector = (KeyCollector*)userdata;
-    if (!zym_listAppend(vm, collector->list, val)) {
-        collector->failed = true;
-        return false;
-    }
-    return true;
+    return collectEntries(vm, map, COLLECT_KEYS);
 }
 
 // Get list of all values in map
@@ -84,46 +87,7 @@ ZymValue nativeMap_values(ZymVM* vm, ZymValue map) {
         return ZYM_ERROR;
     }
 
-    ZymValue valueList = zym_newList(vm);
-    zym_pushRoot(vm, valueList);
-
-    KeyCollector collector = { vm, valueList, false };
-    zym_mapForEach(vm, map, collectValues, &collector);
-
-    zym_popRoot(vm);
-
-    if (collector.failed) {
-        zym_runtimeError(vm, "values() failed to build value list");
-        return ZYM_ERROR;
-    }
-
-    return valueList;
-}
-
-// Callback for collecting entries (key-value pairs)
-static bool collectEntries(ZymVM* vm, const char* key, ZymValue val, void* userdata) {
-    KeyCollector* collector = (KeyCollector*)userdata;
-
-    // Create a list with [key, value]
-    ZymValue entry = zym_newList(vm);
-    zym_pushRoot(vm, entry);  // Protect from GC
-
-    ZymValue keyStr = zym_newString(vm, key);
-
-    if (!zym_listAppend(vm, entry, keyStr) || !zym_listAppend(vm, entry, val)) {
-        zym_popRoot(vm);
-        collector->failed = true;
-        return false;
-    }
-
-    if (!zym_listAppend(vm, collector->list, entry)) {
-        zym_popRoot(vm);
-        collector->failed = true;
-        return false;
-    }
-
-    zym_popRoot(vm);
-    return true;
+    return collectEntries(vm, map, COLLECT_VALUES);
 }
 
 // Get list of all entries as [key, value] pairs
@@ -133,92 +97,129 @@ ZymValue nativeMap_entries(ZymVM* vm, ZymValue map) {
         return ZYM_ERROR;
     }
 
-    ZymValue entryList = zym_newList(vm);
-    zym_pushRoot(vm, entryList);
-
-    KeyCollector collector = { vm, entryList, false };
-    zym_mapForEach(vm, map, collectEntries, &collector);
-
-    zym_popRoot(vm);
-
-    if (collector.failed) {
-        zym_runtimeError(vm, "entries() failed to build entry list");
-        return ZYM_ERROR;
-    }
-
-    return entryList;
+    return collectEntries(vm, map, COLLECT_PAIRS);
 }
 
-// Clear all entries from map
+// Clear all entries from map, keeping its capacity for reuse
 ZymValue nativeMap_clear(ZymVM* vm, ZymValue map) {
     if (!zym_isMap(map)) {
         zym_runtimeError(vm, "clear() requires a map");
         return ZYM_ERROR;
     }
 
-    // Get all keys first
-    ZymValue keyList = zym_newList(vm);
-    zym_pushRoot(vm, keyList);
+    tableClear(&AS_MAP(map)->table);
+    return zym_newNull();
+}
 
-    KeyCollector collector = { vm, keyList, false };
-    zym_mapForEach(vm, map, collectKeys, &collector);
+// Merge source map into target map
+ZymValue nativeMap_merge(ZymVM* vm, ZymValue targetMap, ZymValue sourceMap) {
+    if (!zym_isMap(targetMap)) {
+        zym_runtimeError(vm, "merge() requires a map as first argument");
+        return ZYM_ERROR;
+    }
 
-    if (collector.failed) {
-        zym_popRoot(vm);
-        zym_runtimeError(vm, "clear() failed to collect keys");
+    if (!zym_isMap(sourceMap)) {
+        zym_runtimeError(vm, "merge() requires a map as second argument");
         return ZYM_ERROR;
     }
 
-    // Delete each key
-    int len = zym_listLength(keyList);
-    for (int i = 0; i < len; i++) {
-        ZymValue keyVal = zym_listGet(vm, keyList, i);
-        const char* key = zym_asCString(keyVal);
-        zym_mapDelete(vm, map, key);
+    tableAddAll(vm, &AS_MAP(sourceMap)->table, &AS_MAP(targetMap)->table);
+    return zym_newNull();
+}
+
+// Shallow copy of a map
+ZymValue nativeMap_clone(ZymVM* vm, ZymValue map) {
+    if (!zym_isMap(map)) {
+        zym_runtimeError(vm, "clone() requires a map");
+        return ZYM_ERROR;
     }
 
+    ZymValue copy = zym_newMap(vm);
+    zym_pushRoot(vm, copy);
+    tableAddAll(vm, &AS_MAP(map)->table, &AS_MAP(copy)->table);
     zym_popRoot(vm);
-    return zym_newNull();
+    return copy;
 }
 
-// Helper structure for merging
-typedef struct {
-    ZymVM* vm;
-    ZymValue targetMap;
-    bool failed;
-} MergeHelper;
-
-// Callback to copy entries
-static bool mergeCallback(ZymVM* vm, const char* key, ZymValue val, void* userdata) {
-    MergeHelper* helper = (MergeHelper*)userdata;
-    if (!zym_mapSet(vm, helper->targetMap, key, val)) {
-        helper->failed = true;
+// Checks that keys is a list of strings; name is the calling native
+static bool checkKeyList(ZymVM* vm, ZymValue map, ZymValue keys, const char* name) {
+    if (!zym_isMap(map)) {
+        zym_runtimeError(vm, "%s() requires a map as first argument", name);
         return false;
     }
+
+    if (!zym_isList(keys)) {
+        zym_runtimeError(vm, "%s() requires a list of keys as second argument", name);
+        return false;
+    }
+
+    ValueArray* items = &AS_LIST(keys)->items;
+    for (int i = 0; i < items->count; i++) {
+        if (!IS_STRING(items->values[i])) {
+            zym_runtimeError(vm, "%s() keys must be strings", name);
+            return false;
+        }
+    }
     return true;
 }
 
-// Merge source map into target map
-ZymValue nativeMap_merge(ZymVM* vm, ZymValue targetMap, ZymValue sourceMap) {
-    if (!zym_isMap(targetMap)) {
-        zym_runtimeError(vm, "merge() requires a map as first argument");
-        return ZYM_ERROR;
-    }
+// New map holding only the entries of map whose keys are listed
+ZymValue nativeMap_pick(ZymVM* vm, ZymValue map, ZymValue keys) {
+    if (!checkKeyList(vm, map, keys, "pick")) return ZYM_ERROR;
 
-    if (!zym_isMap(sourceMap)) {
-        zym_runtimeError(vm, "merge() requires a map as second argument");
-        return ZYM_ERROR;
+    ValueArray* items = &AS_LIST(keys)->items;
+    ZymValue result = zym_newMap(vm);
+    zym_pushRoot(vm, result);
+    Table* table = &AS_MAP(result)->table;
+    tableReserve(vm, table, items->count);
+
+    for (int i = 0; i < items->count; i++) {
+        ObjString* key = internString(vm, AS_STRING(items->values[i]));
+        Value value;
+        if (tableGet(&AS_MAP(map)->table, key, &value)) {
+            tableSet(vm, table, key, value);
+        }
     }
 
-    MergeHelper helper = { vm, targetMap, false };
-    zym_mapForEach(vm, sourceMap, mergeCallback, &helper);
+    zym_popRoot(vm);
+    return result;
+}
 
-    if (helper.failed) {
-        zym_runtimeError(vm, "merge() failed to merge maps");
-        return ZYM_ERROR;
+// Whether key appears in a list of string keys. Table keys are interned, so
+// only external strings in the list need a content compare.
+static bool keyListed(ValueArray* items, ObjString* key) {
+    for (int i = 0; i < items->count; i++) {
+        ObjString* listed = AS_STRING(items->values[i]);
+        if (listed == key) return true;
+        if (listed->is_external && listed->byte_length == key->byte_length &&
+            memcmp(listed->chars, key->chars, (size_t)key->byte_length) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// New map holding every entry of map except those whose keys are listed.
+// Kept entries are inserted into a fresh table rather than deleted from a
+// clone, so the result's count matches its entries.
+ZymValue nativeMap_omit(ZymVM* vm, ZymValue map, ZymValue keys) {
+    if (!checkKeyList(vm, map, keys, "omit")) return ZYM_ERROR;
+
+    ValueArray* items = &AS_LIST(keys)->items;
+    Table* source = &AS_MAP(map)->table;
+    ZymValue result = zym_newMap(vm);
+    zym_pushRoot(vm, result);
+    Table* table = &AS_MAP(result)->table;
+    tableReserve(vm, table, source->count);
+
+    for (int i = 0; i < source->capacity; i++) {
+        Entry* entry = &source->entries[i];
+        if (entry->key == NULL || keyListed(items, entry->key)) continue;
+        tableSet(vm, table, entry->key, entry->value);
     }
 
-    return zym_newNull();
+    zym_popRoot(vm);
+    return result;
 }
 
 // =============================================================================
@@ -233,4 +234,7 @@ void registerMapNatives(VM* vm) {
     zym_defineNative(vm, "entries(map)", nativeMap_entries);
     zym_defineNative(vm, "clear(map)", nativeMap_clear);
     zym_defineNative(vm, "merge(target, source)", nativeMap_merge);
+    zym_defineNative(vm, "clone(map)", nativeMap_clone);
+    zym_defineNative(vm, "pick(map, keys)", nativeMap_pick);
+    zym_defineNative(vm, "omit(map, keys)", nativeMap_omit);
 }
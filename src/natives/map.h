@@ -11,6 +11,9 @@ ZymValue nativeMap_values(ZymVM* vm, ZymValue map);
 ZymValue nativeMap_entries(ZymVM* vm, ZymValue map);
 ZymValue nativeMap_clear(ZymVM* vm, ZymValue map);
 ZymValue nativeMap_merge(ZymVM* vm, ZymValue targetMap, ZymValue sourceMap);
+ZymValue nativeMap_clone(ZymVM* vm, ZymValue map);
+ZymValue nativeMap_pick(ZymVM* vm, ZymValue map, ZymValue keys);
+ZymValue nativeMap_omit(ZymVM* vm, ZymValue map, ZymValue keys);
 
 // Register map natives into the VM
 void registerMapNatives(VM* vm);
@@ -409,6 +409,22 @@ ZymValue nativeMath_isFinite(ZymVM* vm, ZymValue value) {
 
 // Linear interpolation
 ZymValue nativeMath_lerp(ZymVM* vm, ZymValue start, ZymValue end, ZymValue t) {
+    // Vectors interpolate component-wise
+    if (zym_isVec(start) && zym_isVec(end) && zym_isNumber(t)) {
+        int size = zym_vecSize(start);
+        if (zym_vecSize(end) != size) {
+            zym_runtimeError(vm, "lerp() requires vectors of the same size");
+            return ZYM_ERROR;
+        }
+        const double* a = zym_vecComponents(start);
+        const double* b = zym_vecComponents(end);
+        double factor = zym_asNumber(t);
+        double comps[4];
+        for (int i = 0; i < size; i++) {
+            comps[i] = a[i] + factor * (b[i] - a[i]);
+        }
+        return zym_newVec(vm, size, comps);
+    }
     if (!zym_isNumber(start) || !zym_isNumber(end) || !zym_isNumber(t)) {
         zym_runtimeError(vm, "lerp() requires three number arguments");
         return ZYM_ERROR;
@@ -0,0 +1,328 @@
+#include <string.h>
+#include <math.h>
+#include "pack.h"
+#include "../object.h"
+#include "../memory.h"
+#include "../gc.h"
+
+// =============================================================================
+// FORMAT COMPILATION
+// =============================================================================
+
+static int codeWidth(char code) {
+    switch (code) {
+        case 'x': case 'b': case 'B': case '?': case 's': return 1;
+        case 'h': case 'H': return 2;
+        case 'i': case 'I': case 'f': return 4;
+        case 'q': case 'Q': case 'd': return 8;
+        default: return 0;
+    }
+}
+
+// Compile a format string into field runs. Returns NULL (with a runtime error
+// raised) when the format is malformed.
+static PackPlan* compilePackPlan(VM* vm, const char* fn, ObjString* format) {
+    const char* chars = format->chars;
+    int length = format->byte_length;
+    int i = 0;
+
+    bool big_endian = false;
+    if (length > 0 && (chars[0] == '<' || chars[0] == '>' || chars[0] == '!')) {
+        big_endian = chars[0] != '<';
+        i++;
+    }
+
+    PackPlan* plan = (PackPlan*)reallocate(vm, NULL, 0, PACK_PLAN_SIZE(length));
+    int count = 0;
+    long byte_size = 0;
+    long value_count = 0;
+
+    while (i < length) {
+        char c = chars[i];
+        if (c == ' ' || c == '\t' || c == '\n' || c == '\r') {
+            i++;
+            continue;
+        }
+
+        long repeat = 1;
+        if (c >= '0' && c <= '9') {
+            repeat = 0;
+            while (i < length && chars[i] >= '0' && chars[i] <= '9') {
+                repeat = repeat * 10 + (chars[i] - '0');
+                if (repeat > 0xFFFFFF) break;
+                i++;
+            }
+            if (i >= length || repeat > 0xFFFFFF) {
+                zym_runtimeError(vm, "%s() format has a repeat count with no code", fn);
+                reallocate(vm, plan, PACK_PLAN_SIZE(length), 0);
+                return NULL;
+            }
+            c = chars[i];
+        }
+
+        int width = codeWidth(c);
+        if (width == 0) {
+            zym_runtimeError(vm, "%s() format has unknown code '%c'", fn, c);
+            reallocate(vm, plan, PACK_PLAN_SIZE(length), 0);
+            return NULL;
+        }
+        i++;
+        if (repeat == 0) continue;
+
+        plan->steps[count++] = (PackStep){c, (uint8_t)width, (int)repeat};
+        byte_size += (long)width * repeat;
+        if (c == 's') {
+            value_count++;
+        } else if (c != 'x') {
+            value_count += repeat;
+        }
+        if (byte_size > 0x7FFFFFFF) {
+            zym_runtimeError(vm, "%s() format describes more than 2GB", fn);
+            reallocate(vm, plan, PACK_PLAN_SIZE(length), 0);
+            return NULL;
+        }
+    }
+
+    // Shrink to the exact step count so freeObject can size the block
+    plan = (PackPlan*)reallocate(vm, plan, PACK_PLAN_SIZE(length), PACK_PLAN_SIZE(count));
+    plan->big_endian = big_endian;
+    plan->step_count = count;
+    plan->byte_size = (int)byte_size;
+    plan->value_count = (int)value_count;
+    return plan;
+}
+
+static PackPlan* planFor(VM* vm, const char* fn, ZymValue format) {
+    if (!zym_isString(format)) {
+        zym_runtimeError(vm, "%s() format must be a string", fn);
+        return NULL;
+    }
+    ObjString* string = AS_STRING(format);
+    if (string->pack_plan == NULL) {
+        string->pack_plan = compilePackPlan(vm, fn, string);
+    }
+    return string->pack_plan;
+}
+
+// =============================================================================
+// FIELD ENCODING
+// =============================================================================
+
+static void writeUint(uint8_t* out, uint64_t bits, int width, bool big_endian) {
+    for (int i = 0; i < width; i++) {
+        int shift = big_endian ? (width - 1 - i) * 8 : i * 8;
+        out[i] = (uint8_t)(bits >> shift);
+    }
+}
+
+static uint64_t readUint(const uint8_t* in, int width, bool big_endian) {
+    uint64_t bits = 0;
+    for (int i = 0; i < width; i++) {
+        int shift = big_endian ? (width - 1 - i) * 8 : i * 8;
+        bits |= (uint64_t)in[i] << shift;
+    }
+    return bits;
+}
+
+static bool packField(ZymVM* vm, char code, int width, ZymValue val, int argIndex,
+                      bool big_endian, uint8_t* out) {
+    if (code == '?') {
+        if (!zym_isBool(val)) {
+            zym_runtimeError(vm, "pack() argument %d for '?' expects bool, got %s", argIndex, zym_typeName(val));
+            return false;
+        }
+        out[0] = zym_asBool(val) ? 1 : 0;
+        return true;
+    }
+
+    if (!zym_isNumber(val)) {
+        zym_runtimeError(vm, "pack() argument %d for '%c' expects number, got %s", argIndex, code, zym_typeName(val));
+        return false;
+    }
+    double num = zym_asNumber(val);
+
+    if (code == 'f') {
+        float f = (float)num;
+        uint32_t bits;
+        memcpy(&bits, &f, sizeof(bits));
+        writeUint(out, bits, 4, big_endian);
+        return true;
+    }
+    if (code == 'd') {
+        uint64_t bits;
+        memcpy(&bits, &num, sizeof(bits));
+        writeUint(out, bits, 8, big_endian);
+        return true;
+    }
+
+    // Integers: exact values within the field's range only
+    bool is_signed = code >= 'a' && code <= 'z';
+    double limit = ldexp(1.0, width * 8 - (is_signed ? 1 : 0));
+    double low = is_signed ? -limit : 0.0;
+    if (num != floor(num) || num < low || num >= limit) {
+        zym_runtimeError(vm, "pack() argument %d is out of range for '%c'", argIndex, code);
+        return false;
+    }
+    uint64_t bits = is_signed ? (uint64_t)(int64_t)num : (uint64_t)num;
+    writeUint(out, bits, width, big_endian);
+    return true;
+}
+
+static ZymValue unpackField(char code, int width, const uint8_t* in, bool big_endian) {
+    uint64_t bits = readUint(in, width, big_endian);
+    switch (code) {
+        case '?':
+            return zym_newBool(bits != 0);
+        case 'f': {
+            uint32_t bits32 = (uint32_t)bits;
+            float f;
+            memcpy(&f, &bits32, sizeof(f));
+            return zym_newNumber((double)f);
+        }
+        case 'd': {
+            double d;
+            memcpy(&d, &bits, sizeof(d));
+            return zym_newNumber(d);
+        }
+        default:
+            break;
+    }
+
+    if (code >= 'a' && code <= 'z' && width < 8) {
+        // Sign-extend from the field width
+        uint64_t sign = (uint64_t)1 << (width * 8 - 1);
+        return zym_newNumber((double)(int64_t)((bits ^ sign) - sign));
+    }
+    if (code >= 'a' && code <= 'z') {
+        return zym_newNumber((double)(int64_t)bits);
+    }
+    return zym_newNumber((double)bits);
+}
+
+// =============================================================================
+// PACK NATIVES
+// =============================================================================
+
+#define PACK_STACK_BYTES 256
+
+ZymValue nativePack_pack(ZymVM* vm, ZymValue format, ZymValue* vargs, int vargc) {
+    PackPlan* plan = planFor(vm, "pack", format);
+    if (plan == NULL) return ZYM_ERROR;
+
+    if (vargc != plan->value_count) {
+        zym_runtimeError(vm, "pack() format expects %d values, got %d", plan->value_count, vargc);
+        return ZYM_ERROR;
+    }
+
+    uint8_t stack_bytes[PACK_STACK_BYTES];
+    uint8_t* bytes = stack_bytes;
+    if (plan->byte_size > PACK_STACK_BYTES) {
+        bytes = ALLOCATE(vm, uint8_t, plan->byte_size);
+    }
+
+    uint8_t* out = bytes;
+    int arg = 0;
+    bool ok = true;
+    for (int i = 0; i < plan->step_count && ok; i++) {
+        PackStep* step = &plan->steps[i];
+        if (step->code == 'x') {
+            memset(out, 0, step->count);
+            out += step->count;
+        } else if (step->code == 's') {
+            const char* chars;
+            int byte_length;
+            if (!zym_toStringBytes(vargs[arg], &chars, &byte_length)) {
+                zym_runtimeError(vm, "pack() argument %d for 's' expects string, got %s", arg + 1, zym_typeName(vargs[arg]));
+                ok = false;
+                break;
+            }
+            int copied = byte_length < step->count ? byte_length : step->count;
+            memcpy(out, chars, copied);
+            memset(out + copied, 0, step->count - copied);
+            out += step->count;
+            arg++;
+        } else {
+            for (int r = 0; r < step->count; r++) {
+                if (!packField(vm, step->code, step->width, vargs[arg], arg + 1, plan->big_endian, out)) {
+                    ok = false;
+                    break;
+                }
+                out += step->width;
+                arg++;
+            }
+        }
+    }
+
+    ZymValue result = ok ? zym_newStringN(vm, (const char*)bytes, plan->byte_size) : ZYM_ERROR;
+    if (bytes != stack_bytes) {
+        FREE_ARRAY(vm, uint8_t, bytes, plan->byte_size);
+    }
+    return result;
+}
+
+ZymValue nativePack_unpackAt(ZymVM* vm, ZymValue format, ZymValue data, ZymValue offset) {
+    PackPlan* plan = planFor(vm, "unpack", format);
+    if (plan == NULL) return ZYM_ERROR;
+
+    const char* chars;
+    int byte_length;
+    if (!zym_toStringBytes(data, &chars, &byte_length)) {
+        zym_runtimeError(vm, "unpack() data must be a string");
+        return ZYM_ERROR;
+    }
+    if (!zym_isNumber(offset) || zym_asNumber(offset) < 0 ||
+        zym_asNumber(offset) != floor(zym_asNumber(offset))) {
+        zym_runtimeError(vm, "unpack() offset must be a non-negative integer");
+        return ZYM_ERROR;
+    }
+    double start = zym_asNumber(offset);
+    if (start + plan->byte_size > byte_length) {
+        zym_runtimeError(vm, "unpack() needs %d bytes at offset %.0f, data has %d",
+                         plan->byte_size, start, byte_length);
+        return ZYM_ERROR;
+    }
+
+    ZymValue list = zym_newList(vm);
+    pushTempRoot(vm, AS_OBJ(list));
+    zym_listReserve(vm, list, plan->value_count);
+
+    const uint8_t* in = (const uint8_t*)chars + (int)start;
+    for (int i = 0; i < plan->step_count; i++) {
+        PackStep* step = &plan->steps[i];
+        if (step->code == 'x') {
+            in += step->count;
+        } else if (step->code == 's') {
+            zym_listAppend(vm, list, zym_newStringN(vm, (const char*)in, step->count));
+            in += step->count;
+        } else {
+            for (int r = 0; r < step->count; r++) {
+                zym_listAppend(vm, list, unpackField(step->code, step->width, in, plan->big_endian));
+                in += step->width;
+            }
+        }
+    }
+
+    popTempRoot(vm);
+    return list;
+}
+
+ZymValue nativePack_unpack(ZymVM* vm, ZymValue format, ZymValue data) {
+    return nativePack_unpackAt(vm, format, data, zym_newNumber(0));
+}
+
+ZymValue nativePack_packSize(ZymVM* vm, ZymValue format) {
+    PackPlan* plan = planFor(vm, "packSize", format);
+    if (plan == NULL) return ZYM_ERROR;
+    return zym_newNumber((double)plan->byte_size);
+}
+
+// =============================================================================
+// REGISTRATION
+// =============================================================================
+
+void registerPackNatives(VM* vm) {
+    zym_defineNativeVariadic(vm, "pack(format, ...)", nativePack_pack);
+    zym_defineNative(vm, "unpack(format, data)", nativePack_unpack);
+    zym_defineNative(vm, "unpack(format, data, offset)", nativePack_unpackAt);
+    zym_defineNative(vm, "packSize(format)", nativePack_packSize);
+}
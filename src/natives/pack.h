@@ -0,0 +1,16 @@
+#pragma once
+
+#include "../vm.h"
+#include "zym/zym.h"
+
+// Binary packing, struct-style. A format is an optional byte order ('<' little,
+// the default; '>' or '!' big) followed by codes with optional repeat counts:
+//   x pad byte   b/B i8/u8   h/H i16/u16   i/I i32/u32   q/Q i64/u64
+//   f f32   d f64   ? bool   Ns N-byte string (zero padded)
+ZymValue nativePack_pack(ZymVM* vm, ZymValue format, ZymValue* vargs, int vargc);
+ZymValue nativePack_unpack(ZymVM* vm, ZymValue format, ZymValue data);
+ZymValue nativePack_unpackAt(ZymVM* vm, ZymValue format, ZymValue data, ZymValue offset);
+ZymValue nativePack_packSize(ZymVM* vm, ZymValue format);
+
+// Register pack natives into the VM
+void registerPackNatives(VM* vm);
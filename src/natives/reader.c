@@ -0,0 +1,279 @@
+#include <string.h>
+#include <math.h>
+#include "reader.h"
+#include "../object.h"
+#include "../memory.h"
+#include "../gc.h"
+
+// =============================================================================
+// BUFFERING
+// =============================================================================
+
+int64_t readerRefill(ZymVM* vm, Reader* reader, const char* fn) {
+    if (reader->eof) return 0;
+
+    if (reader->start > 0) {
+        memmove(reader->buffer, reader->buffer + reader->start, reader->end - reader->start);
+        reader->end -= reader->start;
+        reader->start = 0;
+    }
+    if (reader->end == reader->capacity) return 0;
+
+    int64_t got = reader->callbacks.read(reader->ctx, reader->buffer + reader->end, reader->capacity - reader->end);
+    if (got < 0) {
+        zym_runtimeError(vm, "%s() failed reading from the host stream", fn);
+        return -1;
+    }
+    if (got == 0) {
+        reader->eof = true;
+        return 0;
+    }
+    reader->end += (size_t)got;
+    return got;
+}
+
+void readerGrow(ZymVM* vm, Reader* reader) {
+    size_t capacity = reader->capacity * 2;
+    reader->buffer = (char*)reallocate(vm, reader->buffer, reader->capacity, capacity);
+    reader->capacity = capacity;
+}
+
+// Bytes that span more than one buffer fill are collected here
+typedef struct {
+    char* chars;
+    size_t length;
+    size_t capacity;
+} Scratch;
+
+static void scratchAppend(ZymVM* vm, Scratch* scratch, const char* chars, size_t length) {
+    if (length == 0) return;
+    if (scratch->length + length > scratch->capacity) {
+        size_t old_capacity = scratch->capacity;
+        size_t capacity = old_capacity < 256 ? 256 : old_capacity * 2;
+        while (capacity < scratch->length + length) capacity *= 2;
+        scratch->chars = (char*)reallocate(vm, scratch->chars, old_capacity, capacity);
+        scratch->capacity = capacity;
+    }
+    memcpy(scratch->chars + scratch->length, chars, length);
+    scratch->length += length;
+}
+
+static ZymValue scratchTake(ZymVM* vm, Scratch* scratch) {
+    ZymValue result = zym_newStringN(vm, scratch->chars, (int)scratch->length);
+    FREE_ARRAY(vm, char, scratch->chars, scratch->capacity);
+    return result;
+}
+
+static const char* findBytes(const char* haystack, size_t length, const char* needle, size_t needle_length) {
+    if (needle_length > length) return NULL;
+    const char* last = haystack + (length - needle_length);
+    for (const char* p = haystack; p <= last; p++) {
+        p = memchr(p, needle[0], (size_t)(last - p) + 1);
+        if (p == NULL) return NULL;
+        if (memcmp(p, needle, needle_length) == 0) return p;
+    }
+    return NULL;
+}
+
+// Consume bytes up to and including delim; the result excludes delim. A
+// delimiter that straddles two fills is found because the tail that could
+// start it stays in the buffer across the refill.
+static ZymValue readUntilDelim(ZymVM* vm, Reader* reader, const char* fn,
+                               const char* delim, size_t delim_length, bool strip_cr) {
+    Scratch scratch = {NULL, 0, 0};
+    const char* hit = NULL;
+
+    for (;;) {
+        const char* data = reader->buffer + reader->start;
+        size_t available = reader->end - reader->start;
+        hit = findBytes(data, available, delim, delim_length);
+        if (hit != NULL) break;
+
+        size_t keep = available < delim_length - 1 ? available : delim_length - 1;
+        scratchAppend(vm, &scratch, data, available - keep);
+        reader->start += available - keep;
+
+        int64_t got = readerRefill(vm, reader, fn);
+        if (got < 0) {
+            FREE_ARRAY(vm, char, scratch.chars, scratch.capacity);
+            return ZYM_ERROR;
+        }
+        if (got == 0) break;
+    }
+
+    const char* data = reader->buffer + reader->start;
+    size_t length = hit != NULL ? (size_t)(hit - data) : reader->end - reader->start;
+    reader->start += length + (hit != NULL ? delim_length : 0);
+
+    if (hit == NULL && length == 0 && scratch.length == 0) {
+        return zym_newNull();
+    }
+
+    // Common case: the whole piece sits in the buffer, no scratch copy needed
+    if (scratch.length == 0) {
+        if (strip_cr && length > 0 && data[length - 1] == '\r') length--;
+        return zym_newStringN(vm, data, (int)length);
+    }
+
+    scratchAppend(vm, &scratch, data, length);
+    if (strip_cr && scratch.chars[scratch.length - 1] == '\r') scratch.length--;
+    return scratchTake(vm, &scratch);
+}
+
+// =============================================================================
+// READER METHODS
+// =============================================================================
+
+static ZymValue reader_readLine(ZymVM* vm, ZymValue self) {
+    Reader* reader = (Reader*)zym_userdataPayload(self);
+    return readUntilDelim(vm, reader, "readLine", "\n", 1, true);
+}
+
+static ZymValue reader_readUntil(ZymVM* vm, ZymValue self, ZymValue delim) {
+    Reader* reader = (Reader*)zym_userdataPayload(self);
+
+    const char* chars;
+    int length;
+    if (!zym_toStringBytes(delim, &chars, &length) || length == 0) {
+        zym_runtimeError(vm, "readUntil() delimiter must be a non-empty string");
+        return ZYM_ERROR;
+    }
+    if ((size_t)length >= reader->capacity) {
+        zym_runtimeError(vm, "readUntil() delimiter is longer than the reader's buffer");
+        return ZYM_ERROR;
+    }
+    return readUntilDelim(vm, reader, "readUntil", chars, (size_t)length, false);
+}
+
+static ZymValue reader_readBytes(ZymVM* vm, ZymValue self, ZymValue count) {
+    Reader* reader = (Reader*)zym_userdataPayload(self);
+
+    if (!zym_isNumber(count) || zym_asNumber(count) < 0 ||
+        zym_asNumber(count) != floor(zym_asNumber(count)) || zym_asNumber(count) > 0x7FFFFFFF) {
+        zym_runtimeError(vm, "readBytes() count must be a non-negative integer");
+        return ZYM_ERROR;
+    }
+    size_t wanted = (size_t)zym_asNumber(count);
+
+    if (reader->end - reader->start < wanted && reader->end - reader->start < reader->capacity) {
+        if (readerRefill(vm, reader, "readBytes") < 0) return ZYM_ERROR;
+    }
+
+    size_t available = reader->end - reader->start;
+    if (available >= wanted) {
+        const char* data = reader->buffer + reader->start;
+        reader->start += wanted;
+        return zym_newStringN(vm, data, (int)wanted);
+    }
+
+    Scratch scratch = {NULL, 0, 0};
+    while (scratch.length < wanted) {
+        size_t take = reader->end - reader->start;
+        if (take > wanted - scratch.length) take = wanted - scratch.length;
+        scratchAppend(vm, &scratch, reader->buffer + reader->start, take);
+        reader->start += take;
+        if (scratch.length == wanted) break;
+
+        int64_t got = readerRefill(vm, reader, "readBytes");
+        if (got < 0) {
+            FREE_ARRAY(vm, char, scratch.chars, scratch.capacity);
+            return ZYM_ERROR;
+        }
+        if (got == 0) break;
+    }
+
+    if (scratch.length == 0 && wanted > 0) {
+        return zym_newNull();
+    }
+    return scratchTake(vm, &scratch);
+}
+
+static ZymValue reader_peek(ZymVM* vm, ZymValue self) {
+    Reader* reader = (Reader*)zym_userdataPayload(self);
+
+    if (reader->start == reader->end && readerRefill(vm, reader, "peek") < 0) {
+        return ZYM_ERROR;
+    }
+    if (reader->start == reader->end) {
+        return zym_newNull();
+    }
+    return zym_newStringN(vm, reader->buffer + reader->start, 1);
+}
+
+static ZymValue reader_seek(ZymVM* vm, ZymValue self, ZymValue offset) {
+    Reader* reader = (Reader*)zym_userdataPayload(self);
+
+    if (reader->callbacks.seek == NULL) {
+        zym_runtimeError(vm, "seek() is not supported by this reader");
+        return ZYM_ERROR;
+    }
+    if (!zym_isNumber(offset) || zym_asNumber(offset) < 0 ||
+        zym_asNumber(offset) != floor(zym_asNumber(offset))) {
+        zym_runtimeError(vm, "seek() offset must be a non-negative integer");
+        return ZYM_ERROR;
+    }
+
+    int64_t position = reader->callbacks.seek(reader->ctx, (int64_t)zym_asNumber(offset));
+    if (position < 0) {
+        zym_runtimeError(vm, "seek() failed on the host stream");
+        return ZYM_ERROR;
+    }
+
+    // Buffered bytes belong to the old position
+    reader->start = 0;
+    reader->end = 0;
+    reader->eof = false;
+    return zym_newNumber((double)position);
+}
+
+// =============================================================================
+// READER TYPE
+// =============================================================================
+
+// Runs on the VM thread when the reader is collected
+static void finalizeReader(ZymVM* vm, void* payload) {
+    Reader* reader = (Reader*)payload;
+    if (reader->callbacks.close != NULL) {
+        reader->callbacks.close(reader->ctx);
+    }
+    FREE_ARRAY(vm, char, reader->buffer, reader->capacity);
+}
+
+static const ZymMethod reader_methods[] = {
+    { "readLine()",         reader_readLine },
+    { "readBytes(count)",   reader_readBytes },
+    { "readUntil(delim)",   reader_readUntil },
+    { "peek()",             reader_peek },
+    { "seek(offset)",       reader_seek },
+};
+
+Value newReaderValue(VM* vm, const ZymReaderCallbacks* callbacks, void* ctx, size_t buffer_size) {
+    // The payload starts zeroed, so the finalizer copes with a failed buffer allocation
+    Value value = zym_newUserdata(vm, OBJ_VAL(vm->reader_type), sizeof(Reader));
+    pushTempRoot(vm, AS_OBJ(value));
+    Reader* reader = (Reader*)zym_userdataPayload(value);
+    reader->callbacks = *callbacks;
+    reader->ctx = ctx;
+    reader->buffer = ALLOCATE(vm, char, buffer_size);
+    reader->capacity = buffer_size;
+    popTempRoot(vm);
+    return value;
+}
+
+Reader* readerFromValue(Value value) {
+    // Readers are the only userdata finalized by finalizeReader, so no VM is needed to tell them apart
+    if (!IS_USERDATA(value) || AS_USERDATA(value)->finalizer != finalizeReader) {
+        return NULL;
+    }
+    return (Reader*)AS_USERDATA(value)->payload;
+}
+
+// =============================================================================
+// REGISTRATION
+// =============================================================================
+
+void registerReaderType(VM* vm) {
+    ZymValue type = zym_newUserdataType(vm, "Reader", reader_methods,
+                                        (int)(sizeof(reader_methods) / sizeof(reader_methods[0])), finalizeReader);
+    vm->reader_type = AS_USERDATA_TYPE(type);
+}
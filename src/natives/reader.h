@@ -0,0 +1,38 @@
+#pragma once
+
+#include "../vm.h"
+#include "../object.h"
+#include "zym/zym.h"
+
+#define READER_DEFAULT_BUFFER (64 * 1024)
+#define READER_MIN_BUFFER 256
+
+// Payload of a "Reader" userdata wrapping a host byte stream. Bytes
+// [start, end) of buffer are read from the host but not yet consumed.
+typedef struct {
+    ZymReaderCallbacks callbacks;   // seek and close are optional
+    void* ctx;
+    char* buffer;
+    size_t capacity;
+    size_t start;
+    size_t end;
+    bool eof;
+} Reader;
+
+// Create a reader over ctx with a buffer_size byte refill buffer
+Value newReaderValue(VM* vm, const ZymReaderCallbacks* callbacks, void* ctx, size_t buffer_size);
+
+// Payload of value if it is a reader, else NULL
+Reader* readerFromValue(Value value);
+
+// Move unconsumed bytes to the front of the buffer and read more after them.
+// Returns the number of bytes added, 0 at end of stream or when the buffer is
+// full, or -1 after raising a runtime error.
+int64_t readerRefill(ZymVM* vm, Reader* reader, const char* fn);
+
+// Double the buffer, for callers that need a whole record buffered at once
+void readerGrow(ZymVM* vm, Reader* reader);
+
+// Create the Reader userdata type (methods readLine, readBytes, readUntil,
+// peek and seek; each read returns null at end of stream)
+void registerReaderType(VM* vm);
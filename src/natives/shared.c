@@ -1,23 +1,194 @@
 #include <stdio.h>
 #include <string.h>
+#include <limits.h>
 #include "shared.h"
+#include "vec.h"
+#include "../object.h"
 #include "../utf8.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define ZYM_SEARCH_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define ZYM_SEARCH_NEON 1
+#endif
+
 // =============================================================================
 // SHARED FUNCTIONS (work with both lists and strings)
 // =============================================================================
 
-// Helper function to compare two ZymValues for equality
-static bool valuesEqual(ZymVM* vm, ZymValue a, ZymValue b) {
-    // Check if same type
-    if (zym_isNull(a) && zym_isNull(b)) return true;
-    if (zym_isBool(a) && zym_isBool(b)) return zym_asBool(a) == zym_asBool(b);
-    if (zym_isNumber(a) && zym_isNumber(b)) return zym_asNumber(a) == zym_asNumber(b);
-    if (zym_isString(a) && zym_isString(b)) return strcmp(zym_asCString(a), zym_asCString(b)) == 0;
-    return a == b;
+// Content equality used when a list search cannot compare raw values.
+// Numbers follow IEEE rules (NaN never matches, -0 matches 0); vecs compare
+// componentwise; interned strings, enums, booleans and other objects compare
+// by identity and only external strings need their bytes compared.
+static bool valuesEqual(Value a, Value b) {
+    if (IS_DOUBLE(a) && IS_DOUBLE(b)) return AS_DOUBLE(a) == AS_DOUBLE(b);
+    if (a == b) return true;
+    if (IS_STRING(a) && IS_STRING(b)) {
+        ObjString* x = AS_STRING(a);
+        ObjString* y = AS_STRING(b);
+        if (!x->is_external && !y->is_external) return false;
+        return x->byte_length == y->byte_length &&
+               memcmp(x->chars, y->chars, x->byte_length) == 0;
+    }
+    if (IS_VEC(a) && IS_VEC(b)) {
+        ObjVec* x = AS_VEC(a);
+        ObjVec* y = AS_VEC(b);
+        if (x->size != y->size) return false;
+        for (int i = 0; i < x->size; i++) {
+            if (x->comps[i] != y->comps[i]) return false;
+        }
+        return true;
+    }
+    return false;
+}
+
+// How a list element is matched against a search needle.
+typedef enum {
+    MATCH_NOTHING,  // NaN equals no element
+    MATCH_BITS,     // element equals pattern or alternate bit for bit
+    MATCH_CONTENT,  // vec needle, or external strings alive: fall back to valuesEqual
+} MatchKind;
+
+// Reduce a needle to at most two raw patterns. Zero also matches its
+// negatively signed twin; every other value matches exactly its own bits.
+static MatchKind prepareNeedle(VM* vm, Value needle, Value* pattern, Value* alternate) {
+    *pattern = needle;
+    *alternate = needle;
+    if (IS_DOUBLE(needle)) {
+        double number = AS_DOUBLE(needle);
+        if (number != number) return MATCH_NOTHING;
+        if (number == 0) {
+            *pattern = DOUBLE_VAL(0.0);
+            *alternate = DOUBLE_VAL(-0.0);
+        }
+        return MATCH_BITS;
+    }
+    if (IS_STRING(needle) && vm->live_external_strings > 0) return MATCH_CONTENT;
+    if (IS_VEC(needle)) return MATCH_CONTENT;
+    return MATCH_BITS;
+}
+
+// Bit i is set when values[i] equals either pattern, for the four values at p.
+static inline unsigned matchBlock(const Value* p, Value pattern, Value alternate) {
+#if defined(ZYM_SEARCH_SSE2)
+    // SSE2 has no 64-bit compare: a lane matches when both of its halves do
+    const __m128i vpattern = _mm_set1_epi64x((long long)pattern);
+    const __m128i valternate = _mm_set1_epi64x((long long)alternate);
+    unsigned mask = 0;
+    for (int half = 0; half < 2; half++) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(p + half * 2));
+        __m128i eq = _mm_cmpeq_epi32(v, vpattern);
+        eq = _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)));
+        __m128i alt = _mm_cmpeq_epi32(v, valternate);
+        alt = _mm_and_si128(alt, _mm_shuffle_epi32(alt, _MM_SHUFFLE(2, 3, 0, 1)));
+        mask |= (unsigned)_mm_movemask_pd(_mm_castsi128_pd(_mm_or_si128(eq, alt))) << (half * 2);
+    }
+    return mask;
+#elif defined(ZYM_SEARCH_NEON)
+    const uint64x2_t vpattern = vdupq_n_u64(pattern);
+    const uint64x2_t valternate = vdupq_n_u64(alternate);
+    unsigned mask = 0;
+    for (int half = 0; half < 2; half++) {
+        uint64x2_t v = vld1q_u64((const uint64_t*)(p + half * 2));
+        uint64x2_t eq = vorrq_u64(vceqq_u64(v, vpattern), vceqq_u64(v, valternate));
+        mask |= (unsigned)((vgetq_lane_u64(eq, 0) & 1) | (vgetq_lane_u64(eq, 1) & 2)) << (half * 2);
+    }
+    return mask;
+#else
+    unsigned mask = 0;
+    for (int lane = 0; lane < 4; lane++) {
+        if (p[lane] == pattern || p[lane] == alternate) mask |= 1u << lane;
+    }
+    return mask;
+#endif
+}
+
+// First index in [from, to) holding the needle, or -1.
+static int listFind(VM* vm, const ValueArray* items, Value needle, int from, int to) {
+    Value pattern, alternate;
+    MatchKind kind = prepareNeedle(vm, needle, &pattern, &alternate);
+    const Value* values = items->values;
+    int i = from;
+
+    if (kind == MATCH_NOTHING) return -1;
+    if (kind == MATCH_CONTENT) {
+        for (; i < to; i++) {
+            if (valuesEqual(values[i], needle)) return i;
+        }
+        return -1;
+    }
+
+    for (; to - i >= 4; i += 4) {
+        unsigned mask = matchBlock(values + i, pattern, alternate);
+        if (mask != 0) {
+            while (!(mask & 1)) { mask >>= 1; i++; }
+            return i;
+        }
+    }
+    for (; i < to; i++) {
+        if (values[i] == pattern || values[i] == alternate) return i;
+    }
+    return -1;
+}
+
+// Last index in [0, to) holding the needle, or -1.
+static int listFindLast(VM* vm, const ValueArray* items, Value needle, int to) {
+    Value pattern, alternate;
+    MatchKind kind = prepareNeedle(vm, needle, &pattern, &alternate);
+    const Value* values = items->values;
+    int i = to;
+
+    if (kind == MATCH_NOTHING) return -1;
+    if (kind == MATCH_CONTENT) {
+        while (i-- > 0) {
+            if (valuesEqual(values[i], needle)) return i;
+        }
+        return -1;
+    }
+
+    for (; i >= 4; i -= 4) {
+        unsigned mask = matchBlock(values + i - 4, pattern, alternate);
+        if (mask != 0) {
+            int lane = 3;
+            while (!(mask & (1u << lane))) lane--;
+            return i - 4 + lane;
+        }
+    }
+    while (i-- > 0) {
+        if (values[i] == pattern || values[i] == alternate) return i;
+    }
+    return -1;
+}
+
+// Number of elements equal to the needle.
+static int listCount(VM* vm, const ValueArray* items, Value needle) {
+    Value pattern, alternate;
+    MatchKind kind = prepareNeedle(vm, needle, &pattern, &alternate);
+    const Value* values = items->values;
+    int count = 0;
+    int i = 0;
+
+    if (kind == MATCH_NOTHING) return 0;
+    if (kind == MATCH_CONTENT) {
+        for (; i < items->count; i++) {
+            if (valuesEqual(values[i], needle)) count++;
+        }
+        return count;
+    }
+
+    for (; items->count - i >= 4; i += 4) {
+        unsigned mask = matchBlock(values + i, pattern, alternate);
+        count += (int)((mask & 1) + ((mask >> 1) & 1) + ((mask >> 2) & 1) + (mask >> 3));
+    }
+    for (; i < items->count; i++) {
+        if (values[i] == pattern || values[i] == alternate) count++;
+    }
+    return count;
 }
 
-// Get length of list or string
+// Get length of list or string, or the magnitude of a vector
 ZymValue nativeShared_length(ZymVM* vm, ZymValue value) {
     if (zym_isList(value)) {
         return zym_newNumber((double)zym_listLength(value));
@@ -25,8 +196,10 @@ ZymValue nativeShared_length(ZymVM* vm, ZymValue value) {
         int length;
         zym_toString(value, NULL, &length);
         return zym_newNumber((double)length);
+    } else if (zym_isVec(value)) {
+        return zym_newNumber(vecMagnitude(value));
     } else {
-        zym_runtimeError(vm, "length() requires a list or string");
+        zym_runtimeError(vm, "length() requires a list, string or vector");
         return ZYM_ERROR;
     }
 }
@@ -65,22 +238,21 @@ ZymValue nativeShared_concat(ZymVM* vm, ZymValue val1, ZymValue val2) {
     }
     // Both must be strings
     else if (zym_isString(val1) && zym_isString(val2)) {
-        const char* cstr1 = zym_asCString(val1);
-        const char* cstr2 = zym_asCString(val2);
-
-        char buffer[4096];
-        int len1 = strlen(cstr1);
-        int len2 = strlen(cstr2);
+        const char* cstr1;
+        const char* cstr2;
+        int len1, len2;
+        zym_toStringBytes(val1, &cstr1, &len1);
+        zym_toStringBytes(val2, &cstr2, &len2);
 
-        if (len1 + len2 >= 4095) {
+        if ((int64_t)len1 + len2 > INT_MAX - 1) {
             zym_runtimeError(vm, "concat() result string too long");
             return ZYM_ERROR;
         }
 
-        strcpy(buffer, cstr1);
-        strcat(buffer, cstr2);
-
-        return zym_newString(vm, buffer);
+        char* chars = zym_reserveString(vm, len1 + len2);
+        memcpy(chars, cstr1, len1);
+        memcpy(chars + len1, cstr2, len2);
+        return zym_finishString(vm, chars, len1 + len2);
     } else {
         zym_runtimeError(vm, "concat() requires both arguments to be lists or both to be strings");
         return ZYM_ERROR;
@@ -90,14 +262,8 @@ ZymValue nativeShared_concat(ZymVM* vm, ZymValue val1, ZymValue val2) {
 // Find index of value in list or substring in string (-1 if not found)
 ZymValue nativeShared_indexOf(ZymVM* vm, ZymValue haystack, ZymValue needle) {
     if (zym_isList(haystack)) {
-        int len = zym_listLength(haystack);
-        for (int i = 0; i < len; i++) {
-            ZymValue item = zym_listGet(vm, haystack, i);
-            if (valuesEqual(vm, item, needle)) {
-                return zym_newNumber((double)i);
-            }
-        }
-        return zym_newNumber(-1.0);
+        ValueArray* items = &AS_LIST(haystack)->items;
+        return zym_newNumber((double)listFind(vm, items, needle, 0, items->count));
     } else if (zym_isString(haystack)) {
         if (!zym_isString(needle)) {
             zym_runtimeError(vm, "indexOf() requires second argument to be a string when first is a string");
@@ -119,17 +285,95 @@ ZymValue nativeShared_indexOf(ZymVM* vm, ZymValue haystack, ZymValue needle) {
     }
 }
 
+// Like indexOf, starting at index from (negative counts from the end).
+// String positions are byte offsets, matching indexOf.
+ZymValue nativeShared_indexOfFrom(ZymVM* vm, ZymValue haystack, ZymValue needle, ZymValue fromVal) {
+    if (!zym_isNumber(fromVal)) {
+        zym_runtimeError(vm, "indexOfFrom() requires a number as third argument (from)");
+        return ZYM_ERROR;
+    }
+
+    double from = zym_asNumber(fromVal);
+
+    if (zym_isList(haystack)) {
+        ValueArray* items = &AS_LIST(haystack)->items;
+        if (from < 0) from += items->count;
+        if (from < 0) from = 0;
+        if (from >= items->count) return zym_newNumber(-1.0);
+        return zym_newNumber((double)listFind(vm, items, needle, (int)from, items->count));
+    } else if (zym_isString(haystack)) {
+        if (!zym_isString(needle)) {
+            zym_runtimeError(vm, "indexOfFrom() requires second argument to be a string when first is a string");
+            return ZYM_ERROR;
+        }
+
+        const char* cstr;
+        int byte_len;
+        zym_toStringBytes(haystack, &cstr, &byte_len);
+        const char* search = zym_asCString(needle);
+
+        if (from < 0) from += byte_len;
+        if (from < 0) from = 0;
+        if (from > byte_len) return zym_newNumber(-1.0);
+
+        const char* found = strstr(cstr + (int)from, search);
+        if (found == NULL) {
+            return zym_newNumber(-1.0);
+        }
+
+        return zym_newNumber((double)(found - cstr));
+    } else {
+        zym_runtimeError(vm, "indexOfFrom() requires a list or string as first argument");
+        return ZYM_ERROR;
+    }
+}
+
+// Find last index of value in list or substring in string (-1 if not found)
+ZymValue nativeShared_lastIndexOf(ZymVM* vm, ZymValue haystack, ZymValue needle) {
+    if (zym_isList(haystack)) {
+        ValueArray* items = &AS_LIST(haystack)->items;
+        return zym_newNumber((double)listFindLast(vm, items, needle, items->count));
+    } else if (zym_isString(haystack)) {
+        if (!zym_isString(needle)) {
+            zym_runtimeError(vm, "lastIndexOf() requires second argument to be a string when first is a string");
+            return ZYM_ERROR;
+        }
+
+        const char* cstr;
+        int byte_len;
+        zym_toStringBytes(haystack, &cstr, &byte_len);
+        const char* search = zym_asCString(needle);
+        int searchLen = strlen(search);
+
+        // The empty string matches at the very end; the scan below would not advance
+        if (searchLen == 0) {
+            return zym_newNumber((double)byte_len);
+        }
+
+        const char* lastFound = NULL;
+        const char* current = cstr;
+
+        while ((current = strstr(current, search)) != NULL) {
+            lastFound = current;
+            current += searchLen;
+        }
+
+        if (lastFound == NULL) {
+            return zym_newNumber(-1.0);
+        }
+
+        return zym_newNumber((double)(lastFound - cstr));
+    } else {
+        zym_runtimeError(vm, "lastIndexOf() requires a list or string as first argument");
+        return ZYM_ERROR;
+    }
+}
+
 // Check if list contains value or string contains substring
 ZymValue nativeShared_contains(ZymVM* vm, ZymValue haystack, ZymValue needle) {
     if (zym_isList(haystack)) {
-        int len = zym_listLength(haystack);
-        for (int i = 0; i < len; i++) {
-            ZymValue item = zym_listGet(vm, haystack, i);
-            if (valuesEqual(vm, item, needle)) {
-                return zym_newBool(true);
-            }
-        }
-        return zym_newBool(false);
+        ValueArray* items = &AS_LIST(haystack)->items;
+        return zym_newBool(listFind(vm, items, needle, 0, items->count) >= 0);
     } else if (zym_isString(haystack)) {
         if (!zym_isString(needle)) {
             zym_runtimeError(vm, "contains() requires second argument to be a string when first is a string");
@@ -146,6 +390,38 @@ ZymValue nativeShared_contains(ZymVM* vm, ZymValue haystack, ZymValue needle) {
     }
 }
 
+// Count list elements equal to value, or non-overlapping occurrences of a substring
+ZymValue nativeShared_count(ZymVM* vm, ZymValue haystack, ZymValue needle) {
+    if (zym_isList(haystack)) {
+        return zym_newNumber((double)listCount(vm, &AS_LIST(haystack)->items, needle));
+    } else if (zym_isString(haystack)) {
+        if (!zym_isString(needle)) {
+            zym_runtimeError(vm, "count() requires second argument to be a string when first is a string");
+            return ZYM_ERROR;
+        }
+
+        const char* cstr = zym_asCString(haystack);
+        const char* search = zym_asCString(needle);
+        int searchLen = strlen(search);
+        if (searchLen == 0) {
+            zym_runtimeError(vm, "count() requires a non-empty search string");
+            return ZYM_ERROR;
+        }
+
+        int count = 0;
+        const char* current = cstr;
+        while ((current = strstr(current, search)) != NULL) {
+            count++;
+            current += searchLen;
+        }
+
+        return zym_newNumber((double)count);
+    } else {
+        zym_runtimeError(vm, "count() requires a list or string as first argument");
+        return ZYM_ERROR;
+    }
+}
+
 // Create a slice of list or substring [start, end)
 ZymValue nativeShared_slice(ZymVM* vm, ZymValue value, ZymValue startVal, ZymValue endVal) {
     if (!zym_isNumber(startVal)) {
@@ -210,17 +486,7 @@ ZymValue nativeShared_slice(ZymVM* vm, ZymValue value, ZymValue startVal, ZymVal
             return ZYM_ERROR;
         }
 
-        int subLen = end_byte - start_byte;
-        if (subLen >= 4095) {
-            zym_runtimeError(vm, "slice() result string too long");
-            return ZYM_ERROR;
-        }
-
-        char buffer[4096];
-        memcpy(buffer, cstr + start_byte, subLen);
-        buffer[subLen] = '\0';
-
-        return zym_newString(vm, buffer);
+        return zym_newStringN(vm, cstr + start_byte, end_byte - start_byte);
     } else {
         zym_runtimeError(vm, "slice() requires a list or string as first argument");
         return ZYM_ERROR;
@@ -235,6 +501,9 @@ void registerSharedNatives(VM* vm) {
     zym_defineNative(vm, "length(value)", nativeShared_length);
     zym_defineNative(vm, "concat(a, b)", nativeShared_concat);
     zym_defineNative(vm, "indexOf(haystack, needle)", nativeShared_indexOf);
+    zym_defineNative(vm, "indexOfFrom(haystack, needle, from)", nativeShared_indexOfFrom);
+    zym_defineNative(vm, "lastIndexOf(haystack, needle)", nativeShared_lastIndexOf);
     zym_defineNative(vm, "contains(haystack, needle)", nativeShared_contains);
+    zym_defineNative(vm, "count(haystack, needle)", nativeShared_count);
     zym_defineNative(vm, "slice(value, start, end)", nativeShared_slice);
 }
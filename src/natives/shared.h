@@ -7,7 +7,10 @@
 ZymValue nativeShared_length(ZymVM* vm, ZymValue value);
 ZymValue nativeShared_concat(ZymVM* vm, ZymValue val1, ZymValue val2);
 ZymValue nativeShared_indexOf(ZymVM* vm, ZymValue haystack, ZymValue needle);
+ZymValue nativeShared_indexOfFrom(ZymVM* vm, ZymValue haystack, ZymValue needle, ZymValue fromVal);
+ZymValue nativeShared_lastIndexOf(ZymVM* vm, ZymValue haystack, ZymValue needle);
 ZymValue nativeShared_contains(ZymVM* vm, ZymValue haystack, ZymValue needle);
+ZymValue nativeShared_count(ZymVM* vm, ZymValue haystack, ZymValue needle);
 ZymValue nativeShared_slice(ZymVM* vm, ZymValue value, ZymValue startVal, ZymValue endVal);
 
 // Register shared natives into the VM
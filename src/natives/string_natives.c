@@ -2,13 +2,14 @@
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
+#include <limits.h>
 #include "string_natives.h"
 #include "../utf8.h"
 #include "../memory.h"
 
 // =============================================================================
 // STRING MANIPULATION FUNCTIONS
-// Note: length, concat, indexOf, contains, slice are in shared.c
+// Note: length, concat, indexOf, indexOfFrom, lastIndexOf, contains, count, slice are in shared.c
 // =============================================================================
 
 // Get character at index (UTF-8 aware)
@@ -195,37 +196,6 @@ ZymValue nativeString_endsWith(ZymVM* vm, ZymValue str, ZymValue suffixStr) {
     return zym_newBool(strcmp(cstr + strLen - suffixLen, suffix) == 0);
 }
 
-// Find last index of substring (returns -1 if not found)
-ZymValue nativeString_lastIndexOf(ZymVM* vm, ZymValue str, ZymValue searchStr) {
-    if (!zym_isString(str)) {
-        zym_runtimeError(vm, "lastIndexOf() requires a string as first argument");
-        return ZYM_ERROR;
-    }
-
-    if (!zym_isString(searchStr)) {
-        zym_runtimeError(vm, "lastIndexOf() requires a string as second argument");
-        return ZYM_ERROR;
-    }
-
-    const char* cstr = zym_asCString(str);
-    const char* search = zym_asCString(searchStr);
-    int searchLen = strlen(search);
-
-    const char* lastFound = NULL;
-    const char* current = cstr;
-
-    while ((current = strstr(current, search)) != NULL) {
-        lastFound = current;
-        current += searchLen;
-    }
-
-    if (lastFound == NULL) {
-        return zym_newNumber(-1.0);
-    }
-
-    return zym_newNumber((double)(lastFound - cstr));
-}
-
 // Convert string to uppercase
 ZymValue nativeString_toUpperCase(ZymVM* vm, ZymValue str) {
     if (!zym_isString(str)) {
@@ -237,22 +207,9 @@ ZymValue nativeString_toUpperCase(ZymVM* vm, ZymValue str) {
     int byte_len;
     zym_toStringBytes(str, &cstr, &byte_len);
 
-    if (byte_len >= 4095) {
-        zym_runtimeError(vm, "toUpperCase() string too long");
-        return ZYM_ERROR;
-    }
-
-    int result_len;
-    const ZymAllocator* alloc = zym_getAllocator(vm);
-    char* result = utf8_toupper((ZymAllocator*)alloc, cstr, byte_len, &result_len);
-    if (result == NULL) {
-        zym_runtimeError(vm, "toUpperCase() out of memory");
-        return ZYM_ERROR;
-    }
-
-    ZymValue newStr = zym_newString(vm, result);
-    ZYM_FREE((ZymAllocator*)alloc, result, byte_len + 1);
-    return newStr;
+    char* chars = zym_reserveString(vm, byte_len);
+    utf8_toupper(cstr, byte_len, chars);
+    return zym_finishString(vm, chars, byte_len);
 }
 
 // Convert string to lowercase
@@ -266,22 +223,9 @@ ZymValue nativeString_toLowerCase(ZymVM* vm, ZymValue str) {
     int byte_len;
     zym_toStringBytes(str, &cstr, &byte_len);
 
-    if (byte_len >= 4095) {
-        zym_runtimeError(vm, "toLowerCase() string too long");
-        return ZYM_ERROR;
-    }
-
-    int result_len;
-    const ZymAllocator* alloc = zym_getAllocator(vm);
-    char* result = utf8_tolower((ZymAllocator*)alloc, cstr, byte_len, &result_len);
-    if (result == NULL) {
-        zym_runtimeError(vm, "toLowerCase() out of memory");
-        return ZYM_ERROR;
-    }
-
-    ZymValue newStr = zym_newString(vm, result);
-    ZYM_FREE((ZymAllocator*)alloc, result, byte_len + 1);
-    return newStr;
+    char* chars = zym_reserveString(vm, byte_len);
+    utf8_tolower(cstr, byte_len, chars);
+    return zym_finishString(vm, chars, byte_len);
 }
 
 // Trim whitespace from both ends
@@ -291,8 +235,9 @@ ZymValue nativeString_trim(ZymVM* vm, ZymValue str) {
         return ZYM_ERROR;
     }
 
-    const char* cstr = zym_asCString(str);
-    int len = strlen(cstr);
+    const char* cstr;
+    int len;
+    zym_toStringBytes(str, &cstr, &len);
 
     // Find first non-whitespace
     int start = 0;
@@ -306,21 +251,7 @@ ZymValue nativeString_trim(ZymVM* vm, ZymValue str) {
         end--;
     }
 
-    int newLen = end - start + 1;
-    if (newLen <= 0) {
-        return zym_newString(vm, "");
-    }
-
-    char buffer[4096];
-    if (newLen >= 4095) {
-        zym_runtimeError(vm, "trim() result string too long");
-        return ZYM_ERROR;
-    }
-
-    strncpy(buffer, cstr + start, newLen);
-    buffer[newLen] = '\0';
-
-    return zym_newString(vm, buffer);
+    return zym_newStringN(vm, cstr + start, end - start + 1);
 }
 
 // Trim whitespace from start
@@ -330,8 +261,9 @@ ZymValue nativeString_trimStart(ZymVM* vm, ZymValue str) {
         return ZYM_ERROR;
     }
 
-    const char* cstr = zym_asCString(str);
-    int len = strlen(cstr);
+    const char* cstr;
+    int len;
+    zym_toStringBytes(str, &cstr, &len);
 
     // Find first non-whitespace
     int start = 0;
@@ -339,7 +271,7 @@ ZymValue nativeString_trimStart(ZymVM* vm, ZymValue str) {
         start++;
     }
 
-    return zym_newString(vm, cstr + start);
+    return zym_newStringN(vm, cstr + start, len - start);
 }
 
 // Trim whitespace from end
@@ -349,8 +281,9 @@ ZymValue nativeString_trimEnd(ZymVM* vm, ZymValue str) {
         return ZYM_ERROR;
     }
 
-    const char* cstr = zym_asCString(str);
-    int len = strlen(cstr);
+    const char* cstr;
+    int len;
+    zym_toStringBytes(str, &cstr, &len);
 
     // Find last non-whitespace
     int end = len - 1;
@@ -358,21 +291,7 @@ ZymValue nativeString_trimEnd(ZymVM* vm, ZymValue str) {
         end--;
     }
 
-    int newLen = end + 1;
-    if (newLen <= 0) {
-        return zym_newString(vm, "");
-    }
-
-    char buffer[4096];
-    if (newLen >= 4095) {
-        zym_runtimeError(vm, "trimEnd() result string too long");
-        return ZYM_ERROR;
-    }
-
-    strncpy(buffer, cstr, newLen);
-    buffer[newLen] = '\0';
-
-    return zym_newString(vm, buffer);
+    return zym_newStringN(vm, cstr, end + 1);
 }
 
 // Replace first occurrence of search string with replacement
@@ -392,9 +311,13 @@ ZymValue nativeString_replace(ZymVM* vm, ZymValue str, ZymValue searchStr, ZymVa
         return ZYM_ERROR;
     }
 
-    const char* cstr = zym_asCString(str);
-    const char* search = zym_asCString(searchStr);
-    const char* replace = zym_asCString(replaceStr);
+    const char* cstr;
+    const char* search;
+    const char* replace;
+    int strLen, searchLen, replaceLen;
+    zym_toStringBytes(str, &cstr, &strLen);
+    zym_toStringBytes(searchStr, &search, &searchLen);
+    zym_toStringBytes(replaceStr, &replace, &replaceLen);
 
     const char* found = strstr(cstr, search);
     if (found == NULL) {
@@ -402,23 +325,19 @@ ZymValue nativeString_replace(ZymVM* vm, ZymValue str, ZymValue searchStr, ZymVa
         return str;
     }
 
-    int searchLen = strlen(search);
-    int replaceLen = strlen(replace);
-    int beforeLen = found - cstr;
-    int afterLen = strlen(found + searchLen);
-
-    if (beforeLen + replaceLen + afterLen >= 4095) {
+    int beforeLen = (int)(found - cstr);
+    int afterLen = strLen - beforeLen - searchLen;
+    int64_t resultLen = (int64_t)beforeLen + replaceLen + afterLen;
+    if (resultLen > INT_MAX - 1) {
         zym_runtimeError(vm, "replace() result string too long");
         return ZYM_ERROR;
     }
 
-    char buffer[4096];
-    strncpy(buffer, cstr, beforeLen);
-    buffer[beforeLen] = '\0';
-    strcat(buffer, replace);
-    strcat(buffer, found + searchLen);
-
-    return zym_newString(vm, buffer);
+    char* chars = zym_reserveString(vm, (int)resultLen);
+    memcpy(chars, cstr, beforeLen);
+    memcpy(chars + beforeLen, replace, replaceLen);
+    memcpy(chars + beforeLen + replaceLen, found + searchLen, afterLen);
+    return zym_finishString(vm, chars, (int)resultLen);
 }
 
 // Replace all occurrences of search string with replacement
@@ -438,54 +357,53 @@ ZymValue nativeString_replaceAll(ZymVM* vm, ZymValue str, ZymValue searchStr, Zy
         return ZYM_ERROR;
     }
 
-    const char* cstr = zym_asCString(str);
-    const char* search = zym_asCString(searchStr);
-    const char* replace = zym_asCString(replaceStr);
-    int searchLen = strlen(search);
+    const char* cstr;
+    const char* search;
+    const char* replace;
+    int strLen, searchLen, replaceLen;
+    zym_toStringBytes(str, &cstr, &strLen);
+    zym_toStringBytes(searchStr, &search, &searchLen);
+    zym_toStringBytes(replaceStr, &replace, &replaceLen);
 
     if (searchLen == 0) {
         // Empty search string, return original
         return str;
     }
 
-    char buffer[4096];
-    buffer[0] = '\0';
-    int bufferPos = 0;
+    // Count matches first so the result is allocated once at its final size
+    int64_t matches = 0;
+    for (const char* found = strstr(cstr, search); found != NULL; found = strstr(found + searchLen, search)) {
+        matches++;
+    }
+    if (matches == 0) {
+        return str;
+    }
 
+    int64_t resultLen = strLen + matches * (replaceLen - searchLen);
+    if (resultLen > INT_MAX - 1) {
+        zym_runtimeError(vm, "replaceAll() result string too long");
+        return ZYM_ERROR;
+    }
+
+    char* chars = zym_reserveString(vm, (int)resultLen);
+    char* out = chars;
     const char* current = cstr;
     const char* found;
 
     while ((found = strstr(current, search)) != NULL) {
-        // Copy before match
-        int beforeLen = found - current;
-        if (bufferPos + beforeLen >= 4095) {
-            zym_runtimeError(vm, "replaceAll() result string too long");
-            return ZYM_ERROR;
-        }
-        strncpy(buffer + bufferPos, current, beforeLen);
-        bufferPos += beforeLen;
-
-        // Copy replacement
-        int replaceLen = strlen(replace);
-        if (bufferPos + replaceLen >= 4095) {
-            zym_runtimeError(vm, "replaceAll() result string too long");
-            return ZYM_ERROR;
-        }
-        strcpy(buffer + bufferPos, replace);
-        bufferPos += replaceLen;
+        // Copy before match, then the replacement
+        memcpy(out, current, found - current);
+        out += found - current;
+        memcpy(out, replace, replaceLen);
+        out += replaceLen;
 
         current = found + searchLen;
     }
 
     // Copy remaining
-    int remainLen = strlen(current);
-    if (bufferPos + remainLen >= 4095) {
-        zym_runtimeError(vm, "replaceAll() result string too long");
-        return ZYM_ERROR;
-    }
-    strcpy(buffer + bufferPos, current);
+    memcpy(out, current, strLen - (current - cstr));
 
-    return zym_newString(vm, buffer);
+    return zym_finishString(vm, chars, (int)resultLen);
 }
 
 // Split string by delimiter into a list
@@ -500,19 +418,19 @@ ZymValue nativeString_split(ZymVM* vm, ZymValue str, ZymValue delimiterStr) {
         return ZYM_ERROR;
     }
 
-    const char* cstr = zym_asCString(str);
-    const char* delimiter = zym_asCString(delimiterStr);
-    int delimLen = strlen(delimiter);
+    const char* cstr;
+    const char* delimiter;
+    int len, delimLen;
+    zym_toStringBytes(str, &cstr, &len);
+    zym_toStringBytes(delimiterStr, &delimiter, &delimLen);
 
     ZymValue list = zym_newList(vm);
     zym_pushRoot(vm, list);
 
     if (delimLen == 0) {
         // Empty delimiter, split into individual characters
-        int len = strlen(cstr);
         for (int i = 0; i < len; i++) {
-            char charStr[2] = {cstr[i], '\0'};
-            ZymValue charVal = zym_newString(vm, charStr);
+            ZymValue charVal = zym_newStringN(vm, cstr + i, 1);
             if (!zym_listAppend(vm, list, charVal)) {
                 zym_popRoot(vm);
                 zym_runtimeError(vm, "split() failed to append to list");
@@ -528,17 +446,7 @@ ZymValue nativeString_split(ZymVM* vm, ZymValue str, ZymValue delimiterStr) {
 
     while ((found = strstr(current, delimiter)) != NULL) {
         // Extract part before delimiter
-        int partLen = found - current;
-        char buffer[4096];
-        if (partLen >= 4095) {
-            zym_popRoot(vm);
-            zym_runtimeError(vm, "split() substring too long");
-            return ZYM_ERROR;
-        }
-        strncpy(buffer, current, partLen);
-        buffer[partLen] = '\0';
-
-        ZymValue part = zym_newString(vm, buffer);
+        ZymValue part = zym_newStringN(vm, current, (int)(found - current));
         if (!zym_listAppend(vm, list, part)) {
             zym_popRoot(vm);
             zym_runtimeError(vm, "split() failed to append to list");
@@ -549,7 +457,7 @@ ZymValue nativeString_split(ZymVM* vm, ZymValue str, ZymValue delimiterStr) {
     }
 
     // Add remaining part
-    ZymValue lastPart = zym_newString(vm, current);
+    ZymValue lastPart = zym_newStringN(vm, current, len - (int)(current - cstr));
     if (!zym_listAppend(vm, list, lastPart)) {
         zym_popRoot(vm);
         zym_runtimeError(vm, "split() failed to append to list");
@@ -582,22 +490,22 @@ ZymValue nativeString_repeat(ZymVM* vm, ZymValue str, ZymValue countVal) {
         return zym_newString(vm, "");
     }
 
-    const char* cstr = zym_asCString(str);
-    int len = strlen(cstr);
+    const char* cstr;
+    int len;
+    zym_toStringBytes(str, &cstr, &len);
 
-    if (len * count >= 4095) {
+    int64_t resultLen = (int64_t)len * count;
+    if (resultLen > INT_MAX - 1) {
         zym_runtimeError(vm, "repeat() result string too long");
         return ZYM_ERROR;
     }
 
-    char buffer[4096];
-    buffer[0] = '\0';
-
+    char* chars = zym_reserveString(vm, (int)resultLen);
     for (int i = 0; i < count; i++) {
-        strcat(buffer, cstr);
+        memcpy(chars + (int64_t)i * len, cstr, len);
     }
 
-    return zym_newString(vm, buffer);
+    return zym_finishString(vm, chars, (int)resultLen);
 }
 
 // Pad string to target length with pad string on the left
@@ -617,36 +525,38 @@ ZymValue nativeString_padStart(ZymVM* vm, ZymValue str, ZymValue targetLenVal, Z
         return ZYM_ERROR;
     }
 
-    const char* cstr = zym_asCString(str);
-    const char* pad = zym_asCString(padStr);
-    int strLen = strlen(cstr);
-    int targetLen = (int)zym_asNumber(targetLenVal);
-    int padLen = strlen(pad);
+    const char* cstr;
+    const char* pad;
+    int strLen, padLen;
+    zym_toStringBytes(str, &cstr, &strLen);
+    zym_toStringBytes(padStr, &pad, &padLen);
+    double target = zym_asNumber(targetLenVal);
 
-    if (padLen == 0 || targetLen <= strLen) {
+    if (padLen == 0 || target <= strLen) {
         return str;
     }
 
-    if (targetLen >= 4095) {
+    if (target > INT_MAX - 1) {
         zym_runtimeError(vm, "padStart() result string too long");
         return ZYM_ERROR;
     }
 
-    char buffer[4096];
+    int targetLen = (int)target;
+    char* chars = zym_reserveString(vm, targetLen);
     int fillLen = targetLen - strLen;
     int pos = 0;
 
     // Add padding
     while (pos < fillLen) {
         int copyLen = (fillLen - pos < padLen) ? (fillLen - pos) : padLen;
-        strncpy(buffer + pos, pad, copyLen);
+        memcpy(chars + pos, pad, copyLen);
         pos += copyLen;
     }
 
     // Add original string
-    strcpy(buffer + pos, cstr);
+    memcpy(chars + pos, cstr, strLen);
 
-    return zym_newString(vm, buffer);
+    return zym_finishString(vm, chars, targetLen);
 }
 
 // Pad string to target length with pad string on the right
@@ -666,35 +576,35 @@ ZymValue nativeString_padEnd(ZymVM* vm, ZymValue str, ZymValue targetLenVal, Zym
         return ZYM_ERROR;
     }
 
-    const char* cstr = zym_asCString(str);
-    const char* pad = zym_asCString(padStr);
-    int strLen = strlen(cstr);
-    int targetLen = (int)zym_asNumber(targetLenVal);
-    int padLen = strlen(pad);
+    const char* cstr;
+    const char* pad;
+    int strLen, padLen;
+    zym_toStringBytes(str, &cstr, &strLen);
+    zym_toStringBytes(padStr, &pad, &padLen);
+    double target = zym_asNumber(targetLenVal);
 
-    if (padLen == 0 || targetLen <= strLen) {
+    if (padLen == 0 || target <= strLen) {
         return str;
     }
 
-    if (targetLen >= 4095) {
+    if (target > INT_MAX - 1) {
         zym_runtimeError(vm, "padEnd() result string too long");
         return ZYM_ERROR;
     }
 
-    char buffer[4096];
-    strcpy(buffer, cstr);
-    int fillLen = targetLen - strLen;
+    int targetLen = (int)target;
+    char* chars = zym_reserveString(vm, targetLen);
+    memcpy(chars, cstr, strLen);
     int pos = strLen;
 
     // Add padding
     while (pos < targetLen) {
         int copyLen = (targetLen - pos < padLen) ? (targetLen - pos) : padLen;
-        strncpy(buffer + pos, pad, copyLen);
+        memcpy(chars + pos, pad, copyLen);
         pos += copyLen;
     }
-    buffer[targetLen] = '\0';
 
-    return zym_newString(vm, buffer);
+    return zym_finishString(vm, chars, targetLen);
 }
 
 // Extract substring from start to end (or to end of string if end is -1)
@@ -744,17 +654,7 @@ ZymValue nativeString_substr(ZymVM* vm, ZymValue str, ZymValue startVal, ZymValu
         return ZYM_ERROR;
     }
 
-    int subLen = end_byte - start_byte;
-    if (subLen >= 4095) {
-        zym_runtimeError(vm, "substr() result string too long");
-        return ZYM_ERROR;
-    }
-
-    char buffer[4096];
-    memcpy(buffer, cstr + start_byte, subLen);
-    buffer[subLen] = '\0';
-
-    return zym_newString(vm, buffer);
+    return zym_newStringN(vm, cstr + start_byte, end_byte - start_byte);
 }
 
 // =============================================================================
@@ -768,7 +668,6 @@ void registerStringNatives(VM* vm) {
     zym_defineNative(vm, "fromCodePoint(codepoint)", nativeString_fromCodePoint);
     zym_defineNative(vm, "startsWith(str, prefix)", nativeString_startsWith);
     zym_defineNative(vm, "endsWith(str, suffix)", nativeString_endsWith);
-    zym_defineNative(vm, "lastIndexOf(str, search)", nativeString_lastIndexOf);
     zym_defineNative(vm, "toUpperCase(str)", nativeString_toUpperCase);
     zym_defineNative(vm, "toLowerCase(str)", nativeString_toLowerCase);
     zym_defineNative(vm, "trim(str)", nativeString_trim);
@@ -10,7 +10,6 @@ ZymValue nativeString_byteLength(ZymVM* vm, ZymValue str);
 ZymValue nativeString_fromCodePoint(ZymVM* vm, ZymValue codePointVal);
 ZymValue nativeString_startsWith(ZymVM* vm, ZymValue str, ZymValue prefixStr);
 ZymValue nativeString_endsWith(ZymVM* vm, ZymValue str, ZymValue suffixStr);
-ZymValue nativeString_lastIndexOf(ZymVM* vm, ZymValue str, ZymValue searchStr);
 ZymValue nativeString_toUpperCase(ZymVM* vm, ZymValue str);
 ZymValue nativeString_toLowerCase(ZymVM* vm, ZymValue str);
 ZymValue nativeString_trim(ZymVM* vm, ZymValue str);
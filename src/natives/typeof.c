@@ -29,6 +29,9 @@ ZymValue nativeTypeof(ZymVM* vm, ZymValue value) {
             case OBJ_ENUM_SCHEMA:     return zym_newString(vm, "enum_schema");
             case OBJ_PROMPT_TAG:      return zym_newString(vm, "prompt_tag");
             case OBJ_CONTINUATION:    return zym_newString(vm, "continuation");
+            case OBJ_USERDATA_TYPE:   return zym_newString(vm, "userdata_type");
+            case OBJ_USERDATA:        return zym_newString(vm, "userdata");
+            case OBJ_VEC:             return zym_newString(vm, zym_typeName(value));
             default:                  return zym_newString(vm, "unknown");
         }
     }
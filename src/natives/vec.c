@@ -0,0 +1,91 @@
+#include <math.h>
+#include "vec.h"
+
+// =============================================================================
+// VECTOR CONSTRUCTORS
+// =============================================================================
+
+static ZymValue makeVec(ZymVM* vm, const char* name, const ZymValue* args, int size) {
+    double comps[4];
+    for (int i = 0; i < size; i++) {
+        if (!zym_isNumber(args[i])) {
+            zym_runtimeError(vm, "%s() requires number arguments", name);
+            return ZYM_ERROR;
+        }
+        comps[i] = zym_asNumber(args[i]);
+    }
+    return zym_newVec(vm, size, comps);
+}
+
+ZymValue nativeVec_vec2(ZymVM* vm, ZymValue x, ZymValue y) {
+    ZymValue args[2] = { x, y };
+    return makeVec(vm, "vec2", args, 2);
+}
+
+ZymValue nativeVec_vec3(ZymVM* vm, ZymValue x, ZymValue y, ZymValue z) {
+    ZymValue args[3] = { x, y, z };
+    return makeVec(vm, "vec3", args, 3);
+}
+
+ZymValue nativeVec_vec4(ZymVM* vm, ZymValue x, ZymValue y, ZymValue z, ZymValue w) {
+    ZymValue args[4] = { x, y, z, w };
+    return makeVec(vm, "vec4", args, 4);
+}
+
+// =============================================================================
+// VECTOR FUNCTIONS
+// =============================================================================
+
+double vecMagnitude(ZymValue value) {
+    const double* comps = zym_vecComponents(value);
+    double sum = 0.0;
+    for (int i = 0; i < zym_vecSize(value); i++) {
+        sum += comps[i] * comps[i];
+    }
+    return sqrt(sum);
+}
+
+ZymValue nativeVec_dot(ZymVM* vm, ZymValue a, ZymValue b) {
+    if (!zym_isVec(a) || !zym_isVec(b) || zym_vecSize(a) != zym_vecSize(b)) {
+        zym_runtimeError(vm, "dot() requires two vectors of the same size");
+        return ZYM_ERROR;
+    }
+    const double* ca = zym_vecComponents(a);
+    const double* cb = zym_vecComponents(b);
+    double sum = 0.0;
+    for (int i = 0; i < zym_vecSize(a); i++) {
+        sum += ca[i] * cb[i];
+    }
+    return zym_newNumber(sum);
+}
+
+ZymValue nativeVec_normalize(ZymVM* vm, ZymValue value) {
+    if (!zym_isVec(value)) {
+        zym_runtimeError(vm, "normalize() requires a vector argument");
+        return ZYM_ERROR;
+    }
+    int size = zym_vecSize(value);
+    double len = vecMagnitude(value);
+    if (len == 0.0) {
+        // The zero vector has no direction; hand it back unchanged
+        return value;
+    }
+    double comps[4];
+    const double* src = zym_vecComponents(value);
+    for (int i = 0; i < size; i++) {
+        comps[i] = src[i] / len;
+    }
+    return zym_newVec(vm, size, comps);
+}
+
+// =============================================================================
+// REGISTRATION
+// =============================================================================
+
+void registerVecNatives(VM* vm) {
+    zym_defineNative(vm, "vec2(x, y)", nativeVec_vec2);
+    zym_defineNative(vm, "vec3(x, y, z)", nativeVec_vec3);
+    zym_defineNative(vm, "vec4(x, y, z, w)", nativeVec_vec4);
+    zym_defineNative(vm, "dot(a, b)", nativeVec_dot);
+    zym_defineNative(vm, "normalize(value)", nativeVec_normalize);
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "../vm.h"
+#include "zym/zym.h"
+
+// Vector constructors
+ZymValue nativeVec_vec2(ZymVM* vm, ZymValue x, ZymValue y);
+ZymValue nativeVec_vec3(ZymVM* vm, ZymValue x, ZymValue y, ZymValue z);
+ZymValue nativeVec_vec4(ZymVM* vm, ZymValue x, ZymValue y, ZymValue z, ZymValue w);
+
+// Vector functions
+ZymValue nativeVec_dot(ZymVM* vm, ZymValue a, ZymValue b);
+ZymValue nativeVec_normalize(ZymVM* vm, ZymValue value);
+
+// Euclidean length of a vector (shared by length() and normalize())
+double vecMagnitude(ZymValue value);
+
+// Register vector natives into the VM
+void registerVecNatives(VM* vm);
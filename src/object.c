@@ -28,6 +28,9 @@ static ObjString* allocateString(VM* vm, char* chars, int byte_length, uint32_t
     string->byte_length = byte_length;
     string->chars = chars;
     string->hash = hash;
+    string->is_external = false;
+    string->format = NULL;
+    string->pack_plan = NULL;
     string->length = utf8_strlen(chars, byte_length);
 
     pushTempRoot(vm, (Obj*)string);
@@ -56,6 +59,22 @@ ObjString* takeString(VM* vm, char* chars, int length) {
     return allocateString(vm, chars, length, hash);
 }
 
+// Reserve-and-fill construction: the caller writes length bytes into the
+// buffer from reserveString, then finishString adopts it as the string's
+// storage (interning it like takeString) or abandonString gives it back.
+char* reserveString(VM* vm, int length) {
+    return (char*)reallocate(vm, NULL, 0, (size_t)length + 1);
+}
+
+ObjString* finishString(VM* vm, char* chars, int length) {
+    chars[length] = '\0';
+    return takeString(vm, chars, length);
+}
+
+void abandonString(VM* vm, char* chars, int length) {
+    reallocate(vm, chars, (size_t)length + 1, 0);
+}
+
 ObjString* copyString(VM* vm, const char* chars, int length) {
     uint32_t hash = hashString(chars, length);
     ObjString* interned = tableFindString(&vm->strings, chars, length, hash);
@@ -70,6 +89,30 @@ ObjString* copyString(VM* vm, const char* chars, int length) {
     return allocateString(vm, heapChars, length, hash);
 }
 
+ObjString* newExternalString(VM* vm, const char* chars, int length,
+                             ExternalStringFinalizer finalizer, void* userdata) {
+    ObjExternalString* external = (ObjExternalString*)allocateObject(vm, sizeof(ObjExternalString), OBJ_STRING);
+    ObjString* string = &external->string;
+    string->byte_length = length;
+    string->chars = (char*)chars;
+    string->hash = 0;
+    string->is_external = true;
+    string->format = NULL;
+    string->pack_plan = NULL;
+    string->length = utf8_strlen(chars, length);
+    external->finalizer = finalizer;
+    external->userdata = userdata;
+    vm->live_external_strings++;
+    return string;
+}
+
+// Canonical interned string with the same contents. Only external strings
+// need a copy; everything else is already interned.
+ObjString* internString(VM* vm, ObjString* string) {
+    if (!string->is_external) return string;
+    return copyString(vm, string->chars, string->byte_length);
+}
+
 ObjFunction* newFunction(VM* vm) {
     ObjFunction* function = (ObjFunction*)allocateObject(vm, sizeof(ObjFunction), OBJ_FUNCTION);
 
@@ -82,6 +125,8 @@ ObjFunction* newFunction(VM* vm) {
     function->max_regs = 1;
     function->name = NULL;
     function->module_name = NULL;
+    function->lazy = NULL;
+    function->shared_closure = NULL;
     initChunk(&function->chunk);
 
     return function;
@@ -119,6 +164,51 @@ ObjNativeClosure* newNativeClosure(VM* vm, ObjString* name, int arity, void* fun
     return closure;
 }
 
+// Copy of a shared userdata method with the receiver baked in as context,
+// for when the method escapes as a value instead of being invoked directly.
+ObjNativeClosure* bindNativeMethod(VM* vm, ObjNativeClosure* method, Value receiver) {
+    ObjNativeClosure* bound = newNativeClosure(vm, method->name, method->arity, method->func_ptr,
+                                               method->dispatcher, receiver);
+    bound->variadic_dispatcher = method->variadic_dispatcher;
+    bound->is_variadic = method->is_variadic;
+    return bound;
+}
+
+ObjUserdataType* newUserdataType(VM* vm, ObjString* name, NativeFinalizerFunc finalizer) {
+    ObjUserdataType* type = (ObjUserdataType*)allocateObject(vm, sizeof(ObjUserdataType), OBJ_USERDATA_TYPE);
+    type->name = name;
+    initTable(&type->methods);
+    type->finalizer = finalizer;
+    return type;
+}
+
+ObjUserdata* newUserdata(VM* vm, ObjUserdataType* type, size_t size) {
+    ObjUserdata* userdata = (ObjUserdata*)allocateObject(vm, sizeof(ObjUserdata) + size, OBJ_USERDATA);
+    userdata->type = type;
+    userdata->finalizer = type->finalizer;
+    userdata->size = size;
+    memset(userdata->payload, 0, size);
+    return userdata;
+}
+
+ObjVec* newVec(VM* vm, int size) {
+    int slot = size - VEC_MIN_SIZE;
+    ObjVec* vec = vm->vec_freelist[slot];
+    if (vec != NULL) {
+        // Reuse a swept vector; it still counts toward GC pacing like a fresh one
+        vm->vec_freelist[slot] = (ObjVec*)vec->obj.next;
+        vm->vec_free_count[slot]--;
+        vm->bytes_allocated += VEC_BYTES(size);
+        vm->gc_debt -= (int32_t)VEC_BYTES(size);
+        vec->obj.is_marked = false;
+        vec->obj.next = vm->objects;
+        vm->objects = (Obj*)vec;
+    } else {
+        vec = (ObjVec*)allocateObject(vm, VEC_BYTES(size), OBJ_VEC);
+    }
+    vec->size = size;
+    return vec;
+}
 
 ObjClosure* newClosure(VM* vm, ObjFunction* function) {
     ObjUpvalue** upvalues = NULL;
@@ -195,6 +285,35 @@ ObjEnumSchema* newEnumSchema(VM* vm, ObjString* name, ObjString** variant_names,
     schema->variant_count = variant_count;
     schema->variant_names = variant_names;
     schema->type_id = vm->next_enum_type_id++;
+
+    pushTempRoot(vm, (Obj*)schema);
+    registerEnumSchema(vm, schema);
+    popTempRoot(vm);
+    return schema;
+}
+
+// Records a schema in the per-VM registry indexed by type_id. Called again by the
+// deserializer after it restores a serialized type_id; the slot under the
+// provisional id is left behind and rejected by findEnumSchema.
+void registerEnumSchema(VM* vm, ObjEnumSchema* schema) {
+    int type_id = schema->type_id;
+    if (type_id < 0) return;
+    if (type_id >= vm->enum_schema_capacity) {
+        int old_capacity = vm->enum_schema_capacity;
+        int new_capacity = GROW_CAPACITY(old_capacity);
+        while (new_capacity <= type_id) new_capacity *= 2;
+        vm->enum_schemas = GROW_ARRAY(vm, ObjEnumSchema*, vm->enum_schemas, old_capacity, new_capacity);
+        for (int i = old_capacity; i < new_capacity; i++) vm->enum_schemas[i] = NULL;
+        vm->enum_schema_capacity = new_capacity;
+    }
+    vm->enum_schemas[type_id] = schema;
+    if (type_id >= vm->next_enum_type_id) vm->next_enum_type_id = type_id + 1;
+}
+
+ObjEnumSchema* findEnumSchema(VM* vm, int type_id) {
+    if (vm == NULL || type_id < 0 || type_id >= vm->enum_schema_capacity) return NULL;
+    ObjEnumSchema* schema = vm->enum_schemas[type_id];
+    if (schema == NULL || schema->type_id != type_id) return NULL;
     return schema;
 }
 
@@ -278,6 +397,22 @@ void printObject(Value value) {
             printf("<continuation %s, %d frames>", state_str, cont->frame_count);
             break;
         }
+        case OBJ_USERDATA_TYPE:
+            printf("<userdata type %s>", AS_USERDATA_TYPE(value)->name->chars);
+            break;
+        case OBJ_USERDATA:
+            printf("<%s userdata>", AS_USERDATA(value)->type->name->chars);
+            break;
+        case OBJ_VEC: {
+            ObjVec* vec = AS_VEC(value);
+            printf("vec%d(", vec->size);
+            for (int i = 0; i < vec->size; i++) {
+                if (i > 0) printf(", ");
+                printValue(NULL, DOUBLE_VAL(vec->comps[i]));
+            }
+            printf(")");
+            break;
+        }
         default:
             printf("<unknown object>");
             break;
@@ -6,6 +6,7 @@
 
 typedef struct VM VM;
 typedef struct ObjFunction ObjFunction;
+typedef struct LazyFunction LazyFunction;
 typedef struct {
     ObjString* key;
     Value value;
@@ -38,6 +39,9 @@ typedef struct CallFrame CallFrame;
 #define IS_ENUM_SCHEMA(value) isObjType(value, OBJ_ENUM_SCHEMA)
 #define IS_PROMPT_TAG(value)  isObjType(value, OBJ_PROMPT_TAG)
 #define IS_CONTINUATION(value) isObjType(value, OBJ_CONTINUATION)
+#define IS_USERDATA_TYPE(value) isObjType(value, OBJ_USERDATA_TYPE)
+#define IS_USERDATA(value)    isObjType(value, OBJ_USERDATA)
+#define IS_VEC(value)         isObjType(value, OBJ_VEC)
 
 #define AS_STRING(value)      ((ObjString*)AS_OBJ(value))
 #define AS_FUNCTION(value)    ((ObjFunction*)AS_OBJ(value))
@@ -55,6 +59,9 @@ typedef struct CallFrame CallFrame;
 #define AS_ENUM_SCHEMA(value) ((ObjEnumSchema*)AS_OBJ(value))
 #define AS_PROMPT_TAG(value)  ((ObjPromptTag*)AS_OBJ(value))
 #define AS_CONTINUATION(value) ((ObjContinuation*)AS_OBJ(value))
+#define AS_USERDATA_TYPE(value) ((ObjUserdataType*)AS_OBJ(value))
+#define AS_USERDATA(value)    ((ObjUserdata*)AS_OBJ(value))
+#define AS_VEC(value)         ((ObjVec*)AS_OBJ(value))
 
 typedef enum {
     OBJ_CLOSURE,
@@ -73,6 +80,9 @@ typedef enum {
     OBJ_ENUM_SCHEMA,
     OBJ_PROMPT_TAG,
     OBJ_CONTINUATION,
+    OBJ_USERDATA_TYPE,
+    OBJ_USERDATA,
+    OBJ_VEC,
 } ObjType;
 
 struct Obj {
@@ -86,14 +96,62 @@ typedef struct {
     int64_t value;
 } ObjInt64;
 
+// Compiled form of a str() format string. Literal segments reference bytes of
+// the owning string; specifier segments carry the format character.
+typedef struct FormatSegment {
+    int start;
+    int length;
+    char spec;          // 0 for literal text, '%' for a dangling trailing '%'
+} FormatSegment;
+
+typedef struct StringFormat {
+    int segment_count;
+    int literal_bytes;
+    FormatSegment segments[];
+} StringFormat;
+
+#define STRING_FORMAT_SIZE(count) (sizeof(StringFormat) + sizeof(FormatSegment) * (count))
+
+// One field run of a compiled pack()/unpack() format: count values of a
+// fixed-width code, or a single count-byte string ('s') or padding ('x').
+typedef struct PackStep {
+    char code;
+    uint8_t width;
+    int count;
+} PackStep;
+
+// Compiled form of a pack()/unpack() format string
+typedef struct PackPlan {
+    bool big_endian;
+    int step_count;
+    int byte_size;      // bytes packed or consumed
+    int value_count;    // values packed or produced
+    PackStep steps[];
+} PackPlan;
+
+#define PACK_PLAN_SIZE(count) (sizeof(PackPlan) + sizeof(PackStep) * (count))
+
 typedef struct ObjString {
     Obj obj;
     int length;
     int byte_length;
     char* chars;
     uint32_t hash;
+    bool is_external;       // bytes owned by the host, see ObjExternalString
+    StringFormat* format;   // built lazily the first time the string is used as a str() format
+    PackPlan* pack_plan;    // built lazily the first time the string is used as a pack() format
 } ObjString;
 
+typedef void (*ExternalStringFinalizer)(void* userdata, const char* chars, int length);
+
+// Host-owned string. Not interned and not hashed: equality falls back to a
+// content compare and table keys go through internString() first.
+typedef struct ObjExternalString {
+    ObjString string;
+    ExternalStringFinalizer finalizer;
+    void* userdata;
+} ObjExternalString;
+
 typedef struct ObjFunction {
     Obj obj;
     int arity;          // total param count (including rest param)
@@ -106,6 +164,8 @@ typedef struct ObjFunction {
     Upvalue* upvalues;
     int upvalue_count;
     int upvalue_capacity;
+    LazyFunction* lazy;  // pending body (see compileLazyFunction), NULL once compiled
+    struct ObjClosure* shared_closure;  // canonical closure when upvalue_count == 0
 } ObjFunction;
 
 typedef Value (*NativeDispatcher)(VM* vm, Value* args, void* func_ptr);
@@ -140,6 +200,34 @@ typedef struct {
     bool is_variadic;
 } ObjNativeClosure;
 
+// Host type shared by all of its userdata instances. Methods are native
+// closures with a null context; the receiver is passed as context at call time.
+typedef struct ObjUserdataType {
+    Obj obj;
+    ObjString* name;
+    Table methods;
+    NativeFinalizerFunc finalizer;  // receives the instance payload
+} ObjUserdataType;
+
+// Host object with an inline payload, created in a single allocation.
+typedef struct ObjUserdata {
+    Obj obj;
+    ObjUserdataType* type;
+    NativeFinalizerFunc finalizer;  // copied from the type, which may be swept first
+    size_t size;
+    unsigned char payload[];
+} ObjUserdata;
+
+// Immutable float64 vector of VEC_MIN_SIZE to VEC_MAX_SIZE components (vm.h).
+// Unreachable vectors go to a per-size freelist on the VM (see newVec) instead
+// of back to the allocator.
+typedef struct ObjVec {
+    Obj obj;
+    int size;
+    double comps[];
+} ObjVec;
+
+#define VEC_BYTES(size) (sizeof(ObjVec) + sizeof(double) * (size_t)(size))
 
 typedef struct ObjUpvalue {
     Obj obj;
@@ -148,7 +236,7 @@ typedef struct ObjUpvalue {
     struct ObjUpvalue* next;
 } ObjUpvalue;
 
-typedef struct {
+typedef struct ObjClosure {
     Obj obj;
     ObjFunction* function;
     ObjUpvalue** upvalues;
@@ -238,8 +326,18 @@ ObjFunction* newFunction(VM* vm);
 ObjNativeFunction* newNativeFunction(VM* vm, ObjString* name, int arity, void* func_ptr, NativeDispatcher dispatcher);
 ObjNativeContext* newNativeContext(VM* vm, void* native_data, NativeFinalizerFunc finalizer);
 ObjNativeClosure* newNativeClosure(VM* vm, ObjString* name, int arity, void* func_ptr, NativeDispatcher dispatcher, Value context);
+ObjNativeClosure* bindNativeMethod(VM* vm, ObjNativeClosure* method, Value receiver);
+ObjUserdataType* newUserdataType(VM* vm, ObjString* name, NativeFinalizerFunc finalizer);
+ObjUserdata* newUserdata(VM* vm, ObjUserdataType* type, size_t size);
+ObjVec* newVec(VM* vm, int size);
 ObjString* takeString(VM* vm, char* chars, int length);
 ObjString* copyString(VM* vm, const char* chars, int length);
+char* reserveString(VM* vm, int length);
+ObjString* finishString(VM* vm, char* chars, int length);
+void abandonString(VM* vm, char* chars, int length);
+ObjString* newExternalString(VM* vm, const char* chars, int length,
+                             ExternalStringFinalizer finalizer, void* userdata);
+ObjString* internString(VM* vm, ObjString* string);
 void printObject(Value value);
 Obj* allocateObject(VM* vm, size_t size, ObjType type);
 ObjClosure* newClosure(VM* vm, ObjFunction* function);
@@ -249,5 +347,7 @@ ObjDispatcher* newDispatcher(VM* vm);
 ObjStructSchema* newStructSchema(VM* vm, ObjString* name, ObjString** field_names, int field_count);
 ObjStructInstance* newStructInstance(VM* vm, ObjStructSchema* schema);
 ObjEnumSchema* newEnumSchema(VM* vm, ObjString* name, ObjString** variant_names, int variant_count);
+void registerEnumSchema(VM* vm, ObjEnumSchema* schema);
+ObjEnumSchema* findEnumSchema(VM* vm, int type_id);
 ObjPromptTag* newPromptTag(VM* vm, ObjString* name);
 ObjContinuation* newContinuation(VM* vm);
\ No newline at end of file
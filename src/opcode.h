@@ -91,6 +91,7 @@ typedef enum {
     TAIL_CALL,
     TAIL_CALL_SELF,         // Tail call to current function (recursive TCO)
     RET,
+    THROW,                  // Raise Ra: resume at the innermost handler covering this instruction
 
     // Branch-Compare Opcodes (compare and jump if true)
     // Register-register: if (Ra op Rb) jump offset
@@ -148,6 +149,9 @@ typedef enum {
     SET_MAP_PROPERTY_L,  // container[Ra].key_ptr64 = Rc - key string inlined in trailing 2 words
     GET_STRUCT_FIELD_IC, // IC: Ra = struct[Rb].field[C], key_ptr64 as guard in trailing 2 words
     SET_STRUCT_FIELD_IC, // IC: struct[Ra].field[B] = Rc, key_ptr64 as guard in trailing 2 words
+    GET_VEC_COMPONENT_IC, // IC: Ra = vec[Rb].comps[C], key const kept in trailing word for the revert
+    INVOKE,              // Ra = Ra.key(Ra+1 .. Ra+B) - fused GET_MAP_PROPERTY_L + CALL; trailing words: key const, IC slot
+    CONCAT_N,            // Ra = Rb + Rb+1 + ... + Rb+C-1 - single allocation when all operands are strings
 
     // Dispatcher Opcodes (for overloaded function returns)
     NEW_DISPATCHER,
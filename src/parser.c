@@ -85,6 +85,8 @@ static Stmt* parse_for_statement(Parser* parser);
 static Stmt* parse_jump_statement(Parser* parser);
 static Stmt* parse_goto_statement(Parser* parser);
 static Stmt* parse_switch_statement(Parser* parser);
+static Stmt* parse_try_statement(Parser* parser);
+static Stmt* parse_throw_statement(Parser* parser);
 static Stmt* parse_return_statement(Parser* parser);
 static Stmt* function(Parser* parser, const char* kind);
 
@@ -234,6 +236,8 @@ static bool is_statement_start(Parser* parser) {
         case TOKEN_WHILE:
         case TOKEN_FOR:
         case TOKEN_SWITCH:
+        case TOKEN_TRY:
+        case TOKEN_THROW:
         case TOKEN_LEFT_BRACE:
         case TOKEN_BREAK:
         case TOKEN_CONTINUE:
@@ -268,6 +272,8 @@ static void synchronize(Parser* parser) {
                 case TOKEN_IF:
                 case TOKEN_WHILE:
                 case TOKEN_SWITCH:
+                case TOKEN_TRY:
+                case TOKEN_THROW:
                 case TOKEN_RETURN:
                 case TOKEN_STRUCT:
                 case TOKEN_ENUM:
@@ -608,6 +614,9 @@ static Expr* dot(Parser* parser, Expr* left) {
             case TOKEN_OR:
             case TOKEN_DO:
             case TOKEN_GOTO:
+            case TOKEN_TRY:
+            case TOKEN_CATCH:
+            case TOKEN_THROW:
                 is_usable_keyword = true;
                 advance(parser);
                 break;
@@ -841,8 +850,21 @@ static Stmt* parse_var_declaration(Parser* parser) {
         count++;
     } while (match(parser, TOKEN_COMMA));
 
+    // `var a, b = f();` binds the call's results in order instead of
+    // initializing only the last name.
+    bool destructure = count > 1 && variables[count - 1].initializer != NULL &&
+                       variables[count - 1].initializer->type == EXPR_CALL;
+    for (int i = 0; destructure && i < count - 1; i++) {
+        if (variables[i].initializer != NULL) destructure = false;
+    }
+    if (destructure && count > 255) {
+        error_at_current(parser, "Can't destructure more than 255 results.");
+    }
+
     consume_end_of_statement(parser, "Expect ';' after variable declaration.");
-    return new_var_decl_stmt(parser->vm, variables, count, capacity, keyword);
+    Stmt* stmt = new_var_decl_stmt(parser->vm, variables, count, capacity, keyword);
+    stmt->as.var_declaration.destructure = destructure;
+    return stmt;
 }
 
 static Stmt* function(Parser* parser, const char* kind) {
@@ -962,6 +984,8 @@ static Stmt* parse_statement(Parser* parser) {
     if (match(parser, TOKEN_LEFT_BRACE)) return parse_block(parser);
     if (match(parser, TOKEN_BREAK) || match(parser, TOKEN_CONTINUE)) return parse_jump_statement(parser);
     if (match(parser, TOKEN_GOTO)) return parse_goto_statement(parser);
+    if (match(parser, TOKEN_TRY)) return parse_try_statement(parser);
+    if (match(parser, TOKEN_THROW)) return parse_throw_statement(parser);
 
     if (check(parser, TOKEN_IDENTIFIER)) {
         Scanner saved_scanner = parser->scanner;
@@ -1280,6 +1304,33 @@ static Stmt* parse_switch_statement(Parser* parser) {
                           case_capacity, default_index, keyword);
 }
 
+static Stmt* parse_try_statement(Parser* parser) {
+    Token keyword = parser->previous;
+    consume(parser, TOKEN_LEFT_BRACE, "Expect '{' after 'try'.");
+    Stmt* body = parse_block(parser);
+
+    consume(parser, TOKEN_CATCH, "Expect 'catch' after try block.");
+    Token catch_name = parser->previous;
+    bool has_name = false;
+    if (match(parser, TOKEN_LEFT_PAREN)) {
+        consume(parser, TOKEN_IDENTIFIER, "Expect exception variable name.");
+        catch_name = parser->previous;
+        has_name = true;
+        consume(parser, TOKEN_RIGHT_PAREN, "Expect ')' after exception variable.");
+    }
+    consume(parser, TOKEN_LEFT_BRACE, "Expect '{' after catch clause.");
+    Stmt* handler = parse_block(parser);
+    return new_try_stmt(parser->vm, body, catch_name, has_name, handler, keyword);
+}
+
+static Stmt* parse_throw_statement(Parser* parser) {
+    Token keyword = parser->previous;
+    Expr* value = parse_expression(parser);
+    if (value == NULL) return NULL;
+    consume_end_of_statement(parser, "Expect ';' after thrown value.");
+    return new_throw_stmt(parser->vm, value, keyword);
+}
+
 static Stmt* parse_return_statement(Parser* parser) {
     Token keyword = parser->previous;
     Expr* value = NULL;
@@ -1291,8 +1342,27 @@ static Stmt* parse_return_statement(Parser* parser) {
         value = parse_expression(parser);
     }
 
+    Expr** extra_values = NULL;
+    int extra_count = 0;
+    int extra_capacity = 0;
+    while (value != NULL && match(parser, TOKEN_COMMA)) {
+        if (extra_count >= 254) {
+            error_at_current(parser, "Can't return more than 255 values.");
+        }
+        if (extra_count + 1 > extra_capacity) {
+            int old_capacity = extra_capacity;
+            extra_capacity = GROW_CAPACITY(old_capacity);
+            extra_values = GROW_ARRAY(parser->vm, Expr*, extra_values, old_capacity, extra_capacity);
+        }
+        extra_values[extra_count++] = parse_expression(parser);
+    }
+
     consume_end_of_statement(parser, "Expect ';' after return value.");
-    return new_return_stmt(parser->vm, keyword, value);
+    Stmt* stmt = new_return_stmt(parser->vm, keyword, value);
+    stmt->as.return_stmt.extra_values = extra_values;
+    stmt->as.return_stmt.extra_count = extra_count;
+    stmt->as.return_stmt.extra_capacity = extra_capacity;
+    return stmt;
 }
 AstResult parse(VM* vm, const char* source, const LineMap* line_map, const char* entry_file) {
     Parser parser;
@@ -0,0 +1,299 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "./profile.h"
+#include "./memory.h"
+#include "./object.h"
+#include "./vm.h"
+
+#define OPCODE(i) ((i) & 0xFF)
+#define REG_A(i)  (((i) >> 8) & 0xFF)
+#define REG_B(i)  (((i) >> 16) & 0xFF)
+#define REG_C(i)  (((i) >> 24) & 0xFF)
+
+// =============================================================================
+// COLLECTION
+// =============================================================================
+
+void freeChunkProfile(VM* vm, Chunk* chunk) {
+    ChunkProfile* profile = chunk->profile;
+    if (profile == NULL) return;
+    ZYM_FREE(&vm->allocator, profile->counts, sizeof(uint32_t) * profile->length);
+    ZYM_FREE(&vm->allocator, profile->taken, sizeof(uint32_t) * profile->length);
+    ZYM_FREE(&vm->allocator, profile->targets, sizeof(int32_t) * profile->length);
+    ZYM_FREE(&vm->allocator, profile->kinds, sizeof(uint8_t) * profile->length);
+    ZYM_FREE(&vm->allocator, profile, sizeof(ChunkProfile));
+    chunk->profile = NULL;
+}
+
+#ifdef ZYM_PROFILE
+// Counters bypass reallocate: they are diagnostics, and a collection must not
+// start in the middle of DISPATCH.
+static ChunkProfile* newChunkProfile(VM* vm, Chunk* chunk) {
+    ChunkProfile* profile = ZYM_CALLOC(&vm->allocator, 1, sizeof(ChunkProfile));
+    if (profile == NULL) return NULL;
+    profile->length = chunk->count;
+    profile->counts = ZYM_CALLOC(&vm->allocator, chunk->count, sizeof(uint32_t));
+    profile->taken = ZYM_CALLOC(&vm->allocator, chunk->count, sizeof(uint32_t));
+    profile->targets = ZYM_ALLOC(&vm->allocator, sizeof(int32_t) * chunk->count);
+    profile->kinds = ZYM_CALLOC(&vm->allocator, chunk->count, sizeof(uint8_t));
+    chunk->profile = profile;
+    if (profile->counts == NULL || profile->taken == NULL || profile->targets == NULL || profile->kinds == NULL) {
+        freeChunkProfile(vm, chunk);
+        return NULL;
+    }
+    for (int i = 0; i < chunk->count; i++) profile->targets[i] = -1;
+    return profile;
+}
+
+// Words from a jump to its fall-through successor, 0 for other opcodes
+static int jumpWidth(int opcode) {
+    switch (opcode) {
+        case JUMP: case JUMP_IF_FALSE: case JUMP_IF_TRUE:
+        case BRANCH_EQ: case BRANCH_NE: case BRANCH_LT:
+        case BRANCH_LE: case BRANCH_GT: case BRANCH_GE:
+            return 1;
+        case BRANCH_EQ_I: case BRANCH_NE_I: case BRANCH_LT_I:
+        case BRANCH_LE_I: case BRANCH_GT_I: case BRANCH_GE_I:
+            return 2;
+        case BRANCH_EQ_L: case BRANCH_NE_L: case BRANCH_LT_L:
+        case BRANCH_LE_L: case BRANCH_GT_L: case BRANCH_GE_L:
+            return 4;
+        default:
+            return 0;
+    }
+}
+
+static uint8_t valueKind(Value value) {
+    if (IS_DOUBLE(value)) return PROFILE_KIND_NUMBER;
+    if (IS_STRING(value)) return PROFILE_KIND_STRING;
+    if (IS_VEC(value)) return PROFILE_KIND_VEC;
+    return PROFILE_KIND_OTHER;
+}
+
+void profileInstruction(VM* vm, uint32_t* ip, Value* bp) {
+    Chunk* chunk = vm->chunk;
+    int index = (int)(ip - chunk->code);
+
+    // The previous instruction was a jump: did it fall through?
+    if (vm->profile_jump != NULL) {
+        ChunkProfile* jumped = vm->profile_jump;
+        vm->profile_jump = NULL;
+        if (jumped == chunk->profile && index != vm->profile_fallthrough) {
+            jumped->taken[vm->profile_jump_index]++;
+            jumped->targets[vm->profile_jump_index] = index;
+        }
+    }
+
+    ChunkProfile* profile = chunk->profile;
+    if (profile == NULL) {
+        profile = newChunkProfile(vm, chunk);
+        if (profile == NULL) return;
+    }
+    if (index < 0 || index >= profile->length) return;
+    profile->counts[index]++;
+
+    uint32_t instr = *ip;
+    int opcode = OPCODE(instr);
+    int width = jumpWidth(opcode);
+    if (width > 0) {
+        vm->profile_jump = profile;
+        vm->profile_jump_index = index;
+        vm->profile_fallthrough = index + width;
+    }
+
+    switch (opcode) {
+        case ADD: case SUB: case MUL: case DIV: case MOD:
+        case EQ: case GT: case LT: case NE: case LE: case GE:
+            profile->kinds[index] |= valueKind(bp[REG_B(instr)]) | (valueKind(bp[REG_C(instr)]) << 4);
+            break;
+        case ADD_I: case SUB_I: case MUL_I: case DIV_I: case MOD_I:
+        case ADD_L: case SUB_L: case MUL_L: case DIV_L: case MOD_L:
+        case EQ_I: case GT_I: case LT_I: case NE_I: case LE_I: case GE_I:
+        case EQ_L: case GT_L: case LT_L: case NE_L: case LE_L: case GE_L:
+            profile->kinds[index] |= valueKind(bp[REG_B(instr)]);
+            break;
+        case BRANCH_EQ: case BRANCH_NE: case BRANCH_LT:
+        case BRANCH_LE: case BRANCH_GT: case BRANCH_GE:
+            profile->kinds[index] |= valueKind(bp[REG_A(instr)]) | (valueKind(bp[REG_B(instr)]) << 4);
+            break;
+        default:
+            break;
+    }
+}
+#endif
+
+// =============================================================================
+// PROFILE TEXT
+// =============================================================================
+
+bool profileKey(char* out, size_t size, const char* parent, const char* name, int length, int arity) {
+    int written = parent != NULL
+        ? snprintf(out, size, "%s/%.*s@%d", parent, length, name, arity)
+        : snprintf(out, size, "%.*s", length, name);
+    return written >= 0 && (size_t)written < size;
+}
+
+static void appendText(VM* vm, OutputBuffer* out, const char* text) {
+    appendToOutputBuffer(vm, out, text, strlen(text));
+}
+
+static void writeFunctionProfile(VM* vm, Chunk* chunk, const char* key, OutputBuffer* out) {
+    ChunkProfile* profile = chunk->profile;
+    if (profile != NULL) {
+        appendText(vm, out, "function ");
+        appendText(vm, out, key);
+        appendText(vm, out, "\n");
+
+        char line[128];
+        for (int i = 0; i < profile->length; i++) {
+            if (profile->counts[i] == 0) continue;
+            snprintf(line, sizeof(line), "%d %d %d %u %u %d %u\n",
+                     i, chunk->lines ? chunk->lines[i] : 0, (int)OPCODE(chunk->code[i]),
+                     profile->counts[i], profile->taken[i], profile->targets[i], profile->kinds[i]);
+            appendText(vm, out, line);
+        }
+    }
+
+    for (int i = 0; i < chunk->constants.count; i++) {
+        Value constant = chunk->constants.values[i];
+        if (!IS_FUNCTION(constant)) continue;
+        ObjFunction* function = AS_FUNCTION(constant);
+        const char* name = function->name != NULL ? function->name->chars : "<fn>";
+        int length = function->name != NULL ? function->name->length : 4;
+
+        char child[PROFILE_KEY_MAX];
+        if (profileKey(child, sizeof(child), key, name, length, function->arity)) {
+            writeFunctionProfile(vm, &function->chunk, child, out);
+        }
+    }
+}
+
+void writeProfile(VM* vm, Chunk* chunk, OutputBuffer* out) {
+    appendText(vm, out, "zym-profile 1\n");
+    writeFunctionProfile(vm, chunk, "<script>", out);
+}
+
+#ifndef ZYM_RUNTIME_ONLY
+static ProfileFunction* addProfileFunction(VM* vm, Profile* profile, const char* key, int length) {
+    for (int i = 0; i < profile->function_count; i++) {
+        ProfileFunction* existing = &profile->functions[i];
+        if ((int)strlen(existing->key) == length && memcmp(existing->key, key, length) == 0) {
+            existing->ambiguous = true;
+            return NULL;
+        }
+    }
+
+    if (profile->function_count == profile->function_capacity) {
+        int old_capacity = profile->function_capacity;
+        profile->function_capacity = GROW_CAPACITY(old_capacity);
+        profile->functions = GROW_ARRAY(vm, ProfileFunction, profile->functions, old_capacity, profile->function_capacity);
+    }
+    ProfileFunction* function = &profile->functions[profile->function_count++];
+    function->key = ALLOCATE(vm, char, length + 1);
+    memcpy(function->key, key, length);
+    function->key[length] = '\0';
+    function->ambiguous = false;
+    function->records = NULL;
+    function->record_count = 0;
+    function->record_capacity = 0;
+    return function;
+}
+
+static int compareRecords(const void* a, const void* b) {
+    return ((const ProfileRecord*)a)->offset - ((const ProfileRecord*)b)->offset;
+}
+
+Profile* parseProfile(VM* vm, const char* text, size_t length) {
+    static const char header[] = "zym-profile 1\n";
+    if (length < sizeof(header) - 1 || memcmp(text, header, sizeof(header) - 1) != 0) return NULL;
+
+    Profile* profile = ALLOCATE(vm, Profile, 1);
+    profile->functions = NULL;
+    profile->function_count = 0;
+    profile->function_capacity = 0;
+
+    const char* p = text + sizeof(header) - 1;
+    const char* end = text + length;
+    ProfileFunction* current = NULL;
+    bool skipping = false;
+    while (p < end) {
+        const char* eol = memchr(p, '\n', (size_t)(end - p));
+        if (eol == NULL) eol = end;
+        int line_length = (int)(eol - p);
+
+        if (line_length > 9 && memcmp(p, "function ", 9) == 0) {
+            current = addProfileFunction(vm, profile, p + 9, line_length - 9);
+            skipping = current == NULL;
+        } else if (line_length > 0) {
+            char buffer[128];
+            ProfileRecord record;
+            unsigned kinds;
+            if (line_length >= (int)sizeof(buffer) || (current == NULL && !skipping)) goto malformed;
+            memcpy(buffer, p, line_length);
+            buffer[line_length] = '\0';
+            if (sscanf(buffer, "%d %d %d %u %u %d %u", &record.offset, &record.line, &record.opcode,
+                       &record.count, &record.taken, &record.target, &kinds) != 7) {
+                goto malformed;
+            }
+            record.kinds = (uint8_t)kinds;
+            if (current != NULL) {
+                if (current->record_count == current->record_capacity) {
+                    int old_capacity = current->record_capacity;
+                    current->record_capacity = GROW_CAPACITY(old_capacity);
+                    current->records = GROW_ARRAY(vm, ProfileRecord, current->records, old_capacity, current->record_capacity);
+                }
+                current->records[current->record_count++] = record;
+            }
+        }
+        p = eol + 1;
+    }
+
+    for (int i = 0; i < profile->function_count; i++) {
+        ProfileFunction* function = &profile->functions[i];
+        qsort(function->records, function->record_count, sizeof(ProfileRecord), compareRecords);
+    }
+    return profile;
+
+malformed:
+    freeProfile(vm, profile);
+    return NULL;
+}
+
+void freeProfile(VM* vm, Profile* profile) {
+    if (profile == NULL) return;
+    for (int i = 0; i < profile->function_count; i++) {
+        ProfileFunction* function = &profile->functions[i];
+        FREE_ARRAY(vm, char, function->key, strlen(function->key) + 1);
+        FREE_ARRAY(vm, ProfileRecord, function->records, function->record_capacity);
+    }
+    FREE_ARRAY(vm, ProfileFunction, profile->functions, profile->function_capacity);
+    FREE(vm, Profile, profile);
+}
+
+const ProfileFunction* findProfileFunction(const Profile* profile, const char* key) {
+    if (profile == NULL) return NULL;
+    for (int i = 0; i < profile->function_count; i++) {
+        const ProfileFunction* function = &profile->functions[i];
+        if (strcmp(function->key, key) == 0) {
+            return function->ambiguous ? NULL : function;
+        }
+    }
+    return NULL;
+}
+
+const ProfileRecord* findProfileRecord(const ProfileFunction* function, int offset) {
+    if (function == NULL) return NULL;
+    int low = 0;
+    int high = function->record_count - 1;
+    while (low <= high) {
+        int mid = (low + high) / 2;
+        const ProfileRecord* record = &function->records[mid];
+        if (record->offset == offset) return record;
+        if (record->offset < offset) low = mid + 1;
+        else high = mid - 1;
+    }
+    return NULL;
+}
+#endif
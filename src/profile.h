@@ -0,0 +1,85 @@
+#pragma once
+
+#include "./common.h"
+#include "./chunk.h"
+#include "./utils.h"
+
+typedef struct VM VM;
+
+// =============================================================================
+// COLLECTION (builds with ZYM_PROFILE)
+// =============================================================================
+
+// Operand kinds seen by an instruction: operand B in the low nibble, C in the
+// high nibble (A and B for register branches)
+#define PROFILE_KIND_NUMBER 0x1
+#define PROFILE_KIND_STRING 0x2
+#define PROFILE_KIND_VEC    0x4
+#define PROFILE_KIND_OTHER  0x8
+
+// Counters for one chunk, indexed by code offset. Trailing literal words of
+// an instruction are never counted.
+typedef struct ChunkProfile {
+    int length;
+    uint32_t* counts;   // executions
+    uint32_t* taken;    // jumps that left the fall-through path
+    int32_t* targets;   // last jump destination, -1 until taken
+    uint8_t* kinds;     // PROFILE_KIND_* bits
+} ChunkProfile;
+
+#ifdef ZYM_PROFILE
+// Called from DISPATCH before each instruction at ip executes
+void profileInstruction(VM* vm, uint32_t* ip, Value* bp);
+#endif
+
+void freeChunkProfile(VM* vm, Chunk* chunk);
+
+// Appends the text profile of chunk, the top-level script, and every function
+// it defines. Functions are keyed by their path of "name@arity" segments from
+// "<script>", records by code offset:
+//   zym-profile 1
+//   function <key>
+//   <offset> <line> <opcode> <count> <taken> <target> <kinds>
+void writeProfile(VM* vm, Chunk* chunk, OutputBuffer* out);
+
+// Builds the key of a function named name (length bytes) nested in parent;
+// parent is NULL for the script itself. Returns false if it does not fit.
+bool profileKey(char* out, size_t size, const char* parent, const char* name, int length, int arity);
+
+#define PROFILE_KEY_MAX 512
+
+// =============================================================================
+// CONSUMPTION (compiler)
+// =============================================================================
+
+typedef struct {
+    int offset;
+    int line;
+    int opcode;
+    uint32_t count;
+    uint32_t taken;
+    int32_t target;
+    uint8_t kinds;
+} ProfileRecord;
+
+typedef struct {
+    char* key;
+    bool ambiguous;     // key seen more than once, e.g. sibling anonymous functions
+    ProfileRecord* records;  // sorted by offset
+    int record_count;
+    int record_capacity;
+} ProfileFunction;
+
+typedef struct Profile {
+    ProfileFunction* functions;
+    int function_count;
+    int function_capacity;
+} Profile;
+
+#ifndef ZYM_RUNTIME_ONLY
+// Returns NULL if text is not a profile written by writeProfile
+Profile* parseProfile(VM* vm, const char* text, size_t length);
+void freeProfile(VM* vm, Profile* profile);
+const ProfileFunction* findProfileFunction(const Profile* profile, const char* key);
+const ProfileRecord* findProfileRecord(const ProfileFunction* function, int offset);
+#endif
@@ -152,6 +152,7 @@ static TokenType identifierType(Scanner* scanner) {
         CASE('c', {
             CASE('a', {
                 KW('s', "e", TOKEN_CASE);
+                KW('t', "ch", TOKEN_CATCH);
             })
             KW('o', "ntinue", TOKEN_CONTINUE);
         })
@@ -182,7 +183,11 @@ static TokenType identifierType(Scanner* scanner) {
             KW('w', "itch", TOKEN_SWITCH);
         })
         CASE('t', {
-            KW('r', "ue", TOKEN_TRUE);
+            KW('h', "row", TOKEN_THROW);
+            CASE('r', {
+                KW('u', "e", TOKEN_TRUE);
+                KW('y', "", TOKEN_TRY);
+            })
         })
         CASE('v', {
             CASE('a', {
@@ -9,6 +9,7 @@
 #include "memory.h"
 #include "utils.h"
 #include "object.h"
+#include "vm.h"
 
 #define TYPE_TAG_NUMBER   0x01
 #define TYPE_TAG_STRING   0x02
@@ -21,9 +22,9 @@ static void writeBytes(VM* vm, OutputBuffer* out, const void* data, size_t size)
     appendToOutputBuffer(vm, out, (const char*)data, size);
 }
 
-void serializeChunk(VM* vm, Chunk* chunk, CompilerConfig config, OutputBuffer* out) {
+bool serializeChunk(VM* vm, Chunk* chunk, CompilerConfig config, OutputBuffer* out) {
     const char magic[] = "ZYM\0";
-    const uint8_t version = 1;
+    const uint8_t version = 2;
     writeBytes(vm, out, magic, 4);
     writeBytes(vm, out, &version, sizeof(uint8_t));
 
@@ -59,6 +60,13 @@ void serializeChunk(VM* vm, Chunk* chunk, CompilerConfig config, OutputBuffer* o
             writeBytes(vm, out, &tag, sizeof(uint8_t));
 
             ObjFunction* fn = AS_FUNCTION(value);
+            // Bytecode images carry no source, so deferred bodies are compiled now.
+            // The chunk being written is not necessarily rooted, so hold off the GC.
+            bool gc_was_enabled = vm->gc_enabled;
+            vm->gc_enabled = false;
+            bool compiled = ensureFunctionCompiled(vm, fn);
+            vm->gc_enabled = gc_was_enabled;
+            if (!compiled) return false;
             writeBytes(vm, out, &fn->arity, sizeof(int));
             writeBytes(vm, out, &fn->fixed_arity, sizeof(int));
             uint8_t variadic_flag = fn->is_variadic ? 1 : 0;
@@ -83,7 +91,10 @@ void serializeChunk(VM* vm, Chunk* chunk, CompilerConfig config, OutputBuffer* o
 
             OutputBuffer nested;
             initOutputBuffer(&nested);
-            serializeChunk(vm, &fn->chunk, config, &nested);
+            if (!serializeChunk(vm, &fn->chunk, config, &nested)) {
+                freeOutputBuffer(vm, &nested);
+                return false;
+            }
             int32_t nestedSize = (int32_t)nested.count;
             writeBytes(vm, out, &nestedSize, sizeof(int32_t));
             writeBytes(vm, out, nested.buffer, (size_t)nestedSize);
@@ -141,6 +152,12 @@ void serializeChunk(VM* vm, Chunk* chunk, CompilerConfig config, OutputBuffer* o
         int zero = 0;
         writeBytes(vm, out, &zero, sizeof(int));
     }
+
+    writeBytes(vm, out, &chunk->handler_count, sizeof(int));
+    if (chunk->handler_count > 0) {
+        writeBytes(vm, out, chunk->handlers, sizeof(ExceptionHandler) * (size_t)chunk->handler_count);
+    }
+    return true;
 }
 
 bool deserializeChunk(VM* vm, Chunk* chunk, const uint8_t* buffer, size_t size) {
@@ -165,7 +182,7 @@ bool deserializeChunk(VM* vm, Chunk* chunk, const uint8_t* buffer, size_t size)
 
     uint8_t version = 0;
     READ_BYTES(&version, sizeof(uint8_t));
-    if (version != 1) return false;
+    if (version != 1 && version != 2) return false;  // version 1 predates handler tables
 
     int entryFileLen = 0;
     READ_BYTES(&entryFileLen, sizeof(int));
@@ -353,8 +370,13 @@ bool deserializeChunk(VM* vm, Chunk* chunk, const uint8_t* buffer, size_t size)
                 ObjString* name = takeString(vm, nameChars, nameLen);
                 pushTempRoot(vm, (Obj*)name);
 
+                // Enum values carry the type_id in 16 bits and id 0 is never issued
                 int type_id = 0;
                 READ_BYTES(&type_id, sizeof(int));
+                if (type_id < 1 || type_id > 0xFFFF) {
+                    popTempRoot(vm);
+                    return false;
+                }
 
                 int variant_count = 0;
                 READ_BYTES(&variant_count, sizeof(int));
@@ -383,6 +405,7 @@ bool deserializeChunk(VM* vm, Chunk* chunk, const uint8_t* buffer, size_t size)
                 ObjEnumSchema* schema = newEnumSchema(vm, name, variant_names, variant_count);
                 schema->type_id = type_id;
                 pushTempRoot(vm, (Obj*)schema);
+                registerEnumSchema(vm, schema);
                 addConstant(vm, chunk, OBJ_VAL(schema));
                 popTempRoot(vm); // schema
 
@@ -395,6 +418,7 @@ bool deserializeChunk(VM* vm, Chunk* chunk, const uint8_t* buffer, size_t size)
                 READ_BYTES(&type_id, sizeof(int));
                 int variant = 0;
                 READ_BYTES(&variant, sizeof(int));
+                if (type_id < 1 || type_id > 0xFFFF || variant < 0 || variant > 0xFFFF) return false;
 
                 Value enum_val = ENUM_VAL(type_id, variant);
                 addConstant(vm, chunk, enum_val);
@@ -427,6 +451,21 @@ bool deserializeChunk(VM* vm, Chunk* chunk, const uint8_t* buffer, size_t size)
         READ_BYTES(chunk->lines, sizeof(int) * (size_t)line_count);
     }
 
+    if (version >= 2) {
+        int handler_count = 0;
+        READ_BYTES(&handler_count, sizeof(int));
+        if (handler_count < 0) return false;
+        for (int i = 0; i < handler_count; i++) {
+            ExceptionHandler handler;
+            READ_BYTES(&handler, sizeof(ExceptionHandler));
+            if (handler.start < 0 || handler.end > instruction_count ||
+                handler.handler < 0 || handler.handler >= instruction_count) {
+                return false;
+            }
+            addExceptionHandler(vm, chunk, handler);
+        }
+    }
+
     return true;
 
     #undef READ_BYTES
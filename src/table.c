@@ -68,6 +68,15 @@ bool tableGet(Table* table, ObjString* key, Value* value) {
     return true;
 }
 
+// Returns the live entry for key, or NULL. The entry stays valid until the
+// table is next resized or the key is deleted.
+Entry* tableGetEntry(Table* table, ObjString* key) {
+    if (table->count == 0) return NULL;
+
+    Entry* entry = findEntry(table->entries, table->capacity, key);
+    return entry->key == NULL ? NULL : entry;
+}
+
 static void adjustCapacity(VM* vm, Table* table, int capacity) {
     Entry* entries = (Entry*)reallocate(vm, NULL, 0, sizeof(Entry) * capacity);
     for (int i = 0; i < capacity; i++) {
@@ -114,6 +123,36 @@ bool tableSet(VM* vm, Table* table, ObjString* key, Value value) {
     return isNewKey;
 }
 
+// Removes every entry but keeps the allocated capacity
+void tableClear(Table* table) {
+    for (int i = 0; i < table->capacity; i++) {
+        table->entries[i].key = NULL;
+        table->entries[i].value = NULL_VAL;
+    }
+    table->count = 0;
+}
+
+// Grows table once so that count more keys fit without another resize.
+// Allocates, so the caller keeps whatever owns the table reachable.
+void tableReserve(VM* vm, Table* table, int count) {
+    int needed = table->count + count;
+    if (needed <= table->capacity * TABLE_MAX_LOAD) return;
+
+    int capacity = table->capacity < 8 ? 8 : table->capacity;
+    while (needed > capacity * TABLE_MAX_LOAD) capacity *= 2;
+    adjustCapacity(vm, table, capacity);
+}
+
+// Copies every entry of from into to, overwriting keys both share. Keys are
+// interned and carry their hash, so each copy is a single probe.
+void tableAddAll(VM* vm, Table* from, Table* to) {
+    tableReserve(vm, to, from->count);
+    for (int i = 0; i < from->capacity; i++) {
+        Entry* entry = &from->entries[i];
+        if (entry->key != NULL) tableSet(vm, to, entry->key, entry->value);
+    }
+}
+
 bool tableDelete(Table* table, ObjString* key) {
     if (table->count == 0) return false;
 
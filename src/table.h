@@ -9,7 +9,11 @@ typedef struct VM VM;
 void initTable(Table* table);
 void freeTable(VM* vm, Table* table);
 bool tableGet(Table* table, ObjString* key, Value* value);
+Entry* tableGetEntry(Table* table, ObjString* key);
 bool tableSet(VM* vm, Table* table, ObjString* key, Value value);
 bool tableDelete(Table* table, ObjString* key);
+void tableClear(Table* table);
+void tableReserve(VM* vm, Table* table, int count);
+void tableAddAll(VM* vm, Table* from, Table* to);
 ObjString* tableFindString(Table* table, const char* chars, int length, uint32_t hash);
 void tableRemoveWhite(Table* table);
\ No newline at end of file
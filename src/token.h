@@ -66,6 +66,7 @@ typedef enum {
     TOKEN_BITWISE,
     TOKEN_BREAK,
     TOKEN_CASE,
+    TOKEN_CATCH,
     TOKEN_CONTINUE,
     TOKEN_DEFAULT,
     TOKEN_DO,
@@ -81,7 +82,9 @@ typedef enum {
     TOKEN_RETURN,
     TOKEN_STRUCT,
     TOKEN_SWITCH,
+    TOKEN_THROW,
     TOKEN_TRUE,
+    TOKEN_TRY,
     TOKEN_VAR,
     TOKEN_WHILE,
 
@@ -234,52 +234,24 @@ bool utf8_substring(const char* str, int byte_len,
     return true;
 }
 
-char* utf8_toupper(ZymAllocator* alloc, const char* str, int byte_len, int* out_len) {
-    if (str == NULL || byte_len == 0) {
-        *out_len = 0;
-        return NULL;
-    }
-
-    char* result = (char*)ZYM_ALLOC(alloc, byte_len + 1);
-    if (result == NULL) {
-        *out_len = 0;
-        return NULL;
-    }
-
+// ASCII case mapping into out (byte_len bytes); other bytes pass through, so
+// the result is always the same length as the input
+void utf8_toupper(const char* str, int byte_len, char* out) {
     for (int i = 0; i < byte_len; i++) {
         if ((unsigned char)str[i] < 0x80) {
-            result[i] = toupper((unsigned char)str[i]);
+            out[i] = toupper((unsigned char)str[i]);
         } else {
-            result[i] = str[i];
+            out[i] = str[i];
         }
     }
-
-    result[byte_len] = '\0';
-    *out_len = byte_len;
-    return result;
 }
 
-char* utf8_tolower(ZymAllocator* alloc, const char* str, int byte_len, int* out_len) {
-    if (str == NULL || byte_len == 0) {
-        *out_len = 0;
-        return NULL;
-    }
-
-    char* result = (char*)ZYM_ALLOC(alloc, byte_len + 1);
-    if (result == NULL) {
-        *out_len = 0;
-        return NULL;
-    }
-
+void utf8_tolower(const char* str, int byte_len, char* out) {
     for (int i = 0; i < byte_len; i++) {
         if ((unsigned char)str[i] < 0x80) {
-            result[i] = tolower((unsigned char)str[i]);
+            out[i] = tolower((unsigned char)str[i]);
         } else {
-            result[i] = str[i];
+            out[i] = str[i];
         }
     }
-
-    result[byte_len] = '\0';
-    *out_len = byte_len;
-    return result;
 }
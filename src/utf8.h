@@ -23,7 +23,7 @@ bool utf8_substring(const char* str, int byte_len,
                     int start_char, int end_char,
                     int* out_start_byte, int* out_end_byte);
 
-char* utf8_toupper(ZymAllocator* alloc, const char* str, int byte_len, int* out_len);
-char* utf8_tolower(ZymAllocator* alloc, const char* str, int byte_len, int* out_len);
+void utf8_toupper(const char* str, int byte_len, char* out);
+void utf8_tolower(const char* str, int byte_len, char* out);
 
 #endif
@@ -78,17 +78,7 @@ static void printValueHelper(VM* vm, Value value, Obj** visited, int depth) {
         int variant_idx = ENUM_VARIANT(value);
 
         if (vm != NULL) {
-            ObjEnumSchema* schema = NULL;
-            for (int i = 0; i < vm->globals.capacity; i++) {
-                Entry* entry = &vm->globals.entries[i];
-                if (entry->key != NULL && IS_OBJ(entry->value) && IS_ENUM_SCHEMA(entry->value)) {
-                    ObjEnumSchema* candidate = AS_ENUM_SCHEMA(entry->value);
-                    if (candidate->type_id == type_id) {
-                        schema = candidate;
-                        break;
-                    }
-                }
-            }
+            ObjEnumSchema* schema = findEnumSchema(vm, type_id);
 
             if (schema != NULL && variant_idx >= 0 && variant_idx < schema->variant_count) {
                 ObjString* variant_name = schema->variant_names[variant_idx];
@@ -201,6 +191,26 @@ static void printValueHelper(VM* vm, Value value, Obj** visited, int depth) {
                 printf("<continuation %s, %d frames>", state_str, cont->frame_count);
                 break;
             }
+            case OBJ_USERDATA_TYPE: {
+                ObjUserdataType* type = AS_USERDATA_TYPE(value);
+                printf("<userdata type %.*s>", type->name->length, type->name->chars);
+                break;
+            }
+            case OBJ_USERDATA: {
+                ObjUserdata* userdata = AS_USERDATA(value);
+                printf("<%.*s userdata>", userdata->type->name->length, userdata->type->name->chars);
+                break;
+            }
+            case OBJ_VEC: {
+                ObjVec* vec = AS_VEC(value);
+                printf("vec%d(", vec->size);
+                for (int i = 0; i < vec->size; i++) {
+                    if (i > 0) printf(", ");
+                    printDouble(vec->comps[i]);
+                }
+                printf(")");
+                break;
+            }
             case OBJ_MAP: {
                     ObjMap* map = AS_MAP(value);
                     printf("{");
@@ -290,6 +300,7 @@ Value cloneValue(VM* vm, Value value) {
                 ObjMap* original = (ObjMap*)obj;
                 ObjMap* cloned = newMap(vm);
                 pushTempRoot(vm, (Obj*)cloned);
+                tableReserve(vm, &cloned->table, original->table.count);
                 for (int i = 0; i < original->table.capacity; i++) {
                     Entry* entry = &original->table.entries[i];
                     if (entry->key != NULL) {
@@ -313,6 +324,12 @@ Value cloneValue(VM* vm, Value value) {
                 return value;
             case OBJ_STRUCT_SCHEMA:
                 return value;
+            case OBJ_USERDATA_TYPE:
+            case OBJ_USERDATA:
+                return value;
+            case OBJ_VEC:
+                // Vectors are immutable, so a copy could never be told apart
+                return value;
             case OBJ_STRUCT_INSTANCE: {
                 ObjStructInstance* original = (ObjStructInstance*)obj;
                 ObjStructInstance* cloned = newStructInstance(vm, original->schema);
@@ -445,6 +462,7 @@ static Value deepCloneHelper(VM* vm, Value value, CloneMap* visited, int depth)
 
             pushTempRoot(vm, (Obj*)cloned);
             cloneMapPut(vm, visited, obj, OBJ_VAL(cloned));
+            tableReserve(vm, &cloned->table, original->table.count);
 
             for (int i = 0; i < original->table.capacity; i++) {
                 Entry* entry = &original->table.entries[i];
@@ -483,6 +501,9 @@ static Value deepCloneHelper(VM* vm, Value value, CloneMap* visited, int depth)
         case OBJ_DISPATCHER:
         case OBJ_STRUCT_SCHEMA:
         case OBJ_ENUM_SCHEMA:
+        case OBJ_USERDATA_TYPE:
+        case OBJ_USERDATA:
+        case OBJ_VEC:
             return value;
 
         default:
@@ -13,6 +13,7 @@
 #include "./ast.h"
 #include "./gc.h"
 #include "./native.h"
+#include "./profile.h"
 #include "zym/zym.h"
 #include "./modules/continuation.h"
 #include "./modules/core_modules.h"
@@ -48,6 +49,8 @@ void initVM(VM* vm) {
     vm->current_frame = NULL;
 
     vm->objects = NULL;
+    vm->live_external_strings = 0;
+    vm->reader_type = NULL;
     vm->bytes_allocated = 0;
     vm->next_gc = 1024 * 1024;
     vm->gc_debt = INT32_MAX;  // GC starts disabled during init
@@ -55,7 +58,14 @@ void initVM(VM* vm) {
     vm->gray_capacity = 0;
     vm->gray_stack = NULL;
     vm->gc_enabled = false;
+    vm->garbage_handler = NULL;
+    vm->garbage_user_data = NULL;
+    for (int i = 0; i < VEC_MAX_SIZE - VEC_MIN_SIZE + 1; i++) {
+        vm->vec_freelist[i] = NULL;
+        vm->vec_free_count[i] = 0;
+    }
     vm->compiler = NULL;
+    vm->lazy_units = NULL;
     vm->temp_roots = NULL;
     vm->temp_root_count = 0;
     vm->temp_root_capacity = 0;
@@ -68,9 +78,17 @@ void initVM(VM* vm) {
     initTable(&vm->globals);
     initValueArray(&vm->globalSlots);
     initTable(&vm->strings);
+    initTable(&vm->reset_globals);
+    initValueArray(&vm->reset_slots);
+    vm->reset_enum_type_id = 1;
+    vm->reset_preemption_enabled = false;
+    vm->reset_default_timeslice = DEFAULT_TIMESLICE;
+    vm->reset_preempt_callback = NULL_VAL;
     vm->open_upvalues = NULL;
     vm->api_stack_top = 0;
     vm->next_enum_type_id = 1;
+    vm->enum_schemas = NULL;
+    vm->enum_schema_capacity = 0;
     vm->entry_file = NULL;
 
     initChunk(&vm->api_trampoline);
@@ -79,11 +97,13 @@ void initVM(VM* vm) {
 
     vm->prompt_count = 0;
     vm->next_prompt_tag_id = 1;
+    vm->native_call_slot = -1;
 
     vm->preempt_counter = INT32_MAX;
     vm->saved_budget = DEFAULT_TIMESLICE;
     vm->default_timeslice = DEFAULT_TIMESLICE;
     vm->preempt_requested = false;
+    atomic_init(&vm->preempt_signal, false);
     vm->preemption_enabled = false;
     vm->preemption_disable_depth = 0;
     vm->on_preempt_callback = NULL_VAL;
@@ -91,8 +111,22 @@ void initVM(VM* vm) {
     vm->resume_depth = 0;
     vm->with_prompt_depth = 0;
 
+    vm->profile_jump = NULL;
+    vm->profile_jump_index = 0;
+    vm->profile_fallthrough = 0;
+
     vm->error_callback = NULL;
     vm->error_user_data = NULL;
+    vm->runtime_error_handler = NULL;
+    vm->runtime_error_user_data = NULL;
+    vm->error.message = NULL;
+    vm->error.message_length = 0;
+    vm->error.message_capacity = 0;
+    vm->error.frames = NULL;
+    vm->error.frame_count = 0;
+    vm->error.frame_capacity = 0;
+    vm->exec_depth = 0;
+    vm->error_thrown = false;
 
     vm->gc_enabled = true;
     // Recalculate debt: headroom = next_gc - bytes_allocated, clamped to INT32_MAX
@@ -102,6 +136,7 @@ void initVM(VM* vm) {
     }
 
     setupCoreModules(vm);
+    checkpointVM(vm);
 }
 
 void freeVM(VM* vm) {
@@ -111,13 +146,18 @@ void freeVM(VM* vm) {
     freeTable(vm, &vm->globals);
     freeValueArray(vm, &vm->globalSlots);
     freeTable(vm, &vm->strings);
+    freeTable(vm, &vm->reset_globals);
+    freeValueArray(vm, &vm->reset_slots);
     freeChunk(vm, &vm->api_trampoline);
+    FREE_ARRAY(vm, ObjEnumSchema*, vm->enum_schemas, vm->enum_schema_capacity);
+    vm->enum_schemas = NULL;
+    vm->enum_schema_capacity = 0;
 
     Obj* object = vm->objects;
     while (object != NULL) {
         Obj* next = object->next;
 
-        if (object->type < 0 || object->type > OBJ_CONTINUATION) {
+        if (object->type < 0 || object->type > OBJ_VEC) {
             fprintf(stderr, "ERROR: Corrupted object detected at %p with invalid type %d during VM cleanup\n",
                     (void*)object, object->type);
             fprintf(stderr, "Stopping cleanup to prevent cascading corruption. This indicates a memory management bug.\n");
@@ -127,9 +167,12 @@ void freeVM(VM* vm) {
         freeObject(vm, object);
         object = next;
     }
+    releaseVecFreelists(vm);
 
     ZYM_FREE(&vm->allocator, vm->gray_stack, sizeof(Obj*) * vm->gray_capacity);
     ZYM_FREE(&vm->allocator, vm->temp_roots, sizeof(Obj*) * vm->temp_root_capacity);
+    ZYM_FREE(&vm->allocator, vm->error.message, (size_t)vm->error.message_capacity);
+    ZYM_FREE(&vm->allocator, vm->error.frames, sizeof(ErrorFrame) * vm->error.frame_capacity);
 
     reallocate(vm, vm->stack, sizeof(Value) * vm->stack_capacity, 0);
     vm->stack = NULL;
@@ -137,6 +180,71 @@ void freeVM(VM* vm) {
     vm->stack_top = 0;
 }
 
+// Remember the current globals as the state resetVM returns to. Objects they
+// reach stay alive across resets; their contents are not snapshotted.
+void checkpointVM(VM* vm) {
+    freeTable(vm, &vm->reset_globals);
+    tableAddAll(vm, &vm->globals, &vm->reset_globals);
+
+    vm->reset_slots.count = 0;
+    for (int i = 0; i < vm->globalSlots.count; i++) {
+        writeValueArray(vm, &vm->reset_slots, vm->globalSlots.values[i]);
+    }
+    vm->reset_enum_type_id = vm->next_enum_type_id;
+    vm->reset_preemption_enabled = vm->preemption_enabled;
+    vm->reset_default_timeslice = vm->default_timeslice;
+    vm->reset_preempt_callback = vm->on_preempt_callback;
+}
+
+// Drop everything created since the checkpoint so the VM can serve another
+// script. The stack, tables and interned names keep their grown capacity; a
+// full collection then frees the script's objects. Must not run while the
+// VM is executing.
+void resetVM(VM* vm) {
+    vm->chunk = NULL;
+    vm->ip = NULL;
+    vm->frame_count = 0;
+    vm->cur_base = 0;
+    vm->active_boundaries = 0;
+    vm->current_frame = NULL;
+    vm->open_upvalues = NULL;
+    vm->api_stack_top = 0;
+    vm->temp_root_count = 0;
+    vm->entry_file = NULL;
+    for (int i = 0; i < vm->stack_capacity; i++) vm->stack[i] = NULL_VAL;
+    vm->stack_top = 0;
+
+    vm->prompt_count = 0;
+    vm->resume_depth = 0;
+    vm->with_prompt_depth = 0;
+
+    vm->preemption_enabled = vm->reset_preemption_enabled;
+    vm->default_timeslice = vm->reset_default_timeslice;
+    vm->preempt_counter = vm->preemption_enabled ? preemptionBudget(vm) : INT32_MAX;
+    vm->saved_budget = vm->default_timeslice;
+    vm->preempt_requested = false;
+    atomic_store(&vm->preempt_signal, false);
+    vm->preemption_disable_depth = 0;
+    vm->on_preempt_callback = vm->reset_preempt_callback;
+    vm->profile_jump = NULL;
+    clearRuntimeError(vm);
+
+    // Globals go back to the checkpoint in place, keeping table capacity
+    tableClear(&vm->globals);
+    tableAddAll(vm, &vm->reset_globals, &vm->globals);
+    if (vm->reset_slots.count > 0) {
+        memcpy(vm->globalSlots.values, vm->reset_slots.values, sizeof(Value) * vm->reset_slots.count);
+    }
+    vm->globalSlots.count = vm->reset_slots.count;
+
+    for (int i = vm->reset_enum_type_id; i < vm->enum_schema_capacity; i++) {
+        vm->enum_schemas[i] = NULL;
+    }
+    vm->next_enum_type_id = vm->reset_enum_type_id;
+
+    collectGarbage(vm);
+}
+
 bool globalGet(VM* vm, ObjString* name, Value* out_value) {
     Value slot_or_value;
     if (!tableGet(&vm->globals, name, &slot_or_value)) {
@@ -173,132 +281,206 @@ static int line_at_ip(Chunk* chunk, uint32_t* ip) {
     return chunk->lines[(int)idx];
 }
 
-void runtimeError(VM* vm, const char* format, ...) {
-    // Format the error message
-    char msg_buf[1024];
+int errorFrameLine(const ErrorFrame* frame) {
+    return line_at_ip(frame->chunk, frame->ip);
+}
+
+// Top-level code and module bodies print as <script>
+const char* errorFrameFunctionName(const ErrorFrame* frame, int* out_len) {
+    ObjFunction* function = frame->function;
+    if (function && function->name &&
+        !(function->name->length > 9 && memcmp(function->name->chars, "__module_", 9) == 0)) {
+        *out_len = function->name->length;
+        return function->name->chars;
+    }
+    *out_len = 8;
+    return "<script>";
+}
+
+static void recordErrorFrame(VM* vm, ObjFunction* function, Chunk* chunk, uint32_t* ip) {
+    ErrorFrame* frame = &vm->error.frames[vm->error.frame_count++];
+    frame->function = function;
+    frame->file = function && function->module_name ? function->module_name : vm->entry_file;
+    frame->chunk = chunk;
+    frame->ip = ip;
+}
+
+// Capture the message and the raw call stack. Nothing is formatted here;
+// see formatRuntimeError.
+static void captureRuntimeError(VM* vm, const char* format, va_list args) {
+    ErrorRecord* error = &vm->error;
+
+    va_list measure;
+    va_copy(measure, args);
+    int length = vsnprintf(error->message, (size_t)error->message_capacity, format, measure);
+    va_end(measure);
+    if (length < 0) length = 0;
+    if (length >= error->message_capacity) {
+        int capacity = length + 1;
+        error->message = (char*)ZYM_REALLOC(&vm->allocator, error->message,
+            (size_t)error->message_capacity, (size_t)capacity);
+        if (error->message == NULL) {
+            fprintf(stderr, "Fatal: Out of memory for runtime error\n");
+            exit(1);
+        }
+        error->message_capacity = capacity;
+        vsnprintf(error->message, (size_t)capacity, format, args);
+    }
+    error->message[length] = '\0';
+    error->message_length = length;
+
+    int needed = vm->frame_count + 1;
+    if (needed > error->frame_capacity) {
+        error->frames = (ErrorFrame*)ZYM_REALLOC(&vm->allocator, error->frames,
+            sizeof(ErrorFrame) * error->frame_capacity, sizeof(ErrorFrame) * needed);
+        if (error->frames == NULL) {
+            fprintf(stderr, "Fatal: Out of memory for runtime error\n");
+            exit(1);
+        }
+        error->frame_capacity = needed;
+    }
+
+    // Where the error was raised, then the call site in each caller
+    error->frame_count = 0;
+    if (vm->frame_count > 0) {
+        ObjFunction* function = vm->frames[vm->frame_count - 1].closure->function;
+        recordErrorFrame(vm, function, function ? &function->chunk : vm->chunk, vm->ip);
+    } else {
+        recordErrorFrame(vm, NULL, vm->chunk, vm->ip);
+    }
+    for (int i = (int)vm->frame_count - 1; i >= 0; --i) {
+        CallFrame* f = &vm->frames[i];
+        ObjFunction* caller = i > 0 ? vm->frames[i - 1].closure->function : NULL;
+        recordErrorFrame(vm, caller, f->caller_chunk ? f->caller_chunk : vm->chunk, f->ip);
+    }
+}
+
+void clearRuntimeError(VM* vm) {
+    vm->error.frame_count = 0;
+    vm->error.message_length = 0;
+}
+
+typedef struct {
+    char* buffer;
+    size_t size;
+    size_t length;
+} ErrorText;
+
+static void appendErrorText(ErrorText* text, const char* format, ...) {
+    size_t room = text->length < text->size ? text->size - text->length : 0;
     va_list args;
     va_start(args, format);
-    int msg_len = vsnprintf(msg_buf, sizeof(msg_buf), format, args);
+    int written = vsnprintf(room > 0 ? text->buffer + text->length : NULL, room, format, args);
     va_end(args);
-    if (msg_len < 0) msg_len = 0;
+    if (written > 0) text->length += (size_t)written;
+}
 
-    // Determine file and line for the error location
-    const char* err_file = NULL;
-    int err_line = -1;
+// Render the held error as message, location and stack trace. Follows
+// snprintf: writes at most size bytes and returns the full length.
+int formatRuntimeError(VM* vm, char* buffer, size_t size) {
+    ErrorText text = {buffer, size, 0};
+    if (size > 0) buffer[0] = '\0';
+    if (vm->error.frame_count == 0) return 0;
 
-    if (vm->frame_count > 0) {
-        CallFrame* cur = &vm->frames[vm->frame_count - 1];
-        Chunk* cur_chunk = cur->closure->function ? &cur->closure->function->chunk : vm->chunk;
-        err_line = line_at_ip(cur_chunk, vm->ip);
-        if (cur->closure->function && cur->closure->function->module_name) {
-            err_file = cur->closure->function->module_name->chars;
-        } else if (vm->entry_file) {
-            err_file = vm->entry_file->chars;
-        }
+    appendErrorText(&text, "%s\n", vm->error.message);
+
+    ErrorFrame* site = &vm->error.frames[0];
+    if (site->file) {
+        appendErrorText(&text, "[%s] line %d\n", site->file->chars, errorFrameLine(site));
     } else {
-        err_line = line_at_ip(vm->chunk, vm->ip);
-        if (vm->entry_file) {
-            err_file = vm->entry_file->chars;
-        }
+        appendErrorText(&text, "[line %d]\n", errorFrameLine(site));
     }
 
-    if (vm->error_callback) {
-        // Build the full message with location and stack trace into a buffer
-        char full_buf[4096];
-        int pos = 0;
+    for (int i = 1; i < vm->error.frame_count; i++) {
+        ErrorFrame* frame = &vm->error.frames[i];
+        int name_len;
+        const char* name = errorFrameFunctionName(frame, &name_len);
+        if (frame->file) {
+            appendErrorText(&text, "    at [%s] line %d", frame->file->chars, errorFrameLine(frame));
+        } else {
+            appendErrorText(&text, "    at [line %d]", errorFrameLine(frame));
+        }
+        appendErrorText(&text, " (called from %.*s)\n", name_len, name);
+    }
 
-        // Error message
-        pos += snprintf(full_buf + pos, sizeof(full_buf) - pos, "%s\n", msg_buf);
+    return (int)text.length;
+}
 
-        // Location
-        if (err_file) {
-            pos += snprintf(full_buf + pos, sizeof(full_buf) - pos, "[%s] line %d\n", err_file, err_line);
-        } else {
-            pos += snprintf(full_buf + pos, sizeof(full_buf) - pos, "[line %d]\n", err_line);
-        }
-
-        // Stack trace
-        for (int i = (int)vm->frame_count - 1; i >= 0 && pos < (int)sizeof(full_buf) - 1; --i) {
-            CallFrame* f = &vm->frames[i];
-            Chunk* caller_chunk = f->caller_chunk ? f->caller_chunk : vm->chunk;
-            int call_line = line_at_ip(caller_chunk, f->ip);
-
-            const char* call_file = NULL;
-            const char* caller_name = "<script>";
-            int caller_len = 8;
-
-            if (i > 0) {
-                ObjFunction* caller_fn = vm->frames[i - 1].closure->function;
-                if (caller_fn && caller_fn->name) {
-                    caller_name = caller_fn->name->chars;
-                    caller_len  = caller_fn->name->length;
-                    if (caller_len > 9 && memcmp(caller_name, "__module_", 9) == 0) {
-                        caller_name = "<script>";
-                        caller_len = 8;
-                    }
-                }
-                if (caller_fn && caller_fn->module_name) {
-                    call_file = caller_fn->module_name->chars;
-                }
+// The innermost handler covering the current instruction. Callers are searched
+// outward, but never past a host call or a preemption callback: what they
+// return to is C code or a saved timeslice, not a frame a handler can resume.
+// *out_depth and *out_chunk receive the frame count and code the handler runs at.
+static const ExceptionHandler* findHandler(VM* vm, int* out_depth, Chunk** out_chunk) {
+    Chunk* chunk = vm->chunk;
+    uint32_t* ip = vm->ip;
+    int depth = vm->frame_count;
+
+    for (;;) {
+        if (chunk != NULL && chunk->handler_count > 0 &&
+            ip > chunk->code && ip <= chunk->code + chunk->count) {
+            const ExceptionHandler* handler = findExceptionHandler(chunk, (int)(ip - chunk->code) - 1);
+            if (handler != NULL) {
+                *out_depth = depth;
+                *out_chunk = chunk;
+                return handler;
             }
+        }
 
-            pos += snprintf(full_buf + pos, sizeof(full_buf) - pos, "    at ");
-            if (call_file) {
-                pos += snprintf(full_buf + pos, sizeof(full_buf) - pos, "[%s] line %d", call_file, call_line);
-            } else if (vm->entry_file) {
-                pos += snprintf(full_buf + pos, sizeof(full_buf) - pos, "[%s] line %d", vm->entry_file->chars, call_line);
-            } else {
-                pos += snprintf(full_buf + pos, sizeof(full_buf) - pos, "[line %d]", call_line);
-            }
-            pos += snprintf(full_buf + pos, sizeof(full_buf) - pos, " (called from %.*s)\n", caller_len, caller_name);
+        if (depth == 0) return NULL;
+        CallFrame* frame = &vm->frames[depth - 1];
+        if (frame->caller_chunk == &vm->api_trampoline || (frame->flags & FRAME_FLAG_PREEMPT)) {
+            return NULL;
         }
+        chunk = frame->caller_chunk;
+        ip = frame->ip;
+        depth--;
+    }
+}
+
+static void reportRuntimeError(VM* vm) {
+    if (vm->runtime_error_handler) {
+        vm->runtime_error_handler(vm, vm->runtime_error_user_data);
+        return;
+    }
 
-        vm->error_callback(vm, ZYM_STATUS_RUNTIME_ERROR, err_file, err_line, full_buf, vm->error_user_data);
+    size_t length = (size_t)formatRuntimeError(vm, NULL, 0);
+    char* text = (char*)ZYM_ALLOC(&vm->allocator, length + 1);
+    if (text == NULL) {
+        fprintf(stderr, "Fatal: Out of memory for runtime error\n");
+        exit(1);
+    }
+    formatRuntimeError(vm, text, length + 1);
+
+    if (vm->error_callback) {
+        ErrorFrame* site = &vm->error.frames[0];
+        vm->error_callback(vm, ZYM_STATUS_RUNTIME_ERROR, site->file ? site->file->chars : NULL,
+                           errorFrameLine(site), text, vm->error_user_data);
     } else {
-        // Default: write to stderr (original behavior)
-        fprintf(stderr, "%s\n", msg_buf);
+        // Default: write to stderr
+        fputs(text, stderr);
+    }
+    ZYM_FREE(&vm->allocator, text, length + 1);
+}
 
-        if (err_file) {
-            fprintf(stderr, "[%s] line %d\n", err_file, err_line);
-        } else {
-            fprintf(stderr, "[line %d]\n", err_line);
-        }
-
-        for (int i = (int)vm->frame_count - 1; i >= 0; --i) {
-            CallFrame* f = &vm->frames[i];
-            Chunk* caller_chunk = f->caller_chunk ? f->caller_chunk : vm->chunk;
-            int call_line = line_at_ip(caller_chunk, f->ip);
-
-            const char* call_file = NULL;
-            const char* caller_name = "<script>";
-            int caller_len = 8;
-
-            if (i > 0) {
-                ObjFunction* caller_fn = vm->frames[i - 1].closure->function;
-                if (caller_fn && caller_fn->name) {
-                    caller_name = caller_fn->name->chars;
-                    caller_len  = caller_fn->name->length;
-                    if (caller_len > 9 && memcmp(caller_name, "__module_", 9) == 0) {
-                        caller_name = "<script>";
-                        caller_len = 8;
-                    }
-                }
-                if (caller_fn && caller_fn->module_name) {
-                    call_file = caller_fn->module_name->chars;
-                }
-            }
+void runtimeErrorV(VM* vm, const char* format, va_list args) {
+    captureRuntimeError(vm, format, args);
 
-            fprintf(stderr, "    at ");
-            if (call_file) {
-                fprintf(stderr, "[%s] line %d", call_file, call_line);
-            } else if (vm->entry_file) {
-                fprintf(stderr, "[%s] line %d", vm->entry_file->chars, call_line);
-            } else {
-                fprintf(stderr, "[line %d]", call_line);
-            }
-            fprintf(stderr, " (called from %.*s)\n", caller_len, caller_name);
-        }
+    // An error script code will catch is only recorded here; execute() passes
+    // it to the handler once run() has returned.
+    int depth;
+    Chunk* chunk;
+    if (vm->exec_depth > 0 && findHandler(vm, &depth, &chunk) != NULL) {
+        vm->error_thrown = true;
+        return;
     }
+    reportRuntimeError(vm);
+}
+
+void runtimeError(VM* vm, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    runtimeErrorV(vm, format, args);
+    va_end(args);
 }
 
 static inline int32_t sign_extend_16(uint32_t x) {
@@ -310,22 +492,10 @@ static inline int32_t sign_extend_8(uint32_t x) {
 }
 
 static const char* getEnumNameByTypeId(VM* vm, int type_id, int* out_len) {
-    for (int i = 0; i < vm->globals.capacity; i++) {
-        Entry* entry = &vm->globals.entries[i];
-        if (entry->key == NULL) continue;
-        Value v = entry->value;
-        if (IS_DOUBLE(v)) {
-            int slot = (int)AS_DOUBLE(v);
-            if (slot < 0 || slot >= vm->globalSlots.count) continue;
-            v = vm->globalSlots.values[slot];
-        }
-        if (IS_OBJ(v) && IS_ENUM_SCHEMA(v)) {
-            ObjEnumSchema* schema = AS_ENUM_SCHEMA(v);
-            if (schema->type_id == type_id) {
-                *out_len = schema->name->length;
-                return schema->name->chars;
-            }
-        }
+    ObjEnumSchema* schema = findEnumSchema(vm, type_id);
+    if (schema != NULL) {
+        *out_len = schema->name->length;
+        return schema->name->chars;
     }
     *out_len = 0;
     return NULL;
@@ -342,9 +512,91 @@ static inline bool value_equals(Value x, Value y) {
     if (IS_ENUM(x) || IS_ENUM(y)) {
         return false;
     }
+    if (IS_STRING(x) && IS_STRING(y)) {
+        // Interned strings compare by identity; external ones need the bytes
+        ObjString* a = AS_STRING(x);
+        ObjString* b = AS_STRING(y);
+        if (a->is_external || b->is_external) {
+            return a->byte_length == b->byte_length &&
+                   memcmp(a->chars, b->chars, a->byte_length) == 0;
+        }
+    }
+    if (IS_VEC(x) && IS_VEC(y)) {
+        ObjVec* a = AS_VEC(x);
+        ObjVec* b = AS_VEC(y);
+        if (a->size != b->size) return false;
+        for (int i = 0; i < a->size; i++) {
+            if (a->comps[i] != b->comps[i]) return false;
+        }
+        return true;
+    }
     return false;
 }
 
+typedef enum { VEC_ADD, VEC_SUB, VEC_MUL, VEC_DIV } VecOp;
+
+// Map a component name (x, y, z, w) to its index, or -1.
+static inline int vecComponentIndex(ObjString* key) {
+    if (key->length != 1) return -1;
+    switch (key->chars[0]) {
+        case 'x': return 0;
+        case 'y': return 1;
+        case 'z': return 2;
+        case 'w': return 3;
+        default:  return -1;
+    }
+}
+
+// Component-wise vector arithmetic: vec op vec of equal size, vec * num,
+// num * vec and vec / num. Returns false when the operands are anything else.
+// Allocates, so the caller must reload its stack pointers afterwards.
+static bool vecArith(VM* vm, VecOp op, Value b, Value c, Value* out) {
+    double lhs[VEC_MAX_SIZE];
+    double rhs[VEC_MAX_SIZE];
+    int size;
+
+    if (IS_VEC(b) && IS_VEC(c)) {
+        ObjVec* vb = AS_VEC(b);
+        ObjVec* vc = AS_VEC(c);
+        if (vb->size != vc->size) return false;
+        size = vb->size;
+        memcpy(lhs, vb->comps, sizeof(double) * size);
+        memcpy(rhs, vc->comps, sizeof(double) * size);
+    } else if (IS_VEC(b) && IS_DOUBLE(c) && (op == VEC_MUL || op == VEC_DIV)) {
+        ObjVec* vb = AS_VEC(b);
+        size = vb->size;
+        memcpy(lhs, vb->comps, sizeof(double) * size);
+        for (int i = 0; i < size; i++) rhs[i] = AS_DOUBLE(c);
+    } else if (IS_DOUBLE(b) && IS_VEC(c) && op == VEC_MUL) {
+        ObjVec* vc = AS_VEC(c);
+        size = vc->size;
+        for (int i = 0; i < size; i++) lhs[i] = AS_DOUBLE(b);
+        memcpy(rhs, vc->comps, sizeof(double) * size);
+    } else {
+        return false;
+    }
+
+    ObjVec* result = newVec(vm, size);
+    for (int i = 0; i < size; i++) {
+        switch (op) {
+            case VEC_ADD: result->comps[i] = lhs[i] + rhs[i]; break;
+            case VEC_SUB: result->comps[i] = lhs[i] - rhs[i]; break;
+            case VEC_MUL: result->comps[i] = lhs[i] * rhs[i]; break;
+            case VEC_DIV: result->comps[i] = lhs[i] / rhs[i]; break;
+        }
+    }
+    *out = OBJ_VAL(result);
+    return true;
+}
+
+// Null the result registers [have, want) a destructuring caller expects but
+// the callee did not return.
+static inline void fillMissingResults(Value* results, int have, int want) {
+    for (int i = have; i < want; i++) {
+        results[i] = NULL_VAL;
+    }
+}
+
 static ObjUpvalue* captureUpvalue(VM* vm, Value* local) {
     ObjUpvalue* prevUpvalue = NULL;
     ObjUpvalue* upvalue = vm->open_upvalues;
@@ -416,6 +668,7 @@ void unwindFrames(VM* vm, int new_frame_count) {
         CallFrame* frame = &vm->frames[--vm->frame_count];
         if (frame->flags & (FRAME_FLAG_PREEMPT | FRAME_FLAG_DISABLE_PREEMPT)) {
             vm->preemption_disable_depth--;
+            preemptionRearmPending(vm);
         }
     }
     vm->cur_base = vm->frame_count == 0 ? 0 : vm->frames[vm->frame_count - 1].stack_base;
@@ -428,6 +681,48 @@ void unwindFrames(VM* vm, int new_frame_count) {
     }
 }
 
+// Resume at the innermost handler for the current instruction with value in
+// its exception register, discarding the frames in between. Returns false,
+// leaving the VM untouched, when no handler is in reach.
+static bool throwValue(VM* vm, Value value) {
+    int depth;
+    Chunk* chunk;
+    const ExceptionHandler* handler = findHandler(vm, &depth, &chunk);
+    if (handler == NULL) return false;
+
+    int base = depth == 0 ? 0 : vm->frames[depth - 1].stack_base;
+    closeUpvalues(vm, &vm->stack[base + handler->close_from]);
+
+    // Prompts go with the frames that pushed them. A withPrompt boundary at
+    // exactly this depth was entered from the handler's own frame, so its
+    // prompt goes too; a prompt that frame pushed by hand stays.
+    int boundaries_here = 0;
+    for (int i = vm->with_prompt_depth - 1; i >= 0 && vm->with_prompt_stack[i].frame_boundary >= depth; i--) {
+        if (vm->with_prompt_stack[i].frame_boundary == depth) boundaries_here++;
+    }
+    while (vm->prompt_count > 0) {
+        int frame_index = vm->prompt_stack[vm->prompt_count - 1].frame_index;
+        if (frame_index > depth) {
+            popPrompt(vm);
+        } else if (frame_index == depth && boundaries_here > 0) {
+            popPrompt(vm);
+            boundaries_here--;
+        } else {
+            break;
+        }
+    }
+    unwindFrames(vm, depth);
+    while (vm->resume_depth > 0 && vm->resume_stack[vm->resume_depth - 1].frame_boundary >= depth) {
+        vm->resume_depth--;
+        vm->active_boundaries--;
+    }
+
+    vm->chunk = chunk;
+    vm->ip = chunk->code + handler->handler;
+    vm->stack[base + handler->reg] = value;
+    return true;
+}
+
 static bool validateUpvalue(VM* vm, ObjUpvalue* upvalue, const char* context) {
     if (upvalue == NULL || upvalue->location == NULL) {
         runtimeError(vm, "Invalid upvalue reference in %s.", context);
@@ -446,7 +741,7 @@ static bool validateListIndex(VM* vm, ObjList* list, int idx, const char* contex
 
 static ObjString* keyToString(VM* vm, Value key_val) {
     if (IS_STRING(key_val)) {
-        return AS_STRING(key_val);
+        return internString(vm, AS_STRING(key_val));
     } else if (IS_DOUBLE(key_val)) {
         char buffer[64];
         double num = AS_DOUBLE(key_val);
@@ -460,6 +755,45 @@ static ObjString* keyToString(VM* vm, Value key_val) {
     return NULL;
 }
 
+// Inline-cached table lookup: slot holds the entry index of the last hit.
+// The value is read fresh, so reassigning the entry never goes stale.
+static inline Value lookupCachedEntry(Table* table, ObjString* key, uint32_t* slot) {
+    uint32_t cached = *slot;
+    if (cached < (uint32_t)table->capacity && table->entries[cached].key == key) {
+        return table->entries[cached].value;
+    }
+    Entry* entry = tableGetEntry(table, key);
+    if (entry == NULL) return NULL_VAL;
+    *slot = (uint32_t)(entry - table->entries);
+    return entry->value;
+}
+
+// Method of a userdata value as a first-class value (receiver bound in).
+// Returns NULL_VAL if the type has no such method.
+static Value getUserdataMethod(VM* vm, Value receiver, ObjString* key) {
+    Value method;
+    if (!tableGet(&AS_USERDATA(receiver)->type->methods, key, &method)) {
+        return NULL_VAL;
+    }
+    return OBJ_VAL(bindNativeMethod(vm, AS_NATIVE_CLOSURE(method), receiver));
+}
+
+// Concatenate count string operands into one freshly interned string.
+// byte_len is the precomputed sum of the operand byte lengths.
+static ObjString* concatStrings(VM* vm, Value* operands, int count, int byte_len) {
+    char* chars = (char*)reallocate(vm, NULL, 0, byte_len + 1);
+    char* out = chars;
+    for (int i = 0; i < count; i++) {
+        ObjString* part = AS_STRING(operands[i]);
+        memcpy(out, part->chars, part->byte_length);
+        out += part->byte_length;
+    }
+    chars[byte_len] = '\0';
+
+    // takeString takes ownership of the 'chars' buffer
+    return takeString(vm, chars, byte_len);
+}
+
 static Value resolveOverload(VM* vm, ObjDispatcher* dispatcher, uint16_t arg_count) {
     // Try exact arity match first
     for (int i = 0; i < dispatcher->count; i++) {
@@ -549,6 +883,10 @@ static bool pushPreemptFrame(VM* vm) {
         return false;
     }
 
+    if (!ensureFunctionCompiled(vm, function)) {
+        return false;
+    }
+
     int callee_slot = vm->stack_top;
     int needed_top = callee_slot + function->max_regs;
 
@@ -566,6 +904,7 @@ static bool pushPreemptFrame(VM* vm) {
     frame->caller_chunk = vm->chunk;
     frame->flags        = FRAME_FLAG_PREEMPT;
     frame->arg_count    = 0;
+    frame->result_count = 0;
 
     vm->current_frame = frame;
     vm->cur_base = callee_slot;
@@ -580,14 +919,21 @@ static bool pushPreemptFrame(VM* vm) {
 // --- Cold preemption handler: outlined from DISPATCH to reduce I-cache pressure ---
 __attribute__((noinline, cold))
 static InterpretResult handlePreemption(VM* vm) {
+    bool signalled = atomic_exchange_explicit(&vm->preempt_signal, false, memory_order_relaxed);
     if (!vm->preemption_enabled || vm->preemption_disable_depth > 0) {
-        // Spurious trigger: counter wrapped from INT32_MAX or preempt_requested while disabled
+        // Not preemptible right now: latch any request for preemptionRearmPending
+        // and park the counter. A bare counter wrap from INT32_MAX is spurious.
+        if (signalled) vm->preempt_requested = true;
+        vm->preempt_counter = INT32_MAX;
+        return INTERPRET_OK;
+    }
+    if (vm->default_timeslice == 0 && !signalled && !vm->preempt_requested) {
+        // Deadline mode: the counter merely wrapped, no request is pending
         vm->preempt_counter = INT32_MAX;
-        vm->preempt_requested = false;
         return INTERPRET_OK;
     }
     // Real preemption
-    vm->preempt_counter = vm->default_timeslice;
+    vm->preempt_counter = preemptionBudget(vm);
     vm->preempt_requested = false;
     if (IS_CLOSURE(vm->on_preempt_callback)) {
         if (pushPreemptFrame(vm)) {
@@ -603,10 +949,8 @@ static InterpretResult vm_error(VM* vm, uint32_t* ip, const char* fmt, ...) {
     vm->ip = ip;
     va_list args;
     va_start(args, fmt);
-    char buf[256];
-    vsnprintf(buf, sizeof(buf), fmt, args);
+    runtimeErrorV(vm, fmt, args);
     va_end(args);
-    runtimeError(vm, "%s", buf);
     return INTERPRET_RUNTIME_ERROR;
 }
 
@@ -696,6 +1040,7 @@ static InterpretResult run(VM* vm) {
         JUMP_ENTRY(TAIL_CALL),
         JUMP_ENTRY(TAIL_CALL_SELF),
         JUMP_ENTRY(RET),
+        JUMP_ENTRY(THROW),
         JUMP_ENTRY(DEFINE_GLOBAL),
         JUMP_ENTRY(GET_GLOBAL),
         JUMP_ENTRY(GET_GLOBAL_CACHED),
@@ -719,7 +1064,10 @@ static InterpretResult run(VM* vm) {
         JUMP_ENTRY(GET_MAP_PROPERTY_L),
         JUMP_ENTRY(SET_MAP_PROPERTY_L),
         JUMP_ENTRY(GET_STRUCT_FIELD_IC),
+        JUMP_ENTRY(GET_VEC_COMPONENT_IC),
         JUMP_ENTRY(SET_STRUCT_FIELD_IC),
+        JUMP_ENTRY(INVOKE),
+        JUMP_ENTRY(CONCAT_N),
         JUMP_ENTRY(NEW_DISPATCHER),
         JUMP_ENTRY(ADD_OVERLOAD),
         JUMP_ENTRY(SET_VARIADIC_FALLBACK),
@@ -750,6 +1098,13 @@ static InterpretResult run(VM* vm) {
     // Reload locals from VM struct after frame changes or stack reallocation
 #define LOAD_STATE()  do { ip = vm->ip; stack = vm->stack; base = vm->cur_base; bp = stack + base; constants = vm->chunk->constants.values; } while(0)
 
+#ifdef ZYM_PROFILE
+#define PROFILE_INSTRUCTION() profileInstruction(vm, ip, bp)
+    vm->profile_jump = NULL;
+#else
+#define PROFILE_INSTRUCTION() ((void)0)
+#endif
+
 #define OP(c) CASE_##c:
 #define DISPATCH() do { \
     if (__builtin_expect(--vm->preempt_counter <= 0, 0)) { \
@@ -758,17 +1113,28 @@ static InterpretResult run(VM* vm) {
         if (_pr == INTERPRET_YIELD) return INTERPRET_YIELD; \
         LOAD_STATE(); \
     } \
+    PROFILE_INSTRUCTION(); \
     instr = *ip++; \
     goto *dispatch_table[OPCODE(instr)]; \
+} while(0)
+    // Back-edges and calls poll the asynchronous request flag; a pending request
+    // zeroes the counter so the next DISPATCH takes the preemption path.
+#define POLL_PREEMPT() do { \
+    if (__builtin_expect(atomic_load_explicit(&vm->preempt_signal, memory_order_relaxed), 0)) \
+        vm->preempt_counter = 0; \
 } while(0)
 #define CUR_BASE() (base)
 #define RELOAD_STACK() do { stack = vm->stack; bp = stack + base; } while(0)
-#define BINARY_OP(op) \
+#define BINARY_OP(op, vec_op) \
     do { \
         Value vb = bp[REG_B(instr)]; \
         Value vc = bp[REG_C(instr)]; \
+        Value vec_result; \
         if (IS_DOUBLE(vb) && IS_DOUBLE(vc)) { \
             bp[REG_A(instr)] = DOUBLE_VAL(AS_DOUBLE(vb) op AS_DOUBLE(vc)); \
+        } else if (vecArith(vm, vec_op, vb, vc, &vec_result)) { \
+            RELOAD_STACK(); \
+            bp[REG_A(instr)] = vec_result; \
         } else { \
             STORE_IP(); \
             runtimeError(vm, ERR_OPERANDS_NUMBERS); \
@@ -818,22 +1184,18 @@ static InterpretResult run(VM* vm) {
     OP(ADD) {
         Value val_b = bp[REG_B(instr)];
         Value val_c = bp[REG_C(instr)];
+        Value vec_result;
 
 
         if (IS_DOUBLE(val_b) && IS_DOUBLE(val_c)) {
             bp[REG_A(instr)] = DOUBLE_VAL(AS_DOUBLE(val_b) + AS_DOUBLE(val_c));
+        } else if (vecArith(vm, VEC_ADD, val_b, val_c, &vec_result)) {
+            RELOAD_STACK();
+            bp[REG_A(instr)] = vec_result;
         } else if (IS_STRING(val_b) && IS_STRING(val_c)) {
-            ObjString* str_b = AS_STRING(val_b);
-            ObjString* str_c = AS_STRING(val_c);
-
-            int byte_len = str_b->byte_length + str_c->byte_length;
-            char* chars = (char*)reallocate(vm, NULL, 0, byte_len + 1);
-            memcpy(chars, str_b->chars, str_b->byte_length);
-            memcpy(chars + str_b->byte_length, str_c->chars, str_c->byte_length);
-            chars[byte_len] = '\0';
-
-            // takeString takes ownership of the 'chars' buffer
-            ObjString* result = takeString(vm, chars, byte_len);
+            Value operands[2] = { val_b, val_c };
+            int byte_len = AS_STRING(val_b)->byte_length + AS_STRING(val_c)->byte_length;
+            ObjString* result = concatStrings(vm, operands, 2, byte_len);
             RELOAD_STACK(); // GC may have reallocated stack
 
             // Protect the string before the write (which can trigger GC via tableSet)
@@ -842,21 +1204,21 @@ static InterpretResult run(VM* vm) {
             popTempRoot(vm);
 
         } else {
-            STORE_IP(); runtimeError(vm, "Operands for '+' must be two numbers or two strings.");
+            STORE_IP(); runtimeError(vm, "Operands for '+' must be two numbers, two strings or two vectors.");
             STORE_STATE(); return INTERPRET_RUNTIME_ERROR;
         }
         DISPATCH();
     }
     OP(SUB) {
-        BINARY_OP(-);
+        BINARY_OP(-, VEC_SUB);
         DISPATCH();
     }
     OP(MUL) {
-        BINARY_OP(*);
+        BINARY_OP(*, VEC_MUL);
         DISPATCH();
     }
     OP(DIV) {
-        BINARY_OP(/);
+        BINARY_OP(/, VEC_DIV);
         DISPATCH();
     }
     OP(MOD) {
@@ -1026,6 +1388,8 @@ static InterpretResult run(VM* vm) {
     OP(EQ_L) {
         uint32_t low = *ip++;
         uint32_t high = *ip++;
+        // The literal is always a number, so strings and vecs never need the
+        // content comparison value_equals does.
         Value literal_val = ((uint64_t)high << 32) | (uint64_t)low;
 
         Value vb = bp[REG_B(instr)];
@@ -1285,8 +1649,12 @@ static InterpretResult run(VM* vm) {
         Value va = stack[a];
 
 
+        Value vec_result;
         if (IS_DOUBLE(va)) {
             stack[a] = DOUBLE_VAL(AS_DOUBLE(va) * (double)imm);
+        } else if (vecArith(vm, VEC_MUL, va, DOUBLE_VAL((double)imm), &vec_result)) {
+            RELOAD_STACK();
+            stack[a] = vec_result;
         } else {
             STORE_IP(); runtimeError(vm, "Operand for '*' must be a number.");
             STORE_STATE(); return INTERPRET_RUNTIME_ERROR;
@@ -1300,8 +1668,12 @@ static InterpretResult run(VM* vm) {
         Value va = stack[a];
 
 
+        Value vec_result;
         if (IS_DOUBLE(va)) {
             stack[a] = DOUBLE_VAL(AS_DOUBLE(va) / (double)imm);
+        } else if (vecArith(vm, VEC_DIV, va, DOUBLE_VAL((double)imm), &vec_result)) {
+            RELOAD_STACK();
+            stack[a] = vec_result;
         } else {
             STORE_IP(); runtimeError(vm, "Operand for '/' must be a number.");
             STORE_STATE(); return INTERPRET_RUNTIME_ERROR;
@@ -1377,8 +1749,12 @@ static InterpretResult run(VM* vm) {
 
         Value vb = bp[REG_B(instr)];
 
+        Value vec_result;
         if (IS_DOUBLE(vb)) {
             stack[a] = DOUBLE_VAL(AS_DOUBLE(vb) * literal);
+        } else if (vecArith(vm, VEC_MUL, vb, DOUBLE_VAL(literal), &vec_result)) {
+            RELOAD_STACK();
+            stack[a] = vec_result;
         } else {
             STORE_IP(); runtimeError(vm, "Operand for '*' must be a number.");
             STORE_STATE(); return INTERPRET_RUNTIME_ERROR;
@@ -1395,8 +1771,12 @@ static InterpretResult run(VM* vm) {
 
         Value vb = bp[REG_B(instr)];
 
+        Value vec_result;
         if (IS_DOUBLE(vb)) {
             stack[a] = DOUBLE_VAL(AS_DOUBLE(vb) / literal);
+        } else if (vecArith(vm, VEC_DIV, vb, DOUBLE_VAL(literal), &vec_result)) {
+            RELOAD_STACK();
+            stack[a] = vec_result;
         } else {
             STORE_IP(); runtimeError(vm, "Operand for '/' must be a number.");
             STORE_STATE(); return INTERPRET_RUNTIME_ERROR;
@@ -1665,8 +2045,12 @@ static InterpretResult run(VM* vm) {
         Value val_b = bp[REG_B(instr)];
 
 
+        Value vec_result;
         if (IS_DOUBLE(val_b)) {
             stack[a] = DOUBLE_VAL(-AS_DOUBLE(val_b));
+        } else if (vecArith(vm, VEC_MUL, val_b, DOUBLE_VAL(-1.0), &vec_result)) {
+            RELOAD_STACK();
+            stack[a] = vec_result;
         } else {
             STORE_IP(); runtimeError(vm, "Operand must be a number.");
             STORE_STATE(); return INTERPRET_RUNTIME_ERROR;
@@ -1808,6 +2192,7 @@ static InterpretResult run(VM* vm) {
         uint16_t raw = REG_Bx(instr);
         int32_t off = sign_extend_16(raw);
         ip += off;
+        if (off < 0) POLL_PREEMPT();
         DISPATCH();
     }
 
@@ -1817,7 +2202,10 @@ static InterpretResult run(VM* vm) {
         Value va = bp[REG_A(instr)];
         Value vb = bp[REG_B(instr)];
 
-        if (va == vb || (IS_DOUBLE(va) && IS_DOUBLE(vb) && AS_DOUBLE(va) == AS_DOUBLE(vb))) {
+        // Distinct object bits can still be equal: external strings and vecs
+        // compare by content
+        if (va == vb || (IS_DOUBLE(va) && IS_DOUBLE(vb) && AS_DOUBLE(va) == AS_DOUBLE(vb)) ||
+            (IS_OBJ(va) && IS_OBJ(vb) && value_equals(va, vb))) {
             ip += off;
         }
         DISPATCH();
@@ -1827,7 +2215,8 @@ static InterpretResult run(VM* vm) {
         Value va = bp[REG_A(instr)];
         Value vb = bp[REG_B(instr)];
 
-        if (va != vb && !(IS_DOUBLE(va) && IS_DOUBLE(vb) && AS_DOUBLE(va) == AS_DOUBLE(vb))) {
+        if (va != vb && !(IS_DOUBLE(va) && IS_DOUBLE(vb) && AS_DOUBLE(va) == AS_DOUBLE(vb)) &&
+            !(IS_OBJ(va) && IS_OBJ(vb) && value_equals(va, vb))) {
             ip += off;
         }
         DISPATCH();
@@ -2023,6 +2412,7 @@ static InterpretResult run(VM* vm) {
     OP(BRANCH_EQ_L) {
         uint32_t low = *ip++;
         uint32_t high = *ip++;
+        // Numeric literal only, like EQ_L: raw bits plus the double compare suffice
         Value literal_val = ((uint64_t)high << 32) | (uint64_t)low;
         int32_t off = *ip++;
         off = sign_extend_16(off);
@@ -2160,8 +2550,10 @@ static InterpretResult run(VM* vm) {
     }
 
     OP(CALL) {
+        POLL_PREEMPT();
         int callee_slot = base + REG_A(instr);
-        uint16_t arg_count = REG_Bx(instr);
+        uint16_t arg_count = REG_B(instr);
+        int result_count = REG_C(instr);  // >1 when the caller destructures several results
         Value callee = stack[callee_slot];
 
         // Dereference if callee is a reference (refs are first-class)
@@ -2213,6 +2605,11 @@ static InterpretResult run(VM* vm) {
                 STORE_STATE(); return INTERPRET_RUNTIME_ERROR;
             }
 
+            STORE_IP();
+            if (!ensureFunctionCompiled(vm, function)) {
+                STORE_STATE(); return INTERPRET_RUNTIME_ERROR;
+            }
+
             // Calculate required stack size and grow if needed
             // For variadic functions, extra args beyond arity occupy stack slots too
             int needed_top = callee_slot + function->max_regs;
@@ -2240,6 +2637,7 @@ static InterpretResult run(VM* vm) {
             frame->caller_chunk = vm->chunk;
             frame->flags        = 0;
             frame->arg_count    = arg_count;
+            frame->result_count = (uint8_t)result_count;
 
             vm->current_frame = frame;
             base = callee_slot;
@@ -2265,6 +2663,7 @@ static InterpretResult run(VM* vm) {
                     STORE_IP(); runtimeError(vm, "Expected at least %d arguments but got %u.", native->arity, arg_count);
                     STORE_STATE(); return INTERPRET_RUNTIME_ERROR;
                 }
+                vm->native_call_slot = callee_slot;
                 STORE_STATE();
                 result = native->variadic_dispatcher(vm, args, native->func_ptr, (int)arg_count);
                 RELOAD_STACK();
@@ -2278,6 +2677,7 @@ static InterpretResult run(VM* vm) {
                 // so the GC will mark them as roots. No temp root protection needed.
 
                 // Call native function via dispatcher
+                vm->native_call_slot = callee_slot;
                 STORE_STATE();
                 result = native->dispatcher(vm, args, native->func_ptr);
                 RELOAD_STACK(); // native may trigger GC that reallocates stack
@@ -2297,6 +2697,7 @@ static InterpretResult run(VM* vm) {
 
             // Place result in callee slot
             stack[callee_slot] = result;
+            fillMissingResults(&stack[callee_slot], 1, result_count);
 
             DISPATCH();
         }
@@ -2318,6 +2719,7 @@ static InterpretResult run(VM* vm) {
                 for (int i = 0; i < arg_count; i++) {
                     closure_args[i + 1] = stack[callee_slot + 1 + i];
                 }
+                vm->native_call_slot = callee_slot;
                 STORE_STATE();
                 result = native_closure->variadic_dispatcher(vm, closure_args, native_closure->func_ptr, (int)arg_count);
                 RELOAD_STACK();
@@ -2340,6 +2742,7 @@ static InterpretResult run(VM* vm) {
                 // closure_args[] is a stack-local copy — no temp root protection needed.
 
                 // Call native closure via dispatcher (context-aware dispatcher)
+                vm->native_call_slot = callee_slot;
                 STORE_STATE();
                 result = native_closure->dispatcher(vm, closure_args, native_closure->func_ptr);
                 RELOAD_STACK(); // native may trigger GC that reallocates stack
@@ -2359,6 +2762,7 @@ static InterpretResult run(VM* vm) {
 
             // Place result in callee slot
             stack[callee_slot] = result;
+            fillMissingResults(&stack[callee_slot], 1, result_count);
 
             DISPATCH();
         }
@@ -2367,6 +2771,7 @@ static InterpretResult run(VM* vm) {
         STORE_STATE(); return INTERPRET_RUNTIME_ERROR;
     }
     OP(CALL_SELF) {
+        POLL_PREEMPT();
         CallFrame* current_frame = vm->current_frame;
         int callee_slot = current_frame->stack_base + REG_A(instr);
         ObjClosure* closure = current_frame->closure;
@@ -2408,6 +2813,7 @@ static InterpretResult run(VM* vm) {
         frame->caller_chunk = vm->chunk;
         frame->flags        = 0;
         frame->arg_count    = REG_Bx(instr);
+        frame->result_count = 0;
 
         vm->current_frame = frame;
         base = callee_slot;
@@ -2416,6 +2822,7 @@ static InterpretResult run(VM* vm) {
         DISPATCH();
     }
     OP(TAIL_CALL) {
+        POLL_PREEMPT();
         int callee_slot = base + REG_A(instr);
         uint16_t arg_count = REG_Bx(instr);
         Value callee = stack[callee_slot];
@@ -2449,6 +2856,11 @@ static InterpretResult run(VM* vm) {
                 STORE_STATE(); return INTERPRET_RUNTIME_ERROR;
             }
 
+            STORE_IP();
+            if (!ensureFunctionCompiled(vm, function)) {
+                STORE_STATE(); return INTERPRET_RUNTIME_ERROR;
+            }
+
             // TAIL CALL OPTIMIZATION: Reuse current frame instead of pushing new one
             CallFrame* current_frame = vm->current_frame;
             int frame_base = current_frame->stack_base;
@@ -2499,6 +2911,7 @@ static InterpretResult run(VM* vm) {
                     STORE_IP(); runtimeError(vm, "Expected at least %d arguments but got %u.", native->arity, arg_count);
                     STORE_STATE(); return INTERPRET_RUNTIME_ERROR;
                 }
+                vm->native_call_slot = callee_slot;
                 STORE_STATE();
                 result = native->variadic_dispatcher(vm, args, native->func_ptr, (int)arg_count);
                 RELOAD_STACK();
@@ -2508,6 +2921,8 @@ static InterpretResult run(VM* vm) {
                     STORE_STATE(); return INTERPRET_RUNTIME_ERROR;
                 }
 
+                vm->native_call_slot = callee_slot;
+
                 STORE_STATE();
                 result = native->dispatcher(vm, args, native->func_ptr);
                 RELOAD_STACK();
@@ -2560,6 +2975,7 @@ static InterpretResult run(VM* vm) {
             vm->chunk = frame->caller_chunk;
             constants = vm->chunk->constants.values;
             stack[frame->stack_base] = result;
+            fillMissingResults(&stack[frame->stack_base], 1, frame->result_count);
 
             DISPATCH();
         }
@@ -2580,6 +2996,7 @@ static InterpretResult run(VM* vm) {
                 for (int i = 0; i < arg_count; i++) {
                     closure_args[i + 1] = stack[callee_slot + 1 + i];
                 }
+                vm->native_call_slot = callee_slot;
                 STORE_STATE();
                 result = native_closure->variadic_dispatcher(vm, closure_args, native_closure->func_ptr, (int)arg_count);
                 RELOAD_STACK();
@@ -2593,6 +3010,7 @@ static InterpretResult run(VM* vm) {
                 for (int i = 0; i < arg_count; i++) {
                     closure_args[i + 1] = stack[callee_slot + 1 + i];
                 }
+                vm->native_call_slot = callee_slot;
                 STORE_STATE();
                 result = native_closure->dispatcher(vm, closure_args, native_closure->func_ptr);
                 RELOAD_STACK();
@@ -2645,6 +3063,7 @@ static InterpretResult run(VM* vm) {
             vm->chunk = frame->caller_chunk;
             constants = vm->chunk->constants.values;
             stack[frame->stack_base] = result;
+            fillMissingResults(&stack[frame->stack_base], 1, frame->result_count);
 
             DISPATCH();
         }
@@ -2653,6 +3072,7 @@ static InterpretResult run(VM* vm) {
         STORE_STATE(); return INTERPRET_RUNTIME_ERROR;
     }
     OP(TAIL_CALL_SELF) {
+        POLL_PREEMPT();
         CallFrame* current_frame = vm->current_frame;
         int callee_slot = current_frame->stack_base + REG_A(instr);
         uint16_t arg_count = REG_Bx(instr);
@@ -2691,7 +3111,8 @@ static InterpretResult run(VM* vm) {
         }
 
         int  ret_reg = REG_A(instr);
-        bool implicit_null = (REG_Bx(instr) == 1);
+        bool implicit_null = (REG_B(instr) == 1);
+        int  value_count = implicit_null || REG_C(instr) == 0 ? 1 : REG_C(instr);
         CallFrame* frame = vm->current_frame;
 
         // Get the return value BEFORE closing upvalues
@@ -2714,6 +3135,7 @@ static InterpretResult run(VM* vm) {
 
         if (frame->flags & (FRAME_FLAG_PREEMPT | FRAME_FLAG_DISABLE_PREEMPT)) {
             vm->preemption_disable_depth--;
+            preemptionRearmPending(vm);
         }
 
         // Single check for any active boundary (withPrompt or resume)
@@ -2749,8 +3171,35 @@ static InterpretResult run(VM* vm) {
         constants = vm->chunk->constants.values;
         stack[frame->stack_base] = return_value;
 
+        // Multiple results: value i moves down from ret_reg + i to stack_base + i
+        // (never above its source), and names beyond what was returned get null.
+        if (__builtin_expect(frame->result_count > 1, 0)) {
+            int wanted = frame->result_count;
+            int copied = value_count < wanted ? value_count : wanted;
+            for (int i = 1; i < copied; i++) {
+                stack[frame->stack_base + i] = stack[frame->stack_base + ret_reg + i];
+            }
+            fillMissingResults(&stack[frame->stack_base], copied, wanted);
+        }
+
         DISPATCH();
     }
+    OP(THROW) {
+        Value value = bp[REG_A(instr)];
+        STORE_STATE();
+        if (throwValue(vm, value)) {
+            LOAD_STATE();
+            DISPATCH();
+        }
+
+        Value text = IS_STRING(value) ? value : zym_valueToString(vm, value);
+        if (IS_STRING(text)) {
+            runtimeError(vm, "Uncaught exception: %s", AS_CSTRING(text));
+        } else {
+            runtimeError(vm, "Uncaught exception: <%s>", zym_typeName(value));
+        }
+        return INTERPRET_RUNTIME_ERROR;
+    }
     OP(CLOSURE) {
         int a = base + REG_A(instr);
         uint16_t bx = REG_Bx(instr);
@@ -2758,6 +3207,17 @@ static InterpretResult run(VM* vm) {
         // 1. Get the function template from the constant pool.
         ObjFunction* function = AS_FUNCTION(constants[bx]);
 
+        // Capture-free functions share one closure, so this is just a load.
+        if (function->upvalue_count == 0) {
+            if (function->shared_closure == NULL) {
+                ObjClosure* shared = newClosure(vm, function);
+                RELOAD_STACK(); // GC may have reallocated stack
+                function->shared_closure = shared;
+            }
+            stack[a] = OBJ_VAL(function->shared_closure);
+            DISPATCH();
+        }
+
         // 2. Create the closure object.
         ObjClosure* closure = newClosure(vm, function);
         RELOAD_STACK(); // GC may have reallocated stack
@@ -2921,12 +3381,7 @@ static InterpretResult run(VM* vm) {
         ObjMap* target = AS_MAP(target_val);
         ObjMap* source = AS_MAP(source_val);
         // Copy all key-value pairs from source to target
-        for (int i = 0; i < source->table.capacity; i++) {
-            Entry* entry = &source->table.entries[i];
-            if (entry->key != NULL) {
-                tableSet(vm, &target->table, entry->key, entry->value);
-            }
-        }
+        tableAddAll(vm, &source->table, &target->table);
         DISPATCH();
     }
     OP(GET_SUBSCRIPT) {
@@ -3120,6 +3575,29 @@ static InterpretResult run(VM* vm) {
             STORE_STATE(); return INTERPRET_RUNTIME_ERROR;
         }
 
+        // Vectors: named component within the vector's size
+        if (IS_VEC(container_val)) {
+            ObjVec* vec = AS_VEC(container_val);
+            int comp = vecComponentIndex(key_str);
+            if (comp >= 0 && comp < vec->size) {
+                bp[REG_A(instr)] = DOUBLE_VAL(vec->comps[comp]);
+
+                // Self-patch: bake the component index into C, switch to IC opcode
+                ip[-2] = (uint32_t)(GET_VEC_COMPONENT_IC) | ((uint32_t)REG_A(instr) << 8) | ((uint32_t)REG_B(instr) << 16) | ((uint32_t)comp << 24);
+                DISPATCH();
+            }
+            STORE_IP(); runtimeError(vm, "vec%d has no component '%s'.", vec->size, key_str->chars);
+            STORE_STATE(); return INTERPRET_RUNTIME_ERROR;
+        }
+
+        // Userdata: bound method, or null like a missing map key
+        if (IS_USERDATA(container_val)) {
+            Value method = getUserdataMethod(vm, container_val, key_str);
+            RELOAD_STACK();
+            bp[REG_A(instr)] = method;
+            DISPATCH();
+        }
+
         // Handle maps
         if (!IS_MAP(container_val)) {
             STORE_IP(); runtimeError(vm, ERR_ONLY_MAPS);
@@ -3160,6 +3638,11 @@ static InterpretResult run(VM* vm) {
             STORE_STATE(); return INTERPRET_RUNTIME_ERROR;
         }
 
+        if (IS_VEC(container_val)) {
+            STORE_IP(); runtimeError(vm, "Vectors are immutable.");
+            STORE_STATE(); return INTERPRET_RUNTIME_ERROR;
+        }
+
         // Handle maps
         if (!IS_MAP(container_val)) {
             STORE_IP(); runtimeError(vm, ERR_ONLY_MAPS);
@@ -3208,6 +3691,21 @@ static InterpretResult run(VM* vm) {
         // Not a struct: revert to _L and handle as map
         ip[-2] = (uint32_t)(GET_MAP_PROPERTY_L) | ((uint32_t)REG_A(instr) << 8) | ((uint32_t)REG_B(instr) << 16);
 
+        // Vectors take the generic path, which re-caches the component
+        if (IS_VEC(container_val)) {
+            ip--;
+            instr = ip[-1];
+            goto CASE_GET_MAP_PROPERTY_L;
+        }
+
+        // Userdata: bound method, or null like a missing map key
+        if (IS_USERDATA(container_val)) {
+            Value method = getUserdataMethod(vm, container_val, key_str);
+            RELOAD_STACK();
+            bp[REG_A(instr)] = method;
+            DISPATCH();
+        }
+
         // Handle maps inline (avoid re-dispatch overhead)
         if (!IS_MAP(container_val)) {
             STORE_IP(); runtimeError(vm, ERR_ONLY_MAPS);
@@ -3223,6 +3721,21 @@ static InterpretResult run(VM* vm) {
         }
         DISPATCH();
     }
+    OP(GET_VEC_COMPONENT_IC) {
+        Value container_val = bp[REG_B(instr)];
+        ip++; // Key const word, only needed when reverting
+
+        if (IS_VEC(container_val) && (int)REG_C(instr) < AS_VEC(container_val)->size) {
+            bp[REG_A(instr)] = DOUBLE_VAL(AS_VEC(container_val)->comps[REG_C(instr)]);
+            DISPATCH();
+        }
+
+        // IC miss: revert to _L and redo the lookup generically
+        ip--;
+        instr = (uint32_t)(GET_MAP_PROPERTY_L) | ((uint32_t)REG_A(instr) << 8) | ((uint32_t)REG_B(instr) << 16);
+        ip[-1] = instr;
+        goto CASE_GET_MAP_PROPERTY_L;
+    }
     OP(SET_STRUCT_FIELD_IC) {
         int cached_field = REG_B(instr);
 
@@ -3272,6 +3785,161 @@ static InterpretResult run(VM* vm) {
         }
         DISPATCH();
     }
+    OP(INVOKE) {
+        // Fused GET_MAP_PROPERTY_L + CALL: Ra holds the receiver on entry and is
+        // replaced by the looked-up method, then called with B args at Ra+1.
+        // Trailing words: [key constant index][IC: cached table slot of the key]
+        uint32_t const_idx = ip[0];
+        uint32_t* ic_slot = &ip[1];
+        ip += 2;
+        ObjString* key_str = AS_STRING(constants[const_idx]);
+
+        int callee_slot = base + REG_A(instr);
+        uint16_t arg_count = REG_B(instr);
+        Value receiver = stack[callee_slot];
+        Value callee;
+
+        if (__builtin_expect(IS_MAP(receiver), 1)) {
+            callee = lookupCachedEntry(&AS_MAP(receiver)->table, key_str, ic_slot);
+        } else if (IS_USERDATA(receiver)) {
+            // The method table is shared per type, so the IC hits across instances
+            ObjUserdataType* type = AS_USERDATA(receiver)->type;
+            callee = lookupCachedEntry(&type->methods, key_str, ic_slot);
+            if (IS_NULL(callee)) {
+                STORE_IP(); runtimeError(vm, "Userdata '%s' has no method '%s'.",
+                             type->name->chars, key_str->chars);
+                STORE_STATE(); return INTERPRET_RUNTIME_ERROR;
+            }
+
+            ObjNativeClosure* method = AS_NATIVE_CLOSURE(callee);
+            if (!method->is_variadic && arg_count == method->arity) {
+                Value closure_args[MAX_NATIVE_ARITY + 1];
+                closure_args[0] = receiver;
+                for (int i = 0; i < arg_count; i++) {
+                    closure_args[i + 1] = stack[callee_slot + 1 + i];
+                }
+
+                // The receiver stays in the callee slot, keeping it rooted during the call
+                vm->native_call_slot = callee_slot;
+                STORE_STATE();
+                Value result = method->dispatcher(vm, closure_args, method->func_ptr);
+                RELOAD_STACK();
+
+                if (result == ZYM_ERROR) {
+                    return INTERPRET_RUNTIME_ERROR;
+                }
+                if (result == ZYM_CONTROL_TRANSFER) {
+                    LOAD_STATE(); DISPATCH();
+                }
+                stack[callee_slot] = result;
+                DISPATCH();
+            }
+
+            // Variadic or arity mismatch: bind the receiver and let CALL handle it
+            callee = OBJ_VAL(bindNativeMethod(vm, method, receiver));
+            RELOAD_STACK();
+        } else if (IS_STRUCT_INSTANCE(receiver)) {
+            ObjStructInstance* instance = AS_STRUCT_INSTANCE(receiver);
+            int field_index = find_field_index(instance->schema, key_str);
+            if (field_index < 0) {
+                STORE_IP(); runtimeError(vm, "Struct '%s' has no field '%s'.",
+                             instance->schema->name->chars, key_str->chars);
+                STORE_STATE(); return INTERPRET_RUNTIME_ERROR;
+            }
+            callee = instance->fields[field_index];
+        } else {
+            STORE_IP(); runtimeError(vm, ERR_ONLY_MAPS);
+            STORE_STATE(); return INTERPRET_RUNTIME_ERROR;
+        }
+
+        stack[callee_slot] = callee;
+
+        // Module methods are native closures: call their dispatcher directly
+        // instead of walking CALL's dispatcher/closure/native type chain.
+        if (IS_NATIVE_CLOSURE(callee)) {
+            ObjNativeClosure* native_closure = AS_NATIVE_CLOSURE(callee);
+            if (!native_closure->is_variadic && arg_count == native_closure->arity) {
+                Value closure_args[MAX_NATIVE_ARITY + 1];
+                closure_args[0] = native_closure->context;
+                for (int i = 0; i < arg_count; i++) {
+                    closure_args[i + 1] = stack[callee_slot + 1 + i];
+                }
+
+                vm->native_call_slot = callee_slot;
+
+                STORE_STATE();
+                Value result = native_closure->dispatcher(vm, closure_args, native_closure->func_ptr);
+                RELOAD_STACK();
+
+                if (result == ZYM_ERROR) {
+                    return INTERPRET_RUNTIME_ERROR;
+                }
+                if (result == ZYM_CONTROL_TRANSFER) {
+                    LOAD_STATE(); DISPATCH();
+                }
+                stack[callee_slot] = result;
+                DISPATCH();
+            }
+        }
+
+        // Everything else (closures, natives, dispatchers, arity errors) goes through CALL
+        instr = (uint32_t)CALL | ((uint32_t)REG_A(instr) << 8) | ((uint32_t)arg_count << 16);
+        goto CASE_CALL;
+    }
+    OP(CONCAT_N) {
+        int first = REG_B(instr);
+        int count = REG_C(instr);
+
+        int byte_len = 0;
+        bool all_strings = true;
+        for (int i = 0; i < count; i++) {
+            Value v = bp[first + i];
+            if (!IS_STRING(v)) {
+                all_strings = false;
+                break;
+            }
+            byte_len += AS_STRING(v)->byte_length;
+        }
+
+        if (all_strings) {
+            ObjString* result = concatStrings(vm, &bp[first], count, byte_len);
+            RELOAD_STACK(); // GC may have reallocated stack
+
+            pushTempRoot(vm, (Obj*)result);
+            bp[REG_A(instr)] = OBJ_VAL(result);
+            popTempRoot(vm);
+            DISPATCH();
+        }
+
+        // Mixed operands: fold left to right with ADD semantics. The running
+        // value lives in the first operand register so it stays rooted.
+        for (int i = 1; i < count; i++) {
+            Value lhs = bp[first];
+            Value rhs = bp[first + i];
+            if (IS_DOUBLE(lhs) && IS_DOUBLE(rhs)) {
+                bp[first] = DOUBLE_VAL(AS_DOUBLE(lhs) + AS_DOUBLE(rhs));
+            } else if (IS_STRING(lhs) && IS_STRING(rhs)) {
+                Value operands[2] = { lhs, rhs };
+                ObjString* result = concatStrings(vm, operands, 2,
+                    AS_STRING(lhs)->byte_length + AS_STRING(rhs)->byte_length);
+                RELOAD_STACK();
+                bp[first] = OBJ_VAL(result);
+            } else if (IS_VEC(lhs) && IS_VEC(rhs)) {
+                Value vec_result;
+                if (!vecArith(vm, VEC_ADD, lhs, rhs, &vec_result)) {
+                    STORE_IP(); runtimeError(vm, "Vector operands for '+' must have the same size.");
+                    STORE_STATE(); return INTERPRET_RUNTIME_ERROR;
+                }
+                RELOAD_STACK();
+                bp[first] = vec_result;
+            } else {
+                STORE_IP(); runtimeError(vm, "Operands for '+' must be two numbers, two strings or two vectors.");
+                STORE_STATE(); return INTERPRET_RUNTIME_ERROR;
+            }
+        }
+        bp[REG_A(instr)] = bp[first];
+        DISPATCH();
+    }
     OP(NEW_DISPATCHER) {
         ObjDispatcher* dispatcher = newDispatcher(vm);
         pushTempRoot(vm, (Obj*)dispatcher);
@@ -3521,8 +4189,31 @@ static InterpretResult run(VM* vm) {
 #undef LOAD_STATE
 }
 
+// Run the dispatch loop, re-entering it at the catch block each time a runtime
+// error is thrown to script code. The exception value is the error message.
+static InterpretResult execute(VM* vm) {
+    vm->exec_depth++;
+    InterpretResult result;
+    for (;;) {
+        result = run(vm);
+        if (result != INTERPRET_RUNTIME_ERROR || !vm->error_thrown) break;
+
+        vm->error_thrown = false;
+        ObjString* message = copyString(vm, vm->error.message, vm->error.message_length);
+        if (!throwValue(vm, OBJ_VAL(message))) {
+            // The native that raised it unwound further than expected
+            reportRuntimeError(vm);
+            break;
+        }
+        clearRuntimeError(vm);
+    }
+    vm->error_thrown = false;
+    vm->exec_depth--;
+    return result;
+}
+
 InterpretResult runVM(VM* vm) {
-    return run(vm);
+    return execute(vm);
 }
 
 InterpretResult runChunk(VM* vm, Chunk* chunk) {
@@ -3542,7 +4233,7 @@ InterpretResult runChunk(VM* vm, Chunk* chunk) {
     disassembleChunk(chunk, "Bytecode");
 #endif
 
-    return run(vm);
+    return execute(vm);
 }
 
 bool zym_call_prepare(VM* vm, const char* functionName, int arity) {
@@ -3590,6 +4281,11 @@ InterpretResult zym_call_execute(VM* vm, int argCount) {
         return INTERPRET_RUNTIME_ERROR;
     }
 
+    if (!ensureFunctionCompiled(vm, function)) {
+        vm->api_stack_top = frame_base;
+        return INTERPRET_RUNTIME_ERROR;
+    }
+
     // Calculate required stack size for this call
     int needed_top = frame_base + function->max_regs;
 
@@ -3633,6 +4329,7 @@ InterpretResult zym_call_execute(VM* vm, int argCount) {
     frame->stack_base   = frame_base;
     frame->flags        = 0;
     frame->arg_count    = (uint16_t)argCount;
+    frame->result_count = 0;
 
     // On return, resume at the API trampoline, not bytecode.
     frame->ip           = vm->api_trampoline.code;
@@ -3649,7 +4346,7 @@ InterpretResult zym_call_execute(VM* vm, int argCount) {
     vm->chunk = &function->chunk;
     vm->ip    = function->chunk.code;
 
-    InterpretResult result = run(vm);
+    InterpretResult result = execute(vm);
 
     vm->ip    = saved_ip;
     vm->chunk = saved_chunk;
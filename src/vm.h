@@ -4,6 +4,8 @@
 #include "./value.h"
 #include "./table.h"
 #include <stdint.h>
+#include <stdarg.h>
+#include <stdatomic.h>
 #include "./config.h"
 #include "./allocator.h"
 
@@ -37,10 +39,14 @@
 #define DEFAULT_TIMESLICE 10000
 #define MAX_RESUME_DEPTH 64
 #define MAX_WITH_PROMPT_DEPTH 64
+#define VEC_MIN_SIZE 2
+#define VEC_MAX_SIZE 4
+#define VEC_FREELIST_MAX 256
 #define FRAME_FLAG_PREEMPT 0x01
 #define FRAME_FLAG_DISABLE_PREEMPT 0x02
 
 typedef struct ObjPromptTag ObjPromptTag;
+typedef struct ObjEnumSchema ObjEnumSchema;
 
 struct CallFrame {
     ObjClosure* closure;
@@ -49,6 +55,7 @@ struct CallFrame {
     Chunk* caller_chunk;
     int flags;
     uint16_t arg_count;  // actual number of args passed to this call (for variadic PACK_REST)
+    uint8_t result_count;  // results the caller unpacks from stack_base upward (0 or 1: one value)
 };
 typedef struct CallFrame CallFrame;
 
@@ -72,6 +79,33 @@ typedef struct {
 typedef void (*ErrorCallback)(struct VM* vm, ZymStatus type, const char* file,
                               int line, const char* message, void* user_data);
 
+// Runtime error handler: if set, runtime errors are captured into the VM's
+// ErrorRecord and this is called instead of formatting any text.
+typedef void (*RuntimeErrorHandler)(struct VM* vm, void* user_data);
+
+// One location of a captured runtime error: first where it was raised, then
+// each call site outward. Lines are looked up from ip only when read.
+typedef struct {
+    ObjFunction* function;  // NULL for top-level script code
+    ObjString* file;        // module or entry file, NULL if unknown
+    Chunk* chunk;
+    uint32_t* ip;
+} ErrorFrame;
+
+// The last runtime error. frame_count is 0 when none is held. Functions and
+// file names it references are GC roots until it is cleared.
+typedef struct {
+    char* message;
+    int message_length;
+    int message_capacity;
+    ErrorFrame* frames;
+    int frame_count;
+    int frame_capacity;
+} ErrorRecord;
+
+typedef struct GarbageBatch GarbageBatch;
+typedef void (*GarbageHandler)(GarbageBatch* batch, void* user_data);
+
 typedef struct VM {
     ZymAllocator allocator;
 
@@ -85,6 +119,16 @@ typedef struct VM {
     ValueArray globalSlots;
     Table strings;
 
+    // Reset checkpoint (see resetVM): globals, slot values, enum ids and
+    // preemption settings as they stood after initialization or the last
+    // checkpointVM
+    Table reset_globals;
+    ValueArray reset_slots;
+    int reset_enum_type_id;
+    bool reset_preemption_enabled;
+    int reset_default_timeslice;
+    Value reset_preempt_callback;
+
     CallFrame frames[FRAMES_MAX];
     int frame_count;
     int cur_base;
@@ -98,7 +142,11 @@ typedef struct VM {
     Chunk api_trampoline;
 
     int next_enum_type_id;
+    ObjEnumSchema** enum_schemas;   // Registry indexed by type_id (see registerEnumSchema)
+    int enum_schema_capacity;
     ObjString* entry_file;
+    int live_external_strings;      // external strings not yet finalized; 0 lets string search compare by identity
+    struct ObjUserdataType* reader_type;  // shared by every zym_newReader instance
 
     // Garbage Collector
     size_t bytes_allocated;
@@ -108,7 +156,12 @@ typedef struct VM {
     int gray_count;
     int gray_capacity;
     bool gc_enabled;
+    GarbageHandler garbage_handler;   // optional: receives swept objects instead of freeing them
+    void* garbage_user_data;
+    struct ObjVec* vec_freelist[VEC_MAX_SIZE - VEC_MIN_SIZE + 1];   // swept vectors by size - VEC_MIN_SIZE, linked through obj.next
+    int vec_free_count[VEC_MAX_SIZE - VEC_MIN_SIZE + 1];
     struct Compiler* compiler;
+    struct LazyUnit* lazy_units;
 
     Obj** temp_roots;
     int temp_root_count;
@@ -118,9 +171,15 @@ typedef struct VM {
     int prompt_count;
     uint32_t next_prompt_tag_id;
 
+    // Callee slot of the instruction that called the running native, where its
+    // result lands. Set before every native dispatch so natives that move
+    // frames (Cont, Preempt.withDisabled) know their call site.
+    int native_call_slot;
+
     int32_t preempt_counter;
     int32_t saved_budget;
     bool preempt_requested;
+    atomic_bool preempt_signal;   // set from any thread by zym_requestPreempt; polled at back-edges and calls
     bool preemption_enabled;
     int preemption_disable_depth;
     Value on_preempt_callback;
@@ -135,9 +194,20 @@ typedef struct VM {
     // Cached: active_boundaries = with_prompt_depth + resume_depth
     // Used for a single fast check in RET/TAIL_CALL instead of two separate checks
 
+    // Profiling (ZYM_PROFILE): the jump dispatched last, resolved as taken or
+    // not by the next instruction
+    struct ChunkProfile* profile_jump;
+    int profile_jump_index;
+    int profile_fallthrough;
+
     // Error callback (NULL = default fprintf to stderr)
     ErrorCallback error_callback;
     void* error_user_data;
+    RuntimeErrorHandler runtime_error_handler;  // takes precedence over error_callback
+    void* runtime_error_user_data;
+    ErrorRecord error;
+    int exec_depth;     // dispatch loops entered through execute(); errors outside one are never caught
+    bool error_thrown;  // the held error is headed for a script catch block, not the host
 } VM;
 
 typedef enum {
@@ -153,7 +223,38 @@ static inline Chunk* currentChunk(VM* vm) {
 
 void initVM(VM* vm);
 void freeVM(VM* vm);
+void checkpointVM(VM* vm);
+void resetVM(VM* vm);
 void runtimeError(VM* vm, const char* format, ...);
+void runtimeErrorV(VM* vm, const char* format, va_list args);
+void clearRuntimeError(VM* vm);
+int errorFrameLine(const ErrorFrame* frame);
+const char* errorFrameFunctionName(const ErrorFrame* frame, int* out_len);
+int formatRuntimeError(VM* vm, char* buffer, size_t size);
+
+// Instruction budget of a fresh timeslice. A timeslice of 0 selects deadline
+// mode: only asynchronous requests (zym_requestPreempt) end the slice.
+static inline int32_t preemptionBudget(const VM* vm) {
+    return vm->default_timeslice > 0 ? vm->default_timeslice : INT32_MAX;
+}
+
+// A request that arrived while preemption was disabled stays latched in
+// preempt_requested; call this whenever a disable scope ends so it fires at
+// the next dispatch instead of being lost.
+static inline void preemptionRearmPending(VM* vm) {
+    if (vm->preempt_requested && vm->preemption_enabled && vm->preemption_disable_depth == 0) {
+        vm->preempt_counter = 0;
+    }
+}
+
+// Functions compiled with CompilerConfig.lazy_functions get their body on the
+// first call; every path that pushes a frame for a closure checks this first.
+#ifndef ZYM_RUNTIME_ONLY
+#define ensureFunctionCompiled(vm, function) \
+    (__builtin_expect((function)->lazy == NULL, 1) || compileLazyFunction((vm), (function)))
+#else
+#define ensureFunctionCompiled(vm, function) true
+#endif
 
 void updateStackReferences(VM* vm, Value* old_stack, Value* new_stack);
 void closeUpvalues(VM* vm, Value* last);
@@ -1,11 +1,13 @@
 #include <stdlib.h>
 #include <string.h>
+#include <limits.h>
 #include <stdarg.h>
 #include <stdio.h>
 #include <inttypes.h>
 
 #include "./vm.h"
 #include "./chunk.h"
+#include "./profile.h"
 #include "./linemap.h"
 #ifndef ZYM_RUNTIME_ONLY
 #include "./preprocessor.h"
@@ -18,6 +20,8 @@
 #include "./table.h"
 #include "./gc.h"
 #include "./memory.h"
+#include "./modules/preemption.h"
+#include "./natives/reader.h"
 
 #include "zym/zym.h"
 
@@ -43,6 +47,18 @@ void zym_freeVM(ZymVM* vm)
     ZYM_FREE(&alloc, vm, sizeof(ZymVM));
 }
 
+void zym_checkpointVM(ZymVM* vm)
+{
+    if (vm == NULL) return;
+    checkpointVM(vm);
+}
+
+void zym_resetVM(ZymVM* vm)
+{
+    if (vm == NULL) return;
+    resetVM(vm);
+}
+
 const ZymAllocator* zym_getAllocator(ZymVM* vm)
 {
     if (vm == NULL) return NULL;
@@ -60,6 +76,48 @@ void zym_setErrorCallback(ZymVM* vm, ZymErrorCallback callback, void* user_data)
     vm->error_user_data = user_data;
 }
 
+void zym_setRuntimeErrorHandler(ZymVM* vm, ZymRuntimeErrorHandler handler, void* user_data)
+{
+    if (vm == NULL) return;
+    vm->runtime_error_handler = handler;
+    vm->runtime_error_user_data = user_data;
+}
+
+const char* zym_errorMessage(ZymVM* vm)
+{
+    if (vm == NULL || vm->error.frame_count == 0) return NULL;
+    return vm->error.message;
+}
+
+int zym_errorFrameCount(ZymVM* vm)
+{
+    if (vm == NULL) return 0;
+    return vm->error.frame_count;
+}
+
+bool zym_errorFrame(ZymVM* vm, int index, ZymErrorFrame* out)
+{
+    if (vm == NULL || out == NULL || index < 0 || index >= vm->error.frame_count) return false;
+    const ErrorFrame* frame = &vm->error.frames[index];
+    out->function = errorFrameFunctionName(frame, &out->function_length);
+    out->file = frame->file ? frame->file->chars : NULL;
+    out->line = errorFrameLine(frame);
+    return true;
+}
+
+int zym_formatError(ZymVM* vm, char* buffer, int size)
+{
+    if (vm == NULL) return 0;
+    if (buffer == NULL || size < 0) size = 0;
+    return formatRuntimeError(vm, buffer, (size_t)size);
+}
+
+void zym_clearError(ZymVM* vm)
+{
+    if (vm == NULL) return;
+    clearRuntimeError(vm);
+}
+
 // =============================================================================
 // COMPILATION AND EXECUTION
 // =============================================================================
@@ -167,6 +225,54 @@ void zym_setPreemptCallback(ZymVM* vm, ZymValue callback)
     vm->on_preempt_callback = callback;
 }
 
+void zym_setPreemption(ZymVM* vm, bool enabled, int timeslice)
+{
+    if (vm == NULL) return;
+    preemptionSetTimeslice(vm, timeslice);
+    if (enabled) {
+        preemptionEnable(vm);
+    } else {
+        preemptionDisable(vm);
+    }
+}
+
+void zym_requestPreempt(ZymVM* vm)
+{
+    if (vm == NULL) return;
+    atomic_store_explicit(&vm->preempt_signal, true, memory_order_relaxed);
+}
+
+bool zym_preemptRequested(ZymVM* vm)
+{
+    if (vm == NULL) return false;
+    return atomic_load_explicit(&vm->preempt_signal, memory_order_relaxed);
+}
+
+ZymStatus zym_writeProfile(ZymVM* vm, ZymChunk* chunk, char** out_buffer, size_t* out_size)
+{
+    if (vm == NULL || chunk == NULL || out_buffer == NULL || out_size == NULL) return ZYM_STATUS_RUNTIME_ERROR;
+    *out_buffer = NULL;
+    *out_size = 0;
+#ifdef ZYM_PROFILE
+    OutputBuffer temp_buffer;
+    initOutputBuffer(&temp_buffer);
+    writeProfile(vm, chunk, &temp_buffer);
+
+    char* host_buffer = (char*)ZYM_ALLOC(&vm->allocator, temp_buffer.count);
+    if (host_buffer == NULL) {
+        freeOutputBuffer(vm, &temp_buffer);
+        return ZYM_STATUS_RUNTIME_ERROR;
+    }
+    memcpy(host_buffer, temp_buffer.buffer, temp_buffer.count);
+    *out_buffer = host_buffer;
+    *out_size = temp_buffer.count;
+    freeOutputBuffer(vm, &temp_buffer);
+    return ZYM_STATUS_OK;
+#else
+    return ZYM_STATUS_RUNTIME_ERROR;
+#endif
+}
+
 #ifndef ZYM_RUNTIME_ONLY
 ZymStatus zym_serializeChunk(ZymVM* vm, ZymCompilerConfig config, ZymChunk* chunk, char** out_buffer, size_t* out_size)
 {
@@ -174,7 +280,12 @@ ZymStatus zym_serializeChunk(ZymVM* vm, ZymCompilerConfig config, ZymChunk* chun
 
     OutputBuffer temp_buffer;
     initOutputBuffer(&temp_buffer);
-    serializeChunk(vm, chunk, config, &temp_buffer);
+    if (!serializeChunk(vm, chunk, config, &temp_buffer)) {
+        freeOutputBuffer(vm, &temp_buffer);
+        *out_buffer = NULL;
+        *out_size = 0;
+        return ZYM_STATUS_COMPILE_ERROR;
+    }
 /*
     printf(" *** BYTECODE : %zu bytes ***\n", temp_buffer.count);
     printf(" *** BYTECODE START : %zu bytes ***\n", temp_buffer.count);
@@ -382,6 +493,123 @@ ZymValue zym_getClosureContext(ZymValue closure) {
     return native_closure->context;
 }
 
+// =============================================================================
+// USERDATA
+// =============================================================================
+
+ZymValue zym_newUserdataType(ZymVM* vm, const char* name, const ZymMethod* methods, int count,
+                             void (*finalizer)(ZymVM*, void*)) {
+    if (!vm || !name || count < 0 || (count > 0 && !methods)) {
+        return NULL_VAL;
+    }
+
+    ObjString* name_obj = copyString(vm, name, (int)strlen(name));
+    pushTempRoot(vm, (Obj*)name_obj);
+    ObjUserdataType* type = newUserdataType(vm, name_obj, finalizer);
+    popTempRoot(vm);
+    pushTempRoot(vm, (Obj*)type);
+
+    for (int i = 0; i < count; i++) {
+        char func_name[256];
+        int arity;
+        bool is_variadic;
+
+        if (!parseNativeSignatureEx(methods[i].signature, func_name, &arity, &is_variadic)) {
+            popTempRoot(vm);
+            return NULL_VAL;
+        }
+
+        NativeDispatcher dispatcher = NULL;
+        NativeVariadicDispatcher vdispatcher = NULL;
+        if (is_variadic) {
+            vdispatcher = getNativeVariadicClosureDispatcher(arity);
+        } else if (arity <= MAX_NATIVE_ARITY) {
+            dispatcher = getNativeClosureDispatcher(arity);
+        }
+        if (!dispatcher && !vdispatcher) {
+            fprintf(stderr, "Userdata method '%s' has too many parameters (max %d)\n", func_name, MAX_NATIVE_ARITY);
+            popTempRoot(vm);
+            return NULL_VAL;
+        }
+
+        ObjString* method_name = copyString(vm, func_name, (int)strlen(func_name));
+        pushTempRoot(vm, (Obj*)method_name);
+        ObjNativeClosure* method = newNativeClosure(vm, method_name, arity, methods[i].func_ptr, dispatcher, NULL_VAL);
+        method->variadic_dispatcher = vdispatcher;
+        method->is_variadic = is_variadic;
+        pushTempRoot(vm, (Obj*)method);
+        tableSet(vm, &type->methods, method_name, OBJ_VAL(method));
+        popTempRoot(vm);
+        popTempRoot(vm);
+    }
+
+    popTempRoot(vm);
+    return OBJ_VAL(type);
+}
+
+ZymValue zym_newUserdata(ZymVM* vm, ZymValue type, size_t payload_size) {
+    if (!vm || !IS_USERDATA_TYPE(type)) {
+        return NULL_VAL;
+    }
+
+    pushTempRoot(vm, AS_OBJ(type));
+    ObjUserdata* userdata = newUserdata(vm, AS_USERDATA_TYPE(type), payload_size);
+    popTempRoot(vm);
+    return OBJ_VAL(userdata);
+}
+
+void* zym_userdataPayload(ZymValue value) {
+    if (!IS_USERDATA(value)) {
+        return NULL;
+    }
+    return AS_USERDATA(value)->payload;
+}
+
+// =============================================================================
+// VECTORS
+// =============================================================================
+
+ZymValue zym_newVec(ZymVM* vm, int size, const double* comps) {
+    if (!vm || size < VEC_MIN_SIZE || size > VEC_MAX_SIZE || comps == NULL) {
+        return NULL_VAL;
+    }
+
+    ObjVec* vec = newVec(vm, size);
+    memcpy(vec->comps, comps, sizeof(double) * (size_t)size);
+    return OBJ_VAL(vec);
+}
+
+int zym_vecSize(ZymValue value) {
+    if (!IS_VEC(value)) {
+        return 0;
+    }
+    return AS_VEC(value)->size;
+}
+
+const double* zym_vecComponents(ZymValue value) {
+    if (!IS_VEC(value)) {
+        return NULL;
+    }
+    return AS_VEC(value)->comps;
+}
+
+// =============================================================================
+// READERS
+// =============================================================================
+
+ZymValue zym_newReader(ZymVM* vm, const ZymReaderCallbacks* callbacks, void* ctx, size_t buffer_size) {
+    if (!vm || !callbacks || !callbacks->read) {
+        return NULL_VAL;
+    }
+    if (buffer_size == 0) {
+        buffer_size = READER_DEFAULT_BUFFER;
+    } else if (buffer_size < READER_MIN_BUFFER) {
+        buffer_size = READER_MIN_BUFFER;
+    }
+
+    return newReaderValue(vm, callbacks, ctx, buffer_size);
+}
+
 // =============================================================================
 // FUNCTION OVERLOADING (DISPATCHER)
 // =============================================================================
@@ -458,6 +686,9 @@ bool zym_isFunction(ZymValue value) {
 bool zym_isClosure(ZymValue value) { return IS_CLOSURE(value); }
 bool zym_isPromptTag(ZymValue value) { return IS_OBJ(value) && IS_PROMPT_TAG(value); }
 bool zym_isContinuation(ZymValue value) { return IS_OBJ(value) && IS_CONTINUATION(value); }
+bool zym_isUserdata(ZymValue value) { return IS_OBJ(value) && IS_USERDATA(value); }
+bool zym_isVec(ZymValue value) { return IS_VEC(value); }
+bool zym_isReader(ZymValue value) { return readerFromValue(value) != NULL; }
 
 // =============================================================================
 // VALUE EXTRACTION (SAFE)
@@ -525,6 +756,14 @@ const char* zym_typeName(ZymValue value) {
             case OBJ_STRUCT_INSTANCE: return "struct";
             case OBJ_ENUM_SCHEMA: return "enum_schema";
             case OBJ_DISPATCHER: return "dispatcher";
+            case OBJ_USERDATA_TYPE: return "userdata_type";
+            case OBJ_USERDATA: return "userdata";
+            case OBJ_VEC:
+                switch (AS_VEC(value)->size) {
+                    case 2: return "vec2";
+                    case 3: return "vec3";
+                    default: return "vec4";
+                }
             default: return "unknown";
         }
     }
@@ -571,21 +810,7 @@ static bool valueToStringHelper(VM* vm, Value value, char** buffer, size_t* buf_
         int type_id = ENUM_TYPE_ID(value);
         int variant_idx = ENUM_VARIANT(value);
         if (vm != NULL) {
-            ObjEnumSchema* schema = NULL;
-            for (int i = 0; i < vm->globals.capacity; i++) {
-                Entry* entry = &vm->globals.entries[i];
-                if (entry->key == NULL) continue;
-                Value ev = entry->value;
-                if (IS_DOUBLE(ev)) {
-                    int slot = (int)AS_DOUBLE(ev);
-                    if (slot < 0 || slot >= vm->globalSlots.count) continue;
-                    ev = vm->globalSlots.values[slot];
-                }
-                if (IS_OBJ(ev) && IS_ENUM_SCHEMA(ev)) {
-                    ObjEnumSchema* candidate = AS_ENUM_SCHEMA(ev);
-                    if (candidate->type_id == type_id) { schema = candidate; break; }
-                }
-            }
+            ObjEnumSchema* schema = findEnumSchema(vm, type_id);
             if (schema != NULL && variant_idx >= 0 && variant_idx < schema->variant_count) {
                 ObjString* vname = schema->variant_names[variant_idx];
                 int len = snprintf(temp, sizeof(temp), "%.*s.%.*s",
@@ -722,6 +947,34 @@ static bool valueToStringHelper(VM* vm, Value value, char** buffer, size_t* buf_
                 APPEND("<dispatcher>", 12);
                 break;
             }
+            case OBJ_USERDATA_TYPE: {
+                ObjUserdataType* type = AS_USERDATA_TYPE(value);
+                int len = snprintf(temp, sizeof(temp), "<userdata type %.*s>", type->name->length, type->name->chars);
+                APPEND(temp, len);
+                break;
+            }
+            case OBJ_USERDATA: {
+                ObjUserdata* userdata = AS_USERDATA(value);
+                int len = snprintf(temp, sizeof(temp), "<%.*s userdata>", userdata->type->name->length, userdata->type->name->chars);
+                APPEND(temp, len);
+                break;
+            }
+            case OBJ_VEC: {
+                ObjVec* vec = AS_VEC(value);
+                int len = snprintf(temp, sizeof(temp), "vec%d(", vec->size);
+                APPEND(temp, len);
+                for (int i = 0; i < vec->size; i++) {
+                    double num = vec->comps[i];
+                    if (num == (long long)num && num >= -1e15 && num <= 1e15) {
+                        len = snprintf(temp, sizeof(temp), i > 0 ? ", %.0f" : "%.0f", num);
+                    } else {
+                        len = snprintf(temp, sizeof(temp), i > 0 ? ", %g" : "%g", num);
+                    }
+                    APPEND(temp, len);
+                }
+                APPEND(")", 1);
+                break;
+            }
             default: {
                 int len = snprintf(temp, sizeof(temp), "<object>");
                 APPEND(temp, len);
@@ -781,12 +1034,66 @@ ZymValue zym_newStringN(ZymVM* vm, const char* str, int len) {
     return OBJ_VAL(obj);
 }
 
+char* zym_reserveString(ZymVM* vm, int len) {
+    if (!vm || len < 0 || len > INT_MAX - 1) return NULL;
+    return reserveString(vm, len);
+}
+
+ZymValue zym_finishString(ZymVM* vm, char* chars, int len) {
+    if (!vm || !chars || len < 0) return NULL_VAL;
+    return OBJ_VAL(finishString(vm, chars, len));
+}
+
+void zym_abandonString(ZymVM* vm, char* chars, int len) {
+    if (!vm || !chars || len < 0) return;
+    abandonString(vm, chars, len);
+}
+
+ZymValue zym_newExternalString(ZymVM* vm, const char* chars, int len,
+                               ZymStringFinalizer finalizer, void* userdata) {
+    if (!vm || !chars || len < 0) return NULL_VAL;
+    ObjString* obj = newExternalString(vm, chars, len, (ExternalStringFinalizer)finalizer, userdata);
+    return OBJ_VAL(obj);
+}
+
 ZymValue zym_newList(ZymVM* vm) {
     if (!vm) return NULL_VAL;
     ObjList* list = newList(vm);
     return OBJ_VAL(list);
 }
 
+// Allocates a list whose storage holds exactly count elements. GC stays off
+// meanwhile so host values not yet reachable from the VM survive the copy.
+static ObjList* newListWithCapacity(VM* vm, int count) {
+    bool was_enabled = vm->gc_enabled;
+    vm->gc_enabled = false;
+    ObjList* list = newList(vm);
+    if (count > 0) {
+        list->items.values = ALLOCATE(vm, Value, count);
+        list->items.capacity = count;
+    }
+    vm->gc_enabled = was_enabled;
+    return list;
+}
+
+ZymValue zym_newListFrom(ZymVM* vm, const ZymValue* values, int count) {
+    if (!vm || count < 0 || (count > 0 && !values)) return NULL_VAL;
+    ObjList* list = newListWithCapacity(vm, count);
+    if (count > 0) memcpy(list->items.values, values, sizeof(Value) * count);
+    list->items.count = count;
+    return OBJ_VAL(list);
+}
+
+ZymValue zym_newListFromDoubles(ZymVM* vm, const double* values, int count) {
+    if (!vm || count < 0 || (count > 0 && !values)) return NULL_VAL;
+    ObjList* list = newListWithCapacity(vm, count);
+    for (int i = 0; i < count; i++) {
+        list->items.values[i] = DOUBLE_VAL(values[i]);
+    }
+    list->items.count = count;
+    return OBJ_VAL(list);
+}
+
 ZymValue zym_newMap(ZymVM* vm) {
     if (!vm) return NULL_VAL;
     ObjMap* map = newMap(vm);
@@ -904,6 +1211,41 @@ bool zym_listRemove(ZymVM* vm, ZymValue list, int index) {
     return true;
 }
 
+bool zym_listReserve(ZymVM* vm, ZymValue list, int capacity) {
+    if (!IS_LIST(list)) return false;
+    ObjList* lst = AS_LIST(list);
+    if (capacity <= lst->items.capacity) return true;
+
+    // The list itself may only be held by the host; keep it alive across the grow
+    pushTempRoot(vm, (Obj*)lst);
+    lst->items.values = GROW_ARRAY(vm, Value, lst->items.values, lst->items.capacity, capacity);
+    lst->items.capacity = capacity;
+    popTempRoot(vm);
+    return true;
+}
+
+ZymValue* zym_listData(ZymValue list, int* count) {
+    if (!IS_LIST(list)) {
+        if (count) *count = 0;
+        return NULL;
+    }
+    ObjList* lst = AS_LIST(list);
+    if (count) *count = lst->items.count;
+    return lst->items.values;
+}
+
+int zym_listToDoubles(ZymValue list, double* out, int max) {
+    if (!IS_LIST(list) || !out) return -1;
+    ObjList* lst = AS_LIST(list);
+    int n = lst->items.count < max ? lst->items.count : max;
+    for (int i = 0; i < n; i++) {
+        Value v = lst->items.values[i];
+        if (!IS_DOUBLE(v)) return -1;
+        out[i] = AS_DOUBLE(v);
+    }
+    return n;
+}
+
 // =============================================================================
 // MAP OPERATIONS
 // =============================================================================
@@ -929,8 +1271,12 @@ ZymValue zym_mapGet(ZymVM* vm, ZymValue map, const char* key) {
 bool zym_mapSet(ZymVM* vm, ZymValue map, const char* key, ZymValue val) {
     if (!IS_MAP(map) || !key) return false;
     ObjMap* m = AS_MAP(map);
+    if (IS_OBJ(val)) pushTempRoot(vm, AS_OBJ(val));
     ObjString* keyStr = copyString(vm, key, (int)strlen(key));
+    pushTempRoot(vm, (Obj*)keyStr);
     tableSet(vm, &m->table, keyStr, val);
+    popTempRoot(vm);
+    if (IS_OBJ(val)) popTempRoot(vm);
     return true;
 }
 
@@ -1046,50 +1392,17 @@ const char* zym_structFieldNameAt(ZymValue structVal, int index) {
 
 const char* zym_enumGetName(ZymVM* vm, ZymValue enumVal) {
     if (!IS_ENUM(enumVal)) return NULL;
-    int type_id = ENUM_TYPE_ID(enumVal);
-
-    for (int i = 0; i < vm->globals.capacity; i++) {
-        Entry* entry = &vm->globals.entries[i];
-        if (entry->key == NULL) continue;
-        Value v = entry->value;
-        if (IS_DOUBLE(v)) {
-            int slot = (int)AS_DOUBLE(v);
-            if (slot < 0 || slot >= vm->globalSlots.count) continue;
-            v = vm->globalSlots.values[slot];
-        }
-        if (IS_OBJ(v) && IS_ENUM_SCHEMA(v)) {
-            ObjEnumSchema* schema = AS_ENUM_SCHEMA(v);
-            if (schema->type_id == type_id) {
-                return schema->name->chars;
-            }
-        }
-    }
-    return NULL;
+    ObjEnumSchema* schema = findEnumSchema(vm, ENUM_TYPE_ID(enumVal));
+    return schema != NULL ? schema->name->chars : NULL;
 }
 
 const char* zym_enumGetVariant(ZymVM* vm, ZymValue enumVal) {
     if (!IS_ENUM(enumVal)) return NULL;
-    int type_id = ENUM_TYPE_ID(enumVal);
     int variant = ENUM_VARIANT(enumVal);
 
-    for (int i = 0; i < vm->globals.capacity; i++) {
-        Entry* entry = &vm->globals.entries[i];
-        if (entry->key == NULL) continue;
-        Value v = entry->value;
-        if (IS_DOUBLE(v)) {
-            int slot = (int)AS_DOUBLE(v);
-            if (slot < 0 || slot >= vm->globalSlots.count) continue;
-            v = vm->globalSlots.values[slot];
-        }
-        if (IS_OBJ(v) && IS_ENUM_SCHEMA(v)) {
-            ObjEnumSchema* schema = AS_ENUM_SCHEMA(v);
-            if (schema->type_id == type_id) {
-                if (variant >= 0 && variant < schema->variant_count) {
-                    return schema->variant_names[variant]->chars;
-                }
-                return NULL;
-            }
-        }
+    ObjEnumSchema* schema = findEnumSchema(vm, ENUM_TYPE_ID(enumVal));
+    if (schema != NULL && variant >= 0 && variant < schema->variant_count) {
+        return schema->variant_names[variant]->chars;
     }
     return NULL;
 }
@@ -1214,6 +1527,21 @@ ZymValue zym_peekRoot(ZymVM* vm, int depth) {
     return OBJ_VAL(vm->temp_roots[index]);
 }
 
+// =============================================================================
+// BACKGROUND SWEEPING
+// =============================================================================
+
+void zym_setGarbageHandler(ZymVM* vm, ZymGarbageHandler handler, void* user_data) {
+    if (!vm) return;
+    vm->garbage_handler = handler;
+    vm->garbage_user_data = user_data;
+}
+
+void zym_freeGarbage(ZymGarbage* garbage) {
+    if (!garbage) return;
+    freeGarbage(garbage);
+}
+
 // =============================================================================
 // ERROR HANDLING
 // =============================================================================
@@ -1223,10 +1551,7 @@ void zym_runtimeError(ZymVM* vm, const char* format, ...) {
 
     va_list args;
     va_start(args, format);
-    char buffer[512];
-    vsnprintf(buffer, sizeof(buffer), format, args);
+    runtimeErrorV((VM*)vm, format, args);
     va_end(args);
-
-    runtimeError((VM*)vm, "%s", buffer);
 }
 